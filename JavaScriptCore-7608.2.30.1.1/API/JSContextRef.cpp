@@ -29,6 +29,7 @@
 
 #include "APICast.h"
 #include "CallFrame.h"
+#include "ContextResourceLimits.h"
 #include "InitializeThreading.h"
 #include "JSAPIGlobalObject.h"
 #include "JSCallbackObject.h"
@@ -387,6 +388,43 @@ void JSGlobalContextSetIncludesNativeCallStackWhenReportingExceptions(JSGlobalCo
 #endif
 }
 
+void JSGlobalContextSetMemoryLimits(JSGlobalContextRef ctx, size_t softLimit, size_t hardLimit)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return;
+    }
+
+    ExecState* exec = toJS(ctx);
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+
+    vm.vmEntryGlobalObject(exec)->ensureResourceLimits(vm).setMemoryLimits(softLimit, hardLimit);
+}
+
+bool JSGlobalContextGetResourceUsage(JSGlobalContextRef ctx, JSContextResourceUsage* usage)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return false;
+    }
+
+    ExecState* exec = toJS(ctx);
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+
+    ContextResourceLimits* limits = vm.vmEntryGlobalObject(exec)->resourceLimits();
+    if (!limits)
+        return false;
+
+    usage->allocatedBytes = limits->totalAllocatedBytes();
+    usage->estimatedLiveBytes = limits->estimatedLiveBytes();
+    usage->cpuTime = limits->cpuTime().seconds();
+    usage->softMemoryLimitCollections = limits->softMemoryLimitCollectionCount();
+    usage->hardMemoryLimitTerminations = limits->hardMemoryLimitTerminationCount();
+    return true;
+}
+
 #if USE(CF)
 CFRunLoopRef JSGlobalContextGetDebuggerRunLoop(JSGlobalContextRef ctx)
 {
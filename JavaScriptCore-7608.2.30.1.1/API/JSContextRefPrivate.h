@@ -128,6 +128,42 @@ JS_EXPORT bool JSGlobalContextGetIncludesNativeCallStackWhenReportingExceptions(
 */
 JS_EXPORT void JSGlobalContextSetIncludesNativeCallStackWhenReportingExceptions(JSGlobalContextRef ctx, bool includesNativeCallStack) JSC_API_AVAILABLE(macos(10.10), ios(8.0));
 
+/*!
+@struct JSContextResourceUsage
+@abstract The resources a global context has used, as reported by JSGlobalContextGetResourceUsage.
+@field allocatedBytes The number of heap bytes allocated while the context was running, since its memory limits were first set.
+@field estimatedLiveBytes An estimate of how many of those bytes are still live. The estimate shrinks after each full garbage collection by the fraction of the whole heap that was collected.
+@field cpuTime The CPU time, in seconds, spent running the context.
+@field softMemoryLimitCollections The number of garbage collections triggered by the context crossing its soft memory limit.
+@field hardMemoryLimitTerminations The number of times the context's script was terminated for being above its hard memory limit.
+*/
+typedef struct {
+    size_t allocatedBytes;
+    size_t estimatedLiveBytes;
+    double cpuTime;
+    unsigned softMemoryLimitCollections;
+    unsigned hardMemoryLimitTerminations;
+} JSContextResourceUsage;
+
+/*!
+@function
+@abstract Sets the heap limits for a global context.
+@param ctx The JSGlobalContext whose limits you want to set.
+@param softLimit The estimated live heap size, in bytes, at which the context triggers a full garbage collection. Pass 0 for no soft limit.
+@param hardLimit The estimated live heap size, in bytes, above which the context's running script is terminated, if a garbage collection does not bring it back below. Pass 0 for no hard limit.
+@discussion Memory is charged to the context that was most recently entered through the API, so the limits are meant for contexts that do not call into each other. Calling this function also starts the resource accounting reported by JSGlobalContextGetResourceUsage. Termination is reported to the caller of the API the same way as termination by JSContextGroupSetExecutionTimeLimit: the script cannot catch it, and the call that ran it returns an exception.
+*/
+JS_EXPORT void JSGlobalContextSetMemoryLimits(JSGlobalContextRef ctx, size_t softLimit, size_t hardLimit);
+
+/*!
+@function
+@abstract Gets the resources a global context has used.
+@param ctx The JSGlobalContext whose resource usage you want to get.
+@param usage A pointer to a JSContextResourceUsage in which to store the usage.
+@result true if resource accounting is enabled for the context and usage was filled in, otherwise false.
+*/
+JS_EXPORT bool JSGlobalContextGetResourceUsage(JSGlobalContextRef ctx, JSContextResourceUsage* usage);
+
 #ifdef __cplusplus
 }
 #endif
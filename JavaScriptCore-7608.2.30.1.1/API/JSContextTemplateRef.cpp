@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSContextTemplateRefPrivate.h"
+
+#include "APICast.h"
+#include "JSCInlines.h"
+#include "JSContextRefPrivate.h"
+#include "JSObjectRef.h"
+#include "JSScriptRefPrivate.h"
+#include <wtf/Deque.h>
+#include <wtf/ThreadSafeRefCounted.h>
+
+using namespace JSC;
+
+struct OpaqueJSContextTemplate : public ThreadSafeRefCounted<OpaqueJSContextTemplate> {
+public:
+    static Ref<OpaqueJSContextTemplate> create(JSContextGroupRef group, JSClassRef globalObjectClass)
+    {
+        return adoptRef(*new OpaqueJSContextTemplate(group, globalObjectClass));
+    }
+
+    ~OpaqueJSContextTemplate()
+    {
+        discardPreparedContexts();
+        for (JSScriptRef script : m_preludes)
+            JSScriptRelease(script);
+        if (m_globalObjectClass)
+            JSClassRelease(m_globalObjectClass);
+        JSContextGroupRelease(m_group);
+    }
+
+    VM& vm() const { return *toJS(m_group); }
+
+    bool addPrelude(JSStringRef url, int startingLineNumber, JSStringRef source, JSStringRef* errorMessage, int* errorLine)
+    {
+        JSScriptRef script = JSScriptCreateFromString(m_group, url, startingLineNumber, source, errorMessage, errorLine);
+        if (!script)
+            return false;
+        m_preludes.append(script);
+        discardPreparedContexts();
+        return true;
+    }
+
+    size_t prepareContexts(size_t count, JSValueRef* exception)
+    {
+        while (m_preparedContexts.size() < count) {
+            JSGlobalContextRef context = createAndInitializeContext(exception);
+            if (!context)
+                break;
+            m_preparedContexts.append(context);
+        }
+        return m_preparedContexts.size();
+    }
+
+    size_t preparedContextCount() const { return m_preparedContexts.size(); }
+
+    JSGlobalContextRef createContext(JSValueRef* exception)
+    {
+        if (!m_preparedContexts.isEmpty())
+            return m_preparedContexts.takeFirst();
+        return createAndInitializeContext(exception);
+    }
+
+private:
+    OpaqueJSContextTemplate(JSContextGroupRef group, JSClassRef globalObjectClass)
+        : m_group(group ? JSContextGroupRetain(group) : JSContextGroupCreate())
+        , m_globalObjectClass(globalObjectClass ? JSClassRetain(globalObjectClass) : nullptr)
+    {
+    }
+
+    JSGlobalContextRef createAndInitializeContext(JSValueRef* exception)
+    {
+        JSGlobalContextRef context = JSGlobalContextCreateInGroup(m_group, m_globalObjectClass);
+        for (JSScriptRef script : m_preludes) {
+            if (!JSScriptEvaluate(context, script, nullptr, exception)) {
+                JSGlobalContextRelease(context);
+                return nullptr;
+            }
+        }
+        return context;
+    }
+
+    void discardPreparedContexts()
+    {
+        while (!m_preparedContexts.isEmpty())
+            JSGlobalContextRelease(m_preparedContexts.takeFirst());
+    }
+
+    JSContextGroupRef m_group;
+    JSClassRef m_globalObjectClass;
+    Vector<JSScriptRef> m_preludes;
+    Deque<JSGlobalContextRef> m_preparedContexts;
+};
+
+extern "C" {
+
+JSContextTemplateRef JSContextTemplateCreate(JSContextGroupRef group, JSClassRef globalObjectClass)
+{
+    return &OpaqueJSContextTemplate::create(group, globalObjectClass).leakRef();
+}
+
+JSContextTemplateRef JSContextTemplateRetain(JSContextTemplateRef contextTemplate)
+{
+    contextTemplate->ref();
+    return contextTemplate;
+}
+
+void JSContextTemplateRelease(JSContextTemplateRef contextTemplate)
+{
+    // Keep the VM alive until the template, which may hold its last context group reference, is gone.
+    Ref<VM> protectedVM(contextTemplate->vm());
+    JSLockHolder locker(protectedVM.ptr());
+    contextTemplate->deref();
+}
+
+bool JSContextTemplateAddPrelude(JSContextTemplateRef contextTemplate, JSStringRef url, int startingLineNumber, JSStringRef source, JSStringRef* errorMessage, int* errorLine)
+{
+    JSLockHolder locker(&contextTemplate->vm());
+    return contextTemplate->addPrelude(url, startingLineNumber, source, errorMessage, errorLine);
+}
+
+size_t JSContextTemplatePrepareContexts(JSContextTemplateRef contextTemplate, size_t count, JSValueRef* exception)
+{
+    JSLockHolder locker(&contextTemplate->vm());
+    return contextTemplate->prepareContexts(count, exception);
+}
+
+size_t JSContextTemplateGetPreparedContextCount(JSContextTemplateRef contextTemplate)
+{
+    JSLockHolder locker(&contextTemplate->vm());
+    return contextTemplate->preparedContextCount();
+}
+
+JSGlobalContextRef JSContextTemplateCreateContext(JSContextTemplateRef contextTemplate, JSValueRef* exception)
+{
+    JSLockHolder locker(&contextTemplate->vm());
+    return contextTemplate->createContext(exception);
+}
+
+}
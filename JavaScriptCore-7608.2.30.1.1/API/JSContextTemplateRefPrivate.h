@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef JSContextTemplateRefPrivate_h
+#define JSContextTemplateRefPrivate_h
+
+#include <JavaScriptCore/JSContextRef.h>
+#include <JavaScriptCore/JSStringRef.h>
+#include <JavaScriptCore/JSValueRef.h>
+
+/*! @typedef JSContextTemplateRef A recipe for creating identically initialized global contexts. */
+typedef struct OpaqueJSContextTemplate* JSContextTemplateRef;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ @function
+ @abstract Creates a context template.
+ @param group The context group in which contexts made from the template are created.
+ @param globalObjectClass The class to use when creating the global object, as for JSGlobalContextCreateInGroup. Pass NULL to use the default object class.
+ @result A JSContextTemplateRef. Ownership follows the Create Rule.
+ @discussion A context template pairs a global object class with a list of prelude scripts that are evaluated in every new context. Contexts can be prepared ahead of time with JSContextTemplatePrepareContexts, so that JSContextTemplateCreateContext only has to hand one out. Because all contexts made from a template share a context group, each prelude is parsed and compiled to bytecode once and only linked against each new global object.
+ */
+JS_EXPORT JSContextTemplateRef JSContextTemplateCreate(JSContextGroupRef group, JSClassRef globalObjectClass);
+
+/*!
+ @function
+ @abstract Retains a context template.
+ @param contextTemplate The context template to retain.
+ @result A JSContextTemplateRef that is the same as contextTemplate.
+ */
+JS_EXPORT JSContextTemplateRef JSContextTemplateRetain(JSContextTemplateRef contextTemplate);
+
+/*!
+ @function
+ @abstract Releases a context template. Contexts that were prepared but never handed out are released with it.
+ @param contextTemplate The context template to release.
+ */
+JS_EXPORT void JSContextTemplateRelease(JSContextTemplateRef contextTemplate);
+
+/*!
+ @function
+ @abstract Appends a script to the list of preludes evaluated in every context created from the template.
+ @param contextTemplate The context template to which to add the prelude.
+ @param url The source url to be reported in errors and exceptions.
+ @param startingLineNumber An integer value specifying the script's starting line number in the file located at url. This is only used when reporting exceptions. The value is one-based, so the first line is line 1 and invalid values are clamped to 1.
+ @param source The source string.
+ @param errorMessage A pointer to a JSStringRef in which to store the parse error message if the source is not valid. Pass NULL if you do not care to store an error message.
+ @param errorLine A pointer to an int in which to store the line number of a parser error. Pass NULL if you do not care to store an error line.
+ @result true if the prelude was added, false if the source is not a valid JavaScript program.
+ @discussion Contexts that were already prepared are discarded, since they have not run the new prelude.
+ */
+JS_EXPORT bool JSContextTemplateAddPrelude(JSContextTemplateRef contextTemplate, JSStringRef url, int startingLineNumber, JSStringRef source, JSStringRef* errorMessage, int* errorLine);
+
+/*!
+ @function
+ @abstract Creates contexts ahead of time, until the template holds the requested number of prepared contexts.
+ @param contextTemplate The context template to prepare contexts for.
+ @param count The number of prepared contexts to hold.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result The number of prepared contexts the template holds. This is less than count if a prelude threw.
+ @discussion Call this when the embedder is idle, so that the cost of initializing global objects and running preludes is not paid when a context is needed.
+ */
+JS_EXPORT size_t JSContextTemplatePrepareContexts(JSContextTemplateRef contextTemplate, size_t count, JSValueRef* exception);
+
+/*!
+ @function
+ @abstract Gets the number of prepared contexts a context template holds.
+ @param contextTemplate The context template to query.
+ @result The number of contexts JSContextTemplateCreateContext can hand out without creating one.
+ */
+JS_EXPORT size_t JSContextTemplateGetPreparedContextCount(JSContextTemplateRef contextTemplate);
+
+/*!
+ @function
+ @abstract Creates a global context from a context template.
+ @param contextTemplate The context template to create the context from.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result A JSGlobalContextRef in which all the template's preludes have run, or NULL if a prelude threw. Ownership follows the Create Rule.
+ @discussion If the template holds a prepared context, it is returned. Otherwise a new context is created and the preludes are evaluated in it.
+ */
+JS_EXPORT JSGlobalContextRef JSContextTemplateCreateContext(JSContextTemplateRef contextTemplate, JSValueRef* exception);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JSContextTemplateRefPrivate_h */
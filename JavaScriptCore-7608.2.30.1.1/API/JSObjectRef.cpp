@@ -52,6 +52,7 @@
 #include "JSString.h"
 #include "JSValueRef.h"
 #include "ObjectConstructor.h"
+#include "ObjectInitializationScope.h"
 #include "ObjectPrototype.h"
 #include "PropertyNameArray.h"
 #include "ProxyObject.h"
@@ -872,6 +873,101 @@ JSObjectRef JSObjectGetProxyTarget(JSObjectRef objectRef)
     return toRef(result);
 }
 
+JSObjectRef JSObjectMakeWithProperties(JSContextRef ctx, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef propertyValues[], JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return 0;
+    }
+    ExecState* exec = toJS(ctx);
+    VM& vm = exec->vm();
+    JSLockHolder locker(vm);
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+    unsigned inlineCapacity = static_cast<unsigned>(std::min<size_t>(propertyCount, JSFinalObject::maxInlineCapacity()));
+    JSObject* result = constructEmptyObject(exec, globalObject->objectPrototype(), inlineCapacity);
+
+    for (size_t i = 0; i < propertyCount; ++i) {
+        result->putDirectMayBeIndex(exec, propertyNames[i]->identifier(&vm), toJS(exec, propertyValues[i]));
+        if (handleExceptionIfNeeded(scope, exec, exception) == ExceptionStatus::DidThrow)
+            return 0;
+    }
+
+    return toRef(result);
+}
+
+bool JSObjectGetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], JSValueRef propertyValues[], JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return false;
+    }
+    ExecState* exec = toJS(ctx);
+    VM& vm = exec->vm();
+    JSLockHolder locker(vm);
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    JSObject* jsObject = toJS(object);
+
+    for (size_t i = 0; i < propertyCount; ++i) {
+        JSValue jsValue = jsObject->get(exec, propertyNames[i]->identifier(&vm));
+        if (handleExceptionIfNeeded(scope, exec, exception) == ExceptionStatus::DidThrow) {
+            std::fill(propertyValues + i, propertyValues + propertyCount, nullptr);
+            return false;
+        }
+        propertyValues[i] = toRef(exec, jsValue);
+    }
+
+    return true;
+}
+
+JSObjectRef JSObjectMakeArrayWithNumbers(JSContextRef ctx, size_t count, const double numbers[], JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return 0;
+    }
+    ExecState* exec = toJS(ctx);
+    VM& vm = exec->vm();
+    JSLockHolder locker(vm);
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    // Pick the storage the array would have ended up with had JS code filled it in. Double arrays
+    // use PNaN for holes, so a NaN element forces contiguous (boxed) storage.
+    IndexingType indexingType = ArrayWithInt32;
+    for (size_t i = 0; i < count; ++i) {
+        double number = numbers[i];
+        if (std::isnan(number)) {
+            indexingType = ArrayWithContiguous;
+            break;
+        }
+        if (!canBeStrictInt32(number))
+            indexingType = ArrayWithDouble;
+    }
+
+    JSArray* result = nullptr;
+    if (count <= MAX_STORAGE_VECTOR_LENGTH) {
+        unsigned length = static_cast<unsigned>(count);
+        JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+        ObjectInitializationScope initializationScope(vm);
+        result = JSArray::tryCreateUninitializedRestricted(initializationScope, globalObject->arrayStructureForIndexingTypeDuringAllocation(indexingType), length);
+        if (result) {
+            for (unsigned i = 0; i < length; ++i)
+                result->initializeIndex(initializationScope, i, jsNumber(numbers[i]));
+        }
+    }
+
+    if (!result) {
+        auto throwScope = DECLARE_THROW_SCOPE(vm);
+        throwOutOfMemoryError(exec, throwScope);
+        handleExceptionIfNeeded(scope, exec, exception);
+        return 0;
+    }
+
+    return toRef(result);
+}
+
 JSGlobalContextRef JSObjectGetGlobalContext(JSObjectRef objectRef)
 {
     JSObject* object = toJS(objectRef);
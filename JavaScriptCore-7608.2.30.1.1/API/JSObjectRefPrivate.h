@@ -69,6 +69,46 @@ JS_EXPORT bool JSObjectDeletePrivateProperty(JSContextRef ctx, JSObjectRef objec
 
 JS_EXPORT JSObjectRef JSObjectGetProxyTarget(JSObjectRef);
 
+/*!
+ @function
+ @abstract Creates a JavaScript object with the given properties.
+ @param ctx The execution context to use.
+ @param propertyCount An integer count of the number of properties in propertyNames and propertyValues.
+ @param propertyNames A JSString array containing the properties' names. Pass NULL if propertyCount is 0.
+ @param propertyValues A JSValue array containing the properties' values. Pass NULL if propertyCount is 0.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result A JSObject with the default object class and Object.prototype as its prototype, or NULL if an exception was thrown.
+ @discussion This is equivalent to calling JSObjectMake followed by JSObjectSetProperty with kJSPropertyAttributeNone for each property, but takes the JavaScript lock once and defines the properties directly, without going through setters on the prototype chain. If a name appears more than once, the last value wins.
+ */
+JS_EXPORT JSObjectRef JSObjectMakeWithProperties(JSContextRef ctx, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef propertyValues[], JSValueRef* exception);
+
+/*!
+ @function
+ @abstract Gets several properties from an object.
+ @param ctx The execution context to use.
+ @param object The JSObject whose properties you want to get.
+ @param propertyCount An integer count of the number of properties in propertyNames.
+ @param propertyNames A JSString array containing the names of the properties to get.
+ @param propertyValues A JSValue array of at least propertyCount elements in which to store the properties' values. A property that the object does not have is stored as the undefined value.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result true if all properties were read, false if a getter threw. In that case, the values for the property that threw and all subsequent properties are set to NULL.
+ */
+JS_EXPORT bool JSObjectGetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], JSValueRef propertyValues[], JSValueRef* exception);
+
+/*!
+ @function
+ @abstract Creates a JavaScript Array object from a buffer of numbers.
+ @param ctx The execution context to use.
+ @param count The number of elements in numbers.
+ @param numbers A buffer of doubles to copy into the array. Pass NULL if count is 0.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result A JSObject that is an Array, or NULL if an exception was thrown.
+ @discussion Unlike JSObjectMakeArray, this does not box each element in a JSValueRef first. The array uses the most compact storage that can represent the values, so an array of integers is stored as one.
+
+ To expose a buffer to JavaScript without copying it, use JSObjectMakeTypedArrayWithBytesNoCopy or JSObjectMakeArrayBufferWithBytesNoCopy instead.
+ */
+JS_EXPORT JSObjectRef JSObjectMakeArrayWithNumbers(JSContextRef ctx, size_t count, const double numbers[], JSValueRef* exception);
+
 JS_EXPORT JSGlobalContextRef JSObjectGetGlobalContext(JSObjectRef object);
 
 #ifdef __cplusplus
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSStructuredCloneRefPrivate.h"
+
+#include "APICast.h"
+#include "APIUtils.h"
+#include "Error.h"
+#include "JSArrayBuffer.h"
+#include "JSCInlines.h"
+#include "StructuredCloneData.h"
+#include <wtf/ThreadSafeRefCounted.h>
+
+using namespace JSC;
+
+struct OpaqueJSStructuredClone : public ThreadSafeRefCounted<OpaqueJSStructuredClone> {
+public:
+    static Ref<OpaqueJSStructuredClone> create(Ref<StructuredCloneData>&& data)
+    {
+        return adoptRef(*new OpaqueJSStructuredClone(WTFMove(data)));
+    }
+
+    StructuredCloneData& data() { return m_data.get(); }
+
+private:
+    OpaqueJSStructuredClone(Ref<StructuredCloneData>&& data)
+        : m_data(WTFMove(data))
+    {
+    }
+
+    Ref<StructuredCloneData> m_data;
+};
+
+extern "C" {
+
+JSStructuredCloneRef JSStructuredCloneCreate(JSContextRef ctx, JSValueRef value, const JSObjectRef transferList[], size_t transferCount, JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return nullptr;
+    }
+    ExecState* exec = toJS(ctx);
+    VM& vm = exec->vm();
+    JSLockHolder locker(vm);
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    Vector<JSArrayBuffer*> arrayBuffers;
+    arrayBuffers.reserveInitialCapacity(transferCount);
+    for (size_t i = 0; i < transferCount; ++i) {
+        JSArrayBuffer* arrayBuffer = transferList[i] ? jsDynamicCast<JSArrayBuffer*>(vm, toJS(transferList[i])) : nullptr;
+        if (!arrayBuffer) {
+            setException(exec, exception, createTypeError(exec, "JSStructuredCloneCreate expects transferList to contain only ArrayBuffer objects"_s));
+            return nullptr;
+        }
+        arrayBuffers.uncheckedAppend(arrayBuffer);
+    }
+
+    RefPtr<StructuredCloneData> data = StructuredCloneData::serialize(exec, toJS(exec, value), arrayBuffers);
+    if (handleExceptionIfNeeded(scope, exec, exception) == ExceptionStatus::DidThrow)
+        return nullptr;
+    return &OpaqueJSStructuredClone::create(data.releaseNonNull()).leakRef();
+}
+
+JSStructuredCloneRef JSStructuredCloneRetain(JSStructuredCloneRef structuredClone)
+{
+    structuredClone->ref();
+    return structuredClone;
+}
+
+void JSStructuredCloneRelease(JSStructuredCloneRef structuredClone)
+{
+    structuredClone->deref();
+}
+
+size_t JSStructuredCloneGetByteLength(JSStructuredCloneRef structuredClone)
+{
+    return structuredClone->data().sizeInBytes();
+}
+
+JSValueRef JSStructuredCloneCreateValue(JSContextRef ctx, JSStructuredCloneRef structuredClone, JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return nullptr;
+    }
+    ExecState* exec = toJS(ctx);
+    VM& vm = exec->vm();
+    JSLockHolder locker(vm);
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    JSValue result = structuredClone->data().deserialize(exec);
+    if (handleExceptionIfNeeded(scope, exec, exception) == ExceptionStatus::DidThrow)
+        return nullptr;
+    return toRef(exec, result);
+}
+
+}
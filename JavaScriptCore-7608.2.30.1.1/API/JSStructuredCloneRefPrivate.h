@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef JSStructuredCloneRefPrivate_h
+#define JSStructuredCloneRefPrivate_h
+
+#include <JavaScriptCore/JSContextRef.h>
+#include <JavaScriptCore/JSValueRef.h>
+
+/*! @typedef JSStructuredCloneRef A deep copy of a JavaScript value that does not belong to any context group. */
+typedef struct OpaqueJSStructuredClone* JSStructuredCloneRef;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ @function
+ @abstract Makes a structured clone of a JavaScript value.
+ @param ctx The execution context to use.
+ @param value The JSValue to clone.
+ @param transferList An array of ArrayBuffer objects whose contents move into the clone instead of being copied. Pass NULL if transferCount is 0.
+ @param transferCount The number of objects in transferList.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result A JSStructuredCloneRef, or NULL if value cannot be cloned. Ownership follows the Create Rule.
+ @discussion Undefined, null, booleans, numbers, strings, plain objects, arrays, dates and ArrayBuffers can be cloned. Cycles and shared references are preserved. The clone is a compact binary buffer that can be passed to another thread and turned back into a value in any context, including one in a different context group. ArrayBuffers in transferList are neutered once the clone has been made.
+ */
+JS_EXPORT JSStructuredCloneRef JSStructuredCloneCreate(JSContextRef ctx, JSValueRef value, const JSObjectRef transferList[], size_t transferCount, JSValueRef* exception);
+
+/*!
+ @function
+ @abstract Retains a structured clone.
+ @param structuredClone The structured clone to retain.
+ @result A JSStructuredCloneRef that is the same as structuredClone.
+ */
+JS_EXPORT JSStructuredCloneRef JSStructuredCloneRetain(JSStructuredCloneRef structuredClone);
+
+/*!
+ @function
+ @abstract Releases a structured clone.
+ @param structuredClone The structured clone to release.
+ */
+JS_EXPORT void JSStructuredCloneRelease(JSStructuredCloneRef structuredClone);
+
+/*!
+ @function
+ @abstract Gets the size of a structured clone's serialized data.
+ @param structuredClone The structured clone to query.
+ @result The number of bytes the clone uses, not counting the contents of transferred ArrayBuffers.
+ */
+JS_EXPORT size_t JSStructuredCloneGetByteLength(JSStructuredCloneRef structuredClone);
+
+/*!
+ @function
+ @abstract Creates a JavaScript value from a structured clone.
+ @param ctx The execution context in which to create the value.
+ @param structuredClone The structured clone to materialize.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result A new copy of the cloned value, or NULL if an exception is thrown.
+ @discussion A clone can be materialized any number of times, unless it holds transferred ArrayBuffers, which can only be materialized once.
+ */
+JS_EXPORT JSValueRef JSStructuredCloneCreateValue(JSContextRef ctx, JSStructuredCloneRef structuredClone, JSValueRef* exception);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JSStructuredCloneRefPrivate_h */
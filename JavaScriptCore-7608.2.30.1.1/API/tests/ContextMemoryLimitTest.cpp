@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "ContextMemoryLimitTest.h"
+
+#include "JSContextRefPrivate.h"
+#include "JavaScript.h"
+
+int testContextMemoryLimit()
+{
+    bool overallResult = true;
+
+    printf("ContextMemoryLimitTest:\n");
+
+    auto test = [&] (const char* description, bool currentResult) {
+        printf("    %s: %s\n", description, currentResult ? "PASS" : "FAIL");
+        overallResult &= currentResult;
+    };
+
+    auto evaluate = [] (JSGlobalContextRef context, const char* source, JSValueRef* exception) -> JSValueRef {
+        JSStringRef script = JSStringCreateWithUTF8CString(source);
+        JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, exception);
+        JSStringRelease(script);
+        return result;
+    };
+
+    JSContextGroupRef group = JSContextGroupCreate();
+    JSGlobalContextRef limited = JSGlobalContextCreateInGroup(group, nullptr);
+    JSGlobalContextRef unlimited = JSGlobalContextCreateInGroup(group, nullptr);
+
+    JSContextResourceUsage usage;
+    test("Contexts without limits do not report usage", !JSGlobalContextGetResourceUsage(unlimited, &usage));
+
+    const size_t megabyte = 1024 * 1024;
+    JSGlobalContextSetMemoryLimits(limited, 4 * megabyte, 16 * megabyte);
+
+    JSValueRef exception = nullptr;
+    evaluate(limited, "for (var i = 0; i < 1000; ++i) new Array(100).fill(i);", &exception);
+    test("Garbage below the limits runs to completion", !exception);
+    test("Usage is reported once limits are set", JSGlobalContextGetResourceUsage(limited, &usage) && usage.allocatedBytes && !usage.hardMemoryLimitTerminations);
+
+    exception = nullptr;
+    evaluate(limited, "var retained = []; while (true) retained.push(new Array(1000).fill(0));", &exception);
+    test("Retaining memory past the hard limit terminates the script", !!exception);
+    JSGlobalContextGetResourceUsage(limited, &usage);
+    test("Termination is counted", usage.hardMemoryLimitTerminations == 1);
+    test("The soft limit triggered a collection first", usage.softMemoryLimitCollections >= 1);
+
+    exception = nullptr;
+    JSValueRef result = evaluate(unlimited, "var total = 0; for (var i = 0; i < 1000; ++i) total += new Array(1000).fill(1).length; total", &exception);
+    test("Other contexts in the group are not charged", !exception && JSValueToNumber(unlimited, result, nullptr) == 1000000);
+
+    JSGlobalContextRef optimized = JSGlobalContextCreateInGroup(group, nullptr);
+    exception = nullptr;
+    evaluate(optimized, "function grow(retained, size) { for (var i = 0; i < 100; ++i) retained.push(new Array(size).fill(0)); } for (var i = 0; i < 1000; ++i) grow([], 10);", &exception);
+    JSGlobalContextSetMemoryLimits(optimized, 4 * megabyte, 16 * megabyte);
+    evaluate(optimized, "var retained = []; while (true) grow(retained, 1000);", &exception);
+    test("Limits set after code was optimized still terminate the script", !!exception);
+
+    JSGlobalContextRelease(optimized);
+    JSGlobalContextRelease(limited);
+    JSGlobalContextRelease(unlimited);
+    JSContextGroupRelease(group);
+
+    printf("ContextMemoryLimitTest: %s\n", overallResult ? "PASS" : "FAIL");
+    return !overallResult;
+}
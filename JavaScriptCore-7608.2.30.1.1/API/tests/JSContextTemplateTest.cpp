@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSContextTemplateTest.h"
+
+#include "JSContextTemplateRefPrivate.h"
+#include "JavaScript.h"
+
+int testJSContextTemplate()
+{
+    bool overallResult = true;
+
+    printf("JSContextTemplateTest:\n");
+
+    auto test = [&] (const char* description, bool currentResult) {
+        printf("    %s: %s\n", description, currentResult ? "PASS" : "FAIL");
+        overallResult &= currentResult;
+    };
+
+    auto evaluate = [] (JSGlobalContextRef context, const char* source) -> JSValueRef {
+        JSStringRef script = JSStringCreateWithUTF8CString(source);
+        JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, nullptr);
+        JSStringRelease(script);
+        return result;
+    };
+
+    auto addPrelude = [] (JSContextTemplateRef contextTemplate, const char* source) -> bool {
+        JSStringRef script = JSStringCreateWithUTF8CString(source);
+        bool result = JSContextTemplateAddPrelude(contextTemplate, nullptr, 1, script, nullptr, nullptr);
+        JSStringRelease(script);
+        return result;
+    };
+
+    JSContextTemplateRef contextTemplate = JSContextTemplateCreate(nullptr, nullptr);
+
+    test("JSContextTemplateAddPrelude accepts valid scripts", addPrelude(contextTemplate, "var counter = 0; function bump() { return ++counter; }"));
+    test("JSContextTemplateAddPrelude rejects syntax errors", !addPrelude(contextTemplate, "function ("));
+
+    JSValueRef exception = nullptr;
+    test("JSContextTemplatePrepareContexts prepares the requested contexts", JSContextTemplatePrepareContexts(contextTemplate, 2, &exception) == 2 && !exception);
+    test("JSContextTemplateGetPreparedContextCount reports prepared contexts", JSContextTemplateGetPreparedContextCount(contextTemplate) == 2);
+
+    JSGlobalContextRef first = JSContextTemplateCreateContext(contextTemplate, &exception);
+    JSGlobalContextRef second = JSContextTemplateCreateContext(contextTemplate, &exception);
+    JSGlobalContextRef third = JSContextTemplateCreateContext(contextTemplate, &exception);
+    test("JSContextTemplateCreateContext hands out prepared contexts first", JSContextTemplateGetPreparedContextCount(contextTemplate) == 0);
+    test("JSContextTemplateCreateContext makes contexts when none are prepared", first && second && third && !exception);
+    test("Contexts share the same group", JSContextGetGroup(first) == JSContextGetGroup(third));
+
+    test("Preludes run in every context", JSValueToNumber(first, evaluate(first, "bump()"), nullptr) == 1 && JSValueToNumber(third, evaluate(third, "bump()"), nullptr) == 1);
+    test("Contexts do not share globals", JSValueToNumber(first, evaluate(first, "bump()"), nullptr) == 2 && JSValueToNumber(second, evaluate(second, "counter"), nullptr) == 0);
+
+    JSContextTemplatePrepareContexts(contextTemplate, 1, nullptr);
+    addPrelude(contextTemplate, "counter = 10;");
+    test("Adding a prelude discards prepared contexts", !JSContextTemplateGetPreparedContextCount(contextTemplate));
+    JSGlobalContextRef fourth = JSContextTemplateCreateContext(contextTemplate, nullptr);
+    test("Later preludes run after earlier ones", JSValueToNumber(fourth, evaluate(fourth, "bump()"), nullptr) == 11);
+
+    addPrelude(contextTemplate, "throw new Error('prelude failed');");
+    exception = nullptr;
+    test("JSContextTemplateCreateContext returns null when a prelude throws", !JSContextTemplateCreateContext(contextTemplate, &exception) && exception);
+
+    JSGlobalContextRelease(first);
+    JSGlobalContextRelease(second);
+    JSGlobalContextRelease(third);
+    JSGlobalContextRelease(fourth);
+    JSContextTemplateRelease(contextTemplate);
+
+    printf("JSContextTemplateTest: %s\n", overallResult ? "PASS" : "FAIL");
+    return !overallResult;
+}
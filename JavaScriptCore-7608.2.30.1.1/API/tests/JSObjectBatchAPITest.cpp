@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSObjectBatchAPITest.h"
+
+#include "JSObjectRefPrivate.h"
+#include "JavaScript.h"
+#include <cmath>
+
+int testJSObjectBatchAPI()
+{
+    bool overallResult = true;
+
+    printf("JSObjectBatchAPITest:\n");
+
+    auto test = [&] (const char* description, bool currentResult) {
+        printf("    %s: %s\n", description, currentResult ? "PASS" : "FAIL");
+        overallResult &= currentResult;
+    };
+
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(nullptr, nullptr);
+
+    auto evaluate = [&] (const char* source) -> JSValueRef {
+        JSStringRef script = JSStringCreateWithUTF8CString(source);
+        JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, nullptr);
+        JSStringRelease(script);
+        return result;
+    };
+
+    JSStringRef names[] = {
+        JSStringCreateWithUTF8CString("x"),
+        JSStringCreateWithUTF8CString("y"),
+        JSStringCreateWithUTF8CString("0"),
+        JSStringCreateWithUTF8CString("x"),
+    };
+    JSValueRef values[] = {
+        JSValueMakeNumber(context, 1),
+        JSValueMakeBoolean(context, true),
+        JSValueMakeNumber(context, 3),
+        JSValueMakeNumber(context, 4),
+    };
+
+    {
+        JSValueRef exception = nullptr;
+        JSObjectRef object = JSObjectMakeWithProperties(context, 4, names, values, &exception);
+        test("JSObjectMakeWithProperties makes an object", object && !exception);
+
+        JSStringRef globalName = JSStringCreateWithUTF8CString("batchObject");
+        JSObjectSetProperty(context, JSContextGetGlobalObject(context), globalName, object, kJSPropertyAttributeNone, nullptr);
+        JSStringRelease(globalName);
+
+        test("JSObjectMakeWithProperties sets named and indexed properties",
+            JSValueToBoolean(context, evaluate("batchObject.y === true && batchObject[0] === 3 && Object.getPrototypeOf(batchObject) === Object.prototype")));
+        test("JSObjectMakeWithProperties lets the last duplicate win",
+            JSValueToBoolean(context, evaluate("batchObject.x === 4 && Object.keys(batchObject).join() === '0,x,y'")));
+
+        JSValueRef results[4];
+        test("JSObjectGetProperties succeeds", JSObjectGetProperties(context, object, 4, names, results, &exception) && !exception);
+        test("JSObjectGetProperties reads every property",
+            JSValueToNumber(context, results[0], nullptr) == 4
+            && JSValueToBoolean(context, results[1])
+            && JSValueToNumber(context, results[2], nullptr) == 3
+            && JSValueToNumber(context, results[3], nullptr) == 4);
+    }
+
+    {
+        JSObjectRef object = JSValueToObject(context, evaluate("({ get x() { return 1; }, get y() { throw new Error('y'); } })"), nullptr);
+        JSValueRef exception = nullptr;
+        JSValueRef results[4];
+        bool succeeded = JSObjectGetProperties(context, object, 4, names, results, &exception);
+        test("JSObjectGetProperties stops at a throwing getter", !succeeded && exception);
+        test("JSObjectGetProperties keeps values read before the exception", results[0] && JSValueToNumber(context, results[0], nullptr) == 1);
+        test("JSObjectGetProperties clears the remaining values", !results[1] && !results[2] && !results[3]);
+    }
+
+    {
+        JSValueRef exception = nullptr;
+        double integers[] = { 1, 2, 3 };
+        JSObjectRef array = JSObjectMakeArrayWithNumbers(context, 3, integers, &exception);
+        test("JSObjectMakeArrayWithNumbers makes an array", array && !exception && JSValueIsArray(context, array));
+        test("JSObjectMakeArrayWithNumbers copies integers", JSValueToNumber(context, JSObjectGetPropertyAtIndex(context, array, 2, nullptr), nullptr) == 3);
+
+        double doubles[] = { 0.5, -0.0, NAN, 1e300 };
+        array = JSObjectMakeArrayWithNumbers(context, 4, doubles, &exception);
+        JSValueRef negativeZero = JSObjectGetPropertyAtIndex(context, array, 1, nullptr);
+        JSValueRef nan = JSObjectGetPropertyAtIndex(context, array, 2, nullptr);
+        test("JSObjectMakeArrayWithNumbers copies doubles",
+            JSValueToNumber(context, JSObjectGetPropertyAtIndex(context, array, 0, nullptr), nullptr) == 0.5
+            && std::signbit(JSValueToNumber(context, negativeZero, nullptr))
+            && std::isnan(JSValueToNumber(context, nan, nullptr))
+            && JSValueToNumber(context, JSObjectGetPropertyAtIndex(context, array, 3, nullptr), nullptr) == 1e300);
+
+        array = JSObjectMakeArrayWithNumbers(context, 0, nullptr, &exception);
+        JSStringRef lengthName = JSStringCreateWithUTF8CString("length");
+        test("JSObjectMakeArrayWithNumbers makes empty arrays", JSValueToNumber(context, JSObjectGetProperty(context, array, lengthName, nullptr), nullptr) == 0);
+        JSStringRelease(lengthName);
+    }
+
+    for (JSStringRef name : names)
+        JSStringRelease(name);
+    JSGlobalContextRelease(context);
+
+    printf("JSObjectBatchAPITest: %s\n", overallResult ? "PASS" : "FAIL");
+    return !overallResult;
+}
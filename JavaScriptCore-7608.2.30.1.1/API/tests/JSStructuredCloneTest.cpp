@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSStructuredCloneTest.h"
+
+#include "JSStructuredCloneRefPrivate.h"
+#include "JavaScript.h"
+
+static JSValueRef transferCallback(JSContextRef context, JSObjectRef, JSObjectRef, size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception)
+{
+    if (argumentCount < 1)
+        return JSValueMakeUndefined(context);
+    JSObjectRef transferList[] = { JSValueToObject(context, arguments[0], exception) };
+    if (JSStructuredCloneRef structuredClone = JSStructuredCloneCreate(context, arguments[0], transferList, 1, exception))
+        JSStructuredCloneRelease(structuredClone);
+    return JSValueMakeUndefined(context);
+}
+
+int testJSStructuredClone()
+{
+    bool overallResult = true;
+
+    printf("JSStructuredCloneTest:\n");
+
+    auto test = [&] (const char* description, bool currentResult) {
+        printf("    %s: %s\n", description, currentResult ? "PASS" : "FAIL");
+        overallResult &= currentResult;
+    };
+
+    auto evaluate = [] (JSGlobalContextRef context, const char* source) -> JSValueRef {
+        JSStringRef script = JSStringCreateWithUTF8CString(source);
+        JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, nullptr);
+        JSStringRelease(script);
+        return result;
+    };
+
+    auto isTrue = [&] (JSGlobalContextRef context, const char* source) -> bool {
+        JSValueRef result = evaluate(context, source);
+        return result && JSValueToBoolean(context, result);
+    };
+
+    auto setGlobal = [] (JSGlobalContextRef context, const char* name, JSValueRef value) {
+        JSStringRef propertyName = JSStringCreateWithUTF8CString(name);
+        JSObjectSetProperty(context, JSContextGetGlobalObject(context), propertyName, value, kJSPropertyAttributeNone, nullptr);
+        JSStringRelease(propertyName);
+    };
+
+    // Clones move between context groups, which don't share a VM.
+    JSGlobalContextRef source = JSGlobalContextCreateInGroup(nullptr, nullptr);
+    JSGlobalContextRef destination = JSGlobalContextCreateInGroup(nullptr, nullptr);
+
+    JSValueRef value = evaluate(source, "var points = []; for (var i = 0; i < 100; ++i) points.push({ x: i, y: -i, label: 'point' }); "
+        "var graph = { points, name: 'graph', when: new Date(1000), holes: [1, , 3], nested: { list: [null, undefined, true, 1.5] } }; graph.self = graph; graph");
+    JSValueRef exception = nullptr;
+    JSStructuredCloneRef structuredClone = JSStructuredCloneCreate(source, value, nullptr, 0, &exception);
+    test("JSStructuredCloneCreate clones plain objects", structuredClone && !exception);
+    test("JSStructuredCloneGetByteLength writes repeated shapes and strings once", JSStructuredCloneGetByteLength(structuredClone) < 1500);
+
+    JSValueRef copy = JSStructuredCloneCreateValue(destination, structuredClone, &exception);
+    test("JSStructuredCloneCreateValue materializes the clone in another group", copy && !exception);
+    setGlobal(destination, "copy", copy);
+    test("Arrays of objects are copied", isTrue(destination, "copy.points.length === 100 && copy.points[42].x === 42 && copy.points[42].y === -42 && copy.points[99].label === 'point'"));
+    test("Cycles are preserved", isTrue(destination, "copy.self === copy"));
+    test("Dates, holes and primitives are copied", isTrue(destination, "copy.when.getTime() === 1000 && copy.holes.length === 3 && !(1 in copy.holes) && copy.holes[2] === 3 "
+        "&& copy.nested.list[0] === null && copy.nested.list[1] === undefined && copy.nested.list[2] === true && copy.nested.list[3] === 1.5"));
+    test("The copy is independent of the original", isTrue(source, "graph.points[0].x = 7; true") && isTrue(destination, "copy.points[0].x === 0"));
+
+    JSValueRef secondCopy = JSStructuredCloneCreateValue(destination, structuredClone, nullptr);
+    setGlobal(destination, "secondCopy", secondCopy);
+    test("Clones without transferred buffers can be materialized again", secondCopy && isTrue(destination, "secondCopy !== copy && secondCopy.points[1].x === 1"));
+    JSStructuredCloneRelease(structuredClone);
+
+    exception = nullptr;
+    test("Functions cannot be cloned", !JSStructuredCloneCreate(source, evaluate(source, "({ f() { } })"), nullptr, 0, &exception) && exception);
+
+    JSObjectRef buffer = JSValueToObject(source, evaluate(source, "var buffer = new Uint8Array([1, 2, 3, 4]).buffer; buffer"), nullptr);
+    JSObjectRef transferList[] = { buffer };
+    exception = nullptr;
+    structuredClone = JSStructuredCloneCreate(source, evaluate(source, "({ buffer, alias: buffer })"), transferList, 1, &exception);
+    test("JSStructuredCloneCreate transfers ArrayBuffers", structuredClone && !exception);
+    test("Transferred ArrayBuffers are neutered", isTrue(source, "buffer.byteLength === 0"));
+
+    copy = JSStructuredCloneCreateValue(destination, structuredClone, &exception);
+    setGlobal(destination, "transferred", copy);
+    test("Transferred ArrayBuffers keep their contents", copy && isTrue(destination, "transferred.buffer === transferred.alias && new Uint8Array(transferred.buffer)[3] === 4"));
+    exception = nullptr;
+    test("Transferred ArrayBuffers can only be materialized once", !JSStructuredCloneCreateValue(destination, structuredClone, &exception) && exception);
+    JSStructuredCloneRelease(structuredClone);
+
+    setGlobal(source, "transfer", JSObjectMakeFunctionWithCallback(source, nullptr, transferCallback));
+    JSObjectRef first = JSValueToObject(source, evaluate(source, "var first = new Uint8Array([1]).buffer; first"), nullptr);
+    JSObjectRef second = JSValueToObject(source, evaluate(source, "var second = new Uint8Array([2]).buffer; second"), nullptr);
+    JSObjectRef bothBuffers[] = { first, second };
+    exception = nullptr;
+    structuredClone = JSStructuredCloneCreate(source, evaluate(source, "({ first, get neuter() { transfer(second); } })"), bothBuffers, 2, &exception);
+    setGlobal(source, "error", exception);
+    test("Buffers neutered during serialization cannot be transferred", !structuredClone && isTrue(source, "error instanceof TypeError"));
+    test("A failed transfer neuters none of the buffers", isTrue(source, "first.byteLength === 1"));
+
+    JSObjectRef nullTransferList[] = { nullptr };
+    exception = nullptr;
+    test("Null transfer list entries are rejected", !JSStructuredCloneCreate(source, evaluate(source, "({ })"), nullTransferList, 1, &exception) && exception);
+
+    JSGlobalContextRelease(source);
+    JSGlobalContextRelease(destination);
+
+    printf("JSStructuredCloneTest: %s\n", overallResult ? "PASS" : "FAIL");
+    return !overallResult;
+}
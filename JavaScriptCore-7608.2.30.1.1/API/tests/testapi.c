@@ -59,11 +59,15 @@
 #endif
 
 #include "CompareAndSwapTest.h"
+#include "ContextMemoryLimitTest.h"
 #include "CustomGlobalObjectClassTest.h"
 #include "ExecutionTimeLimitTest.h"
 #include "FunctionOverridesTest.h"
 #include "GlobalContextWithFinalizerTest.h"
+#include "JSContextTemplateTest.h"
 #include "JSONParseTest.h"
+#include "JSStructuredCloneTest.h"
+#include "JSObjectBatchAPITest.h"
 #include "JSObjectGetProxyTargetTest.h"
 #include "MultithreadedMultiVMExecutionTest.h"
 #include "PingPongStackOverflowTest.h"
@@ -2104,6 +2108,10 @@ int main(int argc, char* argv[])
     failed |= testPingPongStackOverflow();
     failed |= testJSONParse();
     failed |= testJSObjectGetProxyTarget();
+    failed |= testJSObjectBatchAPI();
+    failed |= testJSContextTemplate();
+    failed |= testJSStructuredClone();
+    failed |= testContextMemoryLimit();
 
     // Clear out local variables pointing at JSObjectRefs to allow their values to be collected
     function = NULL;
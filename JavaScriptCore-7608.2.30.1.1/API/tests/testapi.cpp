@@ -26,8 +26,12 @@
 #include "config.h"
 
 #include "APICast.h"
+#include "CodeBlock.h"
+#include "JSCInlines.h"
 #include "JSCJSValueInlines.h"
 #include "JSObject.h"
+#include "TypeProfiler.h"
+#include "TypeProfilerLog.h"
 
 #include <JavaScriptCore/JSObjectRefPrivate.h>
 #include <JavaScriptCore/JavaScript.h>
@@ -137,6 +141,16 @@ public:
     void symbolsDeletePropertyForKey();
     void promiseResolveTrue();
     void promiseRejectTrue();
+    void awaitAndThenJobOrdering();
+    void numberFormatASCIIFastPathMatchesICU();
+    void searchLargeRopesWithoutResolving();
+    void sunkAllocationQueriesAcrossOSRExit();
+    void spreadOfExistingArrayAcrossOSRExit();
+    void weakMapResizingDuringConcurrentGC();
+    void megamorphicCallSiteLinksThroughDispatchTable();
+    void sampledTypeProfilingInOptimizingTiers();
+    void sharedFunctionCodeBlocksKeepTheirPositions();
+    void regExpReplaceAndSplitFollowTheSpec();
 
     int failed() const { return m_failed; }
 
@@ -491,6 +505,467 @@ void TestAPI::promiseRejectTrue()
     check(passedTrueCalled, "then response function should have been called.");
 }
 
+void TestAPI::awaitAndThenJobOrdering()
+{
+    // Awaiting a primitive or a settled native promise takes one job, and awaiting a thenable takes
+    // two, interleaved with the then() callbacks as the specification's Await orders them. Microtasks
+    // run when the script returns.
+    auto result = evaluateScript(
+        "var awaitOrderingLog = [];"
+        "(function () {"
+        "    var log = awaitOrderingLog;"
+        "    var resolveLater;"
+        "    var later = new Promise((resolve) => resolveLater = resolve);"
+        "    async function primitiveThenPromise() { log.push('a1'); await 1; log.push('a2'); await Promise.resolve(); log.push('a3'); }"
+        "    async function thenable() { log.push('b1'); await { then(resolve) { log.push('b-then'); resolve(); } }; log.push('b2'); }"
+        "    async function rejectedThenPending() {"
+        "        try { await Promise.reject(new Error('rejected')); } catch (e) { log.push('c-catch'); }"
+        "        log.push('c2');"
+        "        await later;"
+        "        log.push('c3');"
+        "    }"
+        "    primitiveThenPromise();"
+        "    thenable();"
+        "    rejectedThenPending();"
+        "    Promise.resolve().then(() => log.push('t1')).then(() => { log.push('t2'); resolveLater(); }).then(() => log.push('t3'));"
+        "    log.push('sync');"
+        "})();");
+    check(!!result, "setting up interleaved awaits should not throw");
+
+    check(functionReturnsTrue("(function () { return awaitOrderingLog.join() === 'a1,b1,sync,a2,b-then,c-catch,c2,t1,a3,b2,t2,c3,t3'; })"),
+        "awaits and then() callbacks should run in the specification's order");
+}
+
+void TestAPI::numberFormatASCIIFastPathMatchesICU()
+{
+    // Asking for the Latin numbering system explicitly resolves to a locale that the ASCII fast path
+    // doesn't handle, so the second formatter always goes through ICU with the same formatting.
+    const char* test = "(function () {"
+        "    if (typeof Intl === 'undefined')"
+        "        return true;"
+        "    var locales = ['en', 'en-US', 'en-GB', 'en-AU', 'en-CA'];"
+        "    var optionsList = ["
+        "        { },"
+        "        { useGrouping: false },"
+        "        { minimumIntegerDigits: 5 },"
+        "        { minimumIntegerDigits: 3, useGrouping: false },"
+        "        { minimumFractionDigits: 3 },"
+        "        { maximumFractionDigits: 0 },"
+        "        { maximumFractionDigits: 1 },"
+        "        { minimumFractionDigits: 2, maximumFractionDigits: 2 },"
+        "        { minimumIntegerDigits: 2, minimumFractionDigits: 1, maximumFractionDigits: 20 },"
+        "    ];"
+        "    var numbers = [0, -0, 1, -1, 0.5, 1.5, 2.5, -2.5, 0.125, 0.0625, 1.005, 999.9995, 1000, -1000, 1234567.891, -9876543.21,"
+        "        123456789012345680000, 1e21, -1e21, 1.5e300, 1e-7, -1e-7, 5e-324, Number.MAX_VALUE, NaN, Infinity, -Infinity];"
+        "    for (var locale of locales) {"
+        "        for (var options of optionsList) {"
+        "            var fast = new Intl.NumberFormat(locale, options);"
+        "            var icu = new Intl.NumberFormat(locale + '-u-nu-latn', options);"
+        "            if (icu.resolvedOptions().locale === fast.resolvedOptions().locale)"
+        "                return false;"
+        "            for (var number of numbers) {"
+        "                if (fast.format(number) !== icu.format(number))"
+        "                    return false;"
+        "            }"
+        "        }"
+        "    }"
+        "    return true;"
+        "})";
+
+    check(functionReturnsTrue(test), "the ASCII number formatting fast path should match ICU");
+}
+
+void TestAPI::searchLargeRopesWithoutResolving()
+{
+    // Every rope is at least 64K characters, so indexOf and includes walk its fibers. The same
+    // searches on a flat copy of each rope give the expected answers.
+    const char* test = "(function () {"
+        "    var fill = 'x'.repeat(40000);"
+        "    var parts = [fill + 'nee', 'dle' + fill, 'n', 'e', 'edle', fill + 'needle', 'ne'];"
+        "    var ropes = [];"
+        "    var left = parts[0] + parts[1];"
+        "    ropes.push([left + parts[2] + parts[3], parts.slice(0, 4).join('')]);"
+        "    ropes.push([left + (parts[2] + parts[3] + parts[4]) + (parts[5] + parts[6]), parts.join('')]);"
+        "    var deep = fill + fill;"
+        "    var deepParts = [fill, fill];"
+        "    for (var i = 0; i < 100; ++i) {"
+        "        deep += parts[i % parts.length];"
+        "        deepParts.push(parts[i % parts.length]);"
+        "    }"
+        "    ropes.push([deep, deepParts.join('')]);"
+        "    var patterns = ['needle', 'eneedle', 'edlex', 'n', 'xne', 'missing', ''];"
+        "    for (var [rope, flat] of ropes) {"
+        "        var starts = [0, 1, 40002, 40003, 40004, 80005, 80007, flat.length - 2, flat.length, flat.length + 1];"
+        "        for (var pattern of patterns) {"
+        "            for (var start of starts) {"
+        "                if (rope.indexOf(pattern, start) !== flat.indexOf(pattern, start))"
+        "                    return false;"
+        "                if (rope.includes(pattern, start) !== flat.includes(pattern, start))"
+        "                    return false;"
+        "            }"
+        "            for (var i = -1, j = -1; ; ) {"
+        "                i = rope.indexOf(pattern, i + 1);"
+        "                j = flat.indexOf(pattern, j + 1);"
+        "                if (i !== j)"
+        "                    return false;"
+        "                if (i < 0 || !pattern)"
+        "                    break;"
+        "            }"
+        "        }"
+        "    }"
+        "    return true;"
+        "})";
+
+    check(functionReturnsTrue(test), "searching a large rope should find matches that straddle fibers and respect the start position");
+}
+
+void TestAPI::sunkAllocationQueriesAcrossOSRExit()
+{
+    // The object and the answers to the queries on it are only recovered when the add below
+    // exits because x stops being an int.
+    const char* test = "(function () {"
+        "    function test(x, other) {"
+        "        var o = { x };"
+        "        var identical = o === o;"
+        "        var same = o === other;"
+        "        var type = typeof o;"
+        "        var y = x + 1;"
+        "        if (!identical || same || type !== 'object')"
+        "            return null;"
+        "        return [o, y];"
+        "    }"
+        "    var other = { x: 0 };"
+        "    for (var i = 0; i < 100000; ++i) {"
+        "        var result = test(i, other);"
+        "        if (!result || result[0].x !== i || result[1] !== i + 1)"
+        "            return false;"
+        "    }"
+        "    var result = test('a', other);"
+        "    return !!result && result[0].x === 'a' && result[1] === 'a1';"
+        "})";
+
+    check(functionReturnsTrue(test), "queries on a sunk allocation should keep their answers after an OSR exit");
+}
+
+void TestAPI::spreadOfExistingArrayAcrossOSRExit()
+{
+    // The spread of a is only materialized when the add exits because x stops being an int, or when
+    // a stops having an original array structure.
+    const char* test = "(function () {"
+        "    function test(a, x) {"
+        "        return [...a, x + 1];"
+        "    }"
+        "    function clobbered(a) {"
+        "        return [...a, a.push(4)];"
+        "    }"
+        "    function same(result, expected) {"
+        "        if (result.length !== expected.length)"
+        "            return false;"
+        "        for (var i = 0; i < expected.length; ++i) {"
+        "            if (!(i in result) || result[i] !== expected[i])"
+        "                return false;"
+        "        }"
+        "        return true;"
+        "    }"
+        "    var object = { };"
+        "    for (var i = 0; i < 100000; ++i) {"
+        "        if (!same(test([1, i], i), [1, i, i + 1]))"
+        "            return false;"
+        "        if (!same(test([1.5, , i + 0.5], i), [1.5, undefined, i + 0.5, i + 1]))"
+        "            return false;"
+        "        if (!same(test(['a', object, , ], i), ['a', object, undefined, i + 1]))"
+        "            return false;"
+        "        if (!same(test([], i), [i + 1]))"
+        "            return false;"
+        "        if (!same(clobbered([1, 2, 3]), [1, 2, 3, 4]))"
+        "            return false;"
+        "    }"
+        "    if (!same(test([1, 2], 'a'), [1, 2, 'a1']))"
+        "        return false;"
+        "    var withProperty = [1, 2];"
+        "    withProperty.foo = 3;"
+        "    if (!same(test(withProperty, 1), [1, 2, 2]))"
+        "        return false;"
+        "    var withGetter = [1, 2];"
+        "    Object.defineProperty(withGetter, 0, { get() { return 7; } });"
+        "    return same(test(withGetter, 1), [7, 2, 2]);"
+        "})";
+
+    check(functionReturnsTrue(test), "spreading an existing array should give the same result before and after an OSR exit");
+}
+
+void TestAPI::weakMapResizingDuringConcurrentGC()
+{
+    // Enough garbage is allocated for concurrent collections to start while the tables grow past
+    // the size that the collector scans in parallel ranges, and while dead keys make them shrink.
+    const char* test = "(function () {"
+        "    var map = new WeakMap();"
+        "    var set = new WeakSet();"
+        "    var keys = [];"
+        "    for (var round = 0; round < 20; ++round) {"
+        "        for (var i = 0; i < 50000; ++i) {"
+        "            var key = { round };"
+        "            keys.push(key);"
+        "            map.set(key, { key });"
+        "            set.add(key);"
+        "        }"
+        "        var survivors = [];"
+        "        for (var i = 0; i < keys.length; ++i) {"
+        "            if (i % 10 === 1) {"
+        "                map.delete(keys[i]);"
+        "                set.delete(keys[i]);"
+        "            } else if (!(i % 10))"
+        "                survivors.push(keys[i]);"
+        "        }"
+        "        keys = survivors;"
+        "        for (var i = 0; i < keys.length; ++i) {"
+        "            var value = map.get(keys[i]);"
+        "            if (!value || value.key !== keys[i] || !set.has(keys[i]))"
+        "                return false;"
+        "        }"
+        "    }"
+        "    return true;"
+        "})";
+
+    check(functionReturnsTrue(test), "weak map and weak set entries should survive their tables resizing during concurrent GC");
+}
+
+void TestAPI::megamorphicCallSiteLinksThroughDispatchTable()
+{
+    // The call in dispatch() sees more callees than a polymorphic call stub allows, so once it is
+    // compiled it links through a dispatch table keyed by each callee's executable.
+    const unsigned targetCount = 20;
+    auto dispatch = evaluateScript("(function () {"
+        "    var targets = [];"
+        "    for (var i = 0; i < 20; ++i)"
+        "        targets.push(eval('(function dispatchTarget' + i + '(x) { return x * 100 + ' + i + '; })'));"
+        "    function dispatch(f, x) { return f(x); }"
+        "    for (var round = 0; round < 1000; ++round) {"
+        "        for (var i = 0; i < targets.length; ++i) {"
+        "            if (dispatch(targets[i], round) !== round * 100 + i)"
+        "                return null;"
+        "        }"
+        "    }"
+        "    return dispatch;"
+        "})()");
+    if (!check(dispatch && JSValueIsObject(context, dispatch.value()), "a megamorphic call site should call the right targets"))
+        return;
+    if (!JSC::Options::useJIT() || targetCount <= JSC::Options::maxPolymorphicCallVariantListSize() || targetCount > JSC::Options::maxPolymorphicCallDispatchTableSize())
+        return;
+
+#if ENABLE(JIT)
+    JSC::ExecState* exec = context;
+    JSC::VM& vm = exec->vm();
+    JSC::JSLockHolder locker(vm);
+    JSC::JSFunction* function = JSC::jsCast<JSC::JSFunction*>(toJS(exec, dispatch.value()));
+    bool linked = false;
+    for (JSC::CodeBlock* codeBlock = function->jsExecutable()->codeBlockForCall(); codeBlock; codeBlock = codeBlock->alternative()) {
+        for (const JSC::PolymorphicCallDispatchTableStatistics& statistics : codeBlock->callDispatchTableStatistics()) {
+            linked = true;
+            check(statistics.targets.size() == targetCount, "a dispatch table should hold every target");
+            check(statistics.size >= targetCount, "a dispatch table should have a slot for every target");
+            check(statistics.hits > 0, "a dispatch table should count the calls it dispatches");
+            HashSet<String> names;
+            for (JSC::ExecutableBase* target : statistics.targets) {
+                if (auto* functionExecutable = JSC::jsDynamicCast<JSC::FunctionExecutable*>(vm, target))
+                    names.add(functionExecutable->ecmaName().string());
+            }
+            unsigned found = 0;
+            for (unsigned i = 0; i < targetCount; ++i)
+                found += names.contains(makeString("dispatchTarget", i));
+            check(found == targetCount, "a dispatch table should hold exactly the functions called through it");
+        }
+    }
+    check(linked, "a call site with more targets than a polymorphic call stub allows should link through a dispatch table");
+#endif
+}
+
+void TestAPI::sampledTypeProfilingInOptimizingTiers()
+{
+    // The type profiler belongs to a VM, so this test turns it on in a context of its own. The
+    // function gets hot on ints, so the optimizing tiers compile it, and then sees other types,
+    // which the profiler must still record.
+    JSGlobalContextRef profiledContext = JSGlobalContextCreate(nullptr);
+    JSC::ExecState* exec = toJS(profiledContext);
+    JSC::VM& vm = exec->vm();
+    {
+        JSC::JSLockHolder locker(vm);
+        vm.enableTypeProfiler(4);
+    }
+
+    APIString script("(function () {"
+        "    function profiled(x) { var value = x; return value; }"
+        "    for (var i = 0; i < 200000; ++i) {"
+        "        if (profiled(i) !== i)"
+        "            return null;"
+        "    }"
+        "    for (var i = 0; i < 20000; ++i) {"
+        "        var string = 'a' + i;"
+        "        if (profiled(string) !== string || profiled(i + 0.5) !== i + 0.5)"
+        "            return null;"
+        "    }"
+        "    return profiled;"
+        "})()");
+    JSValueRef profiled = JSEvaluateScript(profiledContext, script, nullptr, nullptr, 1, nullptr);
+    if (check(profiled && JSValueIsObject(profiledContext, profiled), "sampled type profiling should not change what the profiled function returns")) {
+        JSC::JSLockHolder locker(vm);
+        vm.typeProfilerLog()->processLogEntries(vm, "testapi: sampledTypeProfilingInOptimizingTiers"_s);
+        JSC::FunctionExecutable* executable = JSC::jsCast<JSC::JSFunction*>(toJS(exec, profiled))->jsExecutable();
+        String source = executable->source().view().toString();
+        unsigned offset = static_cast<unsigned>(source.find("value") + executable->source().startOffset());
+        String types = vm.typeProfiler()->typeInformationForExpressionAtOffset(JSC::TypeProfilerSearchDescriptorNormal, offset, executable->sourceID(), vm);
+        check(types.contains("\"Integer\""), "a sampled type set should have the ints the function got hot on");
+        check(types.contains("\"String\""), "a sampled type set should have the strings seen after the function was optimized");
+        check(types.contains("\"Number\""), "a sampled type set should have the doubles seen after the function was optimized");
+    }
+    JSGlobalContextRelease(profiledContext);
+}
+
+void TestAPI::sharedFunctionCodeBlocksKeepTheirPositions()
+{
+    // Each helper has the same text as the other helpers, so they share an unlinked code block, but
+    // they sit at different lines and columns. The tagged helpers sit at the same offset of two
+    // scripts, which is where a code block with a template object can be shared.
+    auto firstScript = evaluateScript(
+        "var sharedPositionTagged1 = function tagged() { return sharedPositionIdentity`x`; };\n"
+        "function sharedPositionIdentity(strings) { return strings; }\n"
+        "var sharedPositionFirst = (function () {\n"
+        "    function helper() { return new Error().stack.split('\\n')[0]; }\n"
+        "    return helper;\n"
+        "})();\n"
+        "var sharedPositionSecond = (function () {\n"
+        "\n"
+        "      function helper() { return new Error().stack.split('\\n')[0]; }\n"
+        "    return helper;\n"
+        "})();\n");
+    auto secondScript = evaluateScript(
+        "var sharedPositionTagged2 = function tagged() { return sharedPositionIdentity`x`; };\n"
+        "var sharedPositionThird = (function () {\n"
+        "        function helper() { return new Error().stack.split('\\n')[0]; }\n"
+        "    return helper;\n"
+        "})();\n");
+    if (!check(firstScript && secondScript, "scripts with identical helpers should evaluate"))
+        return;
+
+    const char* test = "(function () {"
+        "    function position(frame) {"
+        "        var match = /:(\\d+):(\\d+)$/.exec(frame);"
+        "        return match ? [+match[1], +match[2]] : null;"
+        "    }"
+        "    var first = position(sharedPositionFirst());"
+        "    var second = position(sharedPositionSecond());"
+        "    var third = position(sharedPositionThird());"
+        "    if (!first || !second || !third)"
+        "        return false;"
+        "    if (first[0] !== 4 || second[0] !== 9 || third[0] !== 3)"
+        "        return false;"
+        "    if (second[1] !== first[1] + 2 || third[1] !== first[1] + 4)"
+        "        return false;"
+        "    var helperText = \"function helper() { return new Error().stack.split('\\\\n')[0]; }\";"
+        "    for (var helper of [sharedPositionFirst, sharedPositionSecond, sharedPositionThird]) {"
+        "        if (helper.toString() !== helperText)"
+        "            return false;"
+        "    }"
+        "    var taggedText = 'function tagged() { return sharedPositionIdentity`x`; }';"
+        "    if (sharedPositionTagged1.toString() !== taggedText || sharedPositionTagged2.toString() !== taggedText)"
+        "        return false;"
+        "    var firstTemplate = sharedPositionTagged1();"
+        "    var secondTemplate = sharedPositionTagged2();"
+        "    return firstTemplate[0] === 'x' && secondTemplate[0] === 'x'"
+        "        && firstTemplate === sharedPositionTagged1() && secondTemplate === sharedPositionTagged2()"
+        "        && firstTemplate !== secondTemplate;"
+        "})";
+
+    check(functionReturnsTrue(test), "functions sharing a code block should keep their own source text, stack positions and template objects");
+}
+
+void TestAPI::regExpReplaceAndSplitFollowTheSpec()
+{
+    // Global replace with a string and split find their matches in batches of 64. The references
+    // below walk the matches one exec() at a time, the way the spec does.
+    const char* test = "(function () {"
+        "    function advance(s, index, unicode) {"
+        "        if (!unicode || index + 1 >= s.length)"
+        "            return index + 1;"
+        "        var first = s.charCodeAt(index);"
+        "        var second = s.charCodeAt(index + 1);"
+        "        if (first < 0xD800 || first > 0xDBFF || second < 0xDC00 || second > 0xDFFF)"
+        "            return index + 1;"
+        "        return index + 2;"
+        "    }"
+        "    function specSplit(regExp, s) {"
+        "        var splitter = new RegExp(regExp.source, regExp.flags + 'y');"
+        "        var result = [];"
+        "        if (!s.length)"
+        "            return splitter.exec(s) ? result : [s];"
+        "        var p = 0;"
+        "        var q = 0;"
+        "        while (q < s.length) {"
+        "            splitter.lastIndex = q;"
+        "            var z = splitter.exec(s);"
+        "            if (!z) {"
+        "                q = advance(s, q, regExp.unicode);"
+        "                continue;"
+        "            }"
+        "            var e = Math.min(splitter.lastIndex, s.length);"
+        "            if (e === p) {"
+        "                q = advance(s, q, regExp.unicode);"
+        "                continue;"
+        "            }"
+        "            result.push(s.substring(p, q));"
+        "            for (var i = 1; i < z.length; ++i)"
+        "                result.push(z[i]);"
+        "            p = e;"
+        "            q = p;"
+        "        }"
+        "        result.push(s.substring(p));"
+        "        return result;"
+        "    }"
+        "    function specReplace(regExp, s) {"
+        "        regExp.lastIndex = 0;"
+        "        var result = '';"
+        "        var last = 0;"
+        "        var match;"
+        "        var lastMatch = null;"
+        "        while ((match = regExp.exec(s))) {"
+        "            if (!match[0].length)"
+        "                regExp.lastIndex = advance(s, regExp.lastIndex, regExp.unicode);"
+        "            result += s.substring(last, match.index) + '<' + match[0] + '|' + (match[1] === undefined ? '' : match[1]) + '>';"
+        "            last = match.index + match[0].length;"
+        "            lastMatch = match;"
+        "        }"
+        "        return [result + s.substring(last), lastMatch];"
+        "    }"
+        "    var strings = ['', 'abc', 'a,b,,c,', 'abab,ba', '\\u{1F600}\\u{1F601}a\\uD83D', 'a1'.repeat(100), 'xax'.repeat(50), 'ab a ab '.repeat(40), '\\u{1F600}'.repeat(70)];"
+        "    var splitters = [/(?:)/, /,*/, /(b)?/, /(?:)/u, /(\\d)/, /x*/, /(?=a)/, /\\b/, /(?:)|\\uDE00/u];"
+        "    for (var splitter of splitters) {"
+        "        for (var s of strings) {"
+        "            var expected = specSplit(splitter, s);"
+        "            var actual = s.split(splitter);"
+        "            if (actual.length !== expected.length)"
+        "                return false;"
+        "            for (var i = 0; i < expected.length; ++i) {"
+        "                if (actual[i] !== expected[i])"
+        "                    return false;"
+        "            }"
+        "        }"
+        "    }"
+        "    var replacers = [/(x)?/g, /a(b)?/g, /()/g, /()/gu, /(.)/gu, /(\\d+)|(?:)/g, /(b*)/g, /(\\uDE00)?/gu];"
+        "    for (var replacer of replacers) {"
+        "        for (var s of strings) {"
+        "            var [expected, lastMatch] = specReplace(replacer, s);"
+        "            if (s.replace(replacer, '<$&|$1>') !== expected)"
+        "                return false;"
+        "            if (lastMatch && (RegExp.lastMatch !== lastMatch[0] || RegExp.$1 !== (lastMatch[1] === undefined ? '' : lastMatch[1])))"
+        "                return false;"
+        "        }"
+        "    }"
+        "    return true;"
+        "})";
+
+    check(functionReturnsTrue(test), "global replace and split should visit the matches the spec visits and leave the last one in RegExp.lastMatch");
+}
+
 #define RUN(test) do {                                 \
         if (!shouldRun(#test))                         \
             break;                                     \
@@ -521,6 +996,16 @@ int testCAPIViaCpp(const char* filter)
     RUN(symbolsDeletePropertyForKey());
     RUN(promiseResolveTrue());
     RUN(promiseRejectTrue());
+    RUN(awaitAndThenJobOrdering());
+    RUN(numberFormatASCIIFastPathMatchesICU());
+    RUN(searchLargeRopesWithoutResolving());
+    RUN(sunkAllocationQueriesAcrossOSRExit());
+    RUN(spreadOfExistingArrayAcrossOSRExit());
+    RUN(weakMapResizingDuringConcurrentGC());
+    RUN(megamorphicCallSiteLinksThroughDispatchTable());
+    RUN(sampledTypeProfilingInOptimizingTiers());
+    RUN(sharedFunctionCodeBlocksKeepTheirPositions());
+    RUN(regExpReplaceAndSplitFollowTheSpec());
 
     if (tasks.isEmpty()) {
         dataLogLn("Filtered all tests: ERROR");
@@ -655,6 +655,7 @@ public:
 #else
             masm->m_assembler.linkJump(m_label, masm->m_assembler.label());
 #endif
+            masm->didLinkJump(m_label, masm->m_assembler.label());
         }
         
         void linkTo(Label label, AbstractMacroAssemblerType* masm) const
@@ -675,6 +676,7 @@ public:
 #else
             masm->m_assembler.linkJump(m_label, label.m_label);
 #endif
+            masm->didLinkJump(m_label, label.m_label);
         }
 
         bool isSet() const { return m_label.isSet(); }
@@ -958,6 +960,18 @@ public:
         m_linkTasks.append(createSharedTask<void(LinkBuffer&)>(functor));
     }
 
+    // Code emitted from here on may be linked into different memory than the code before it (see
+    // LinkBuffer). Jumps that this assembler links across the boundary afterwards are remembered,
+    // since their displacements have to be recomputed once both parts have an address.
+    void setColdCodeStart(Label label)
+    {
+        ASSERT(!m_coldCodeStart.isSet());
+        ASSERT(label.m_label.m_offset == m_assembler.codeSize());
+        m_coldCodeStart = label;
+    }
+
+    Label coldCodeStart() const { return m_coldCodeStart; }
+
     void emitNops(size_t memoryToFillWithNopsInBytes)
     {
 #if CPU(ARM64)
@@ -1085,6 +1099,16 @@ protected:
         m_tempRegistersValidBits |= registerMask;
     }
 
+    void didLinkJump(AssemblerLabel from, AssemblerLabel to)
+    {
+        if (LIKELY(!m_coldCodeStart.isSet()))
+            return;
+        // A jump's label is the end of the jump, so a jump that ends right at the boundary is still hot.
+        uint32_t coldOffset = m_coldCodeStart.m_label.m_offset;
+        if ((from.m_offset > coldOffset) != (to.m_offset >= coldOffset))
+            m_jumpsAcrossColdCodeStart.append({ from, to });
+    }
+
     friend class AllowMacroScratchRegisterUsage;
     friend class AllowMacroScratchRegisterUsageIf;
     friend class DisallowMacroScratchRegisterUsage;
@@ -1093,6 +1117,9 @@ protected:
 
     Vector<RefPtr<SharedTask<void(LinkBuffer&)>>> m_linkTasks;
 
+    Label m_coldCodeStart;
+    Vector<std::pair<AssemblerLabel, AssemblerLabel>> m_jumpsAcrossColdCodeStart;
+
     friend class LinkBuffer;
 }; // class AbstractMacroAssembler
 
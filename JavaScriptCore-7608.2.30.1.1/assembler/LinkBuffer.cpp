@@ -86,19 +86,35 @@ LinkBuffer::CodeRef<LinkBufferPtrTag> LinkBuffer::finalizeCodeWithDisassemblyImp
     va_end(argList);
     out.printf(":\n");
 
+    size_t hotSize = m_coldCode ? m_coldCodeOffset : m_size;
     uint8_t* executableAddress = result.code().untaggedExecutableAddress<uint8_t*>();
-    out.printf("    Code at [%p, %p):\n", executableAddress, executableAddress + result.size());
+    out.printf("    Code at [%p, %p):\n", executableAddress, executableAddress + hotSize);
     
     CString header = out.toCString();
+
+    CString coldHeader;
+    if (m_coldCode) {
+        uint8_t* coldExecutableAddress = m_coldCode.untaggedExecutableAddress<uint8_t*>();
+        coldHeader = toCString("    Cold code at [", RawPointer(coldExecutableAddress), ", ", RawPointer(coldExecutableAddress + m_size - m_coldCodeOffset), "):\n");
+    }
     
     if (Options::asyncDisassembly()) {
         CodeRef<DisassemblyPtrTag> codeRefForDisassembly = result.retagged<DisassemblyPtrTag>();
-        disassembleAsynchronously(header, WTFMove(codeRefForDisassembly), m_size, "    ");
+        disassembleAsynchronously(header, WTFMove(codeRefForDisassembly), hotSize, "    ");
+        if (m_coldCode) {
+            // The cold part doesn't start where its memory does, so this ref can't own it. The code's
+            // owner keeps it alive along with the hot part.
+            disassembleAsynchronously(coldHeader, CodeRef<DisassemblyPtrTag>::createSelfManagedCodeRef(m_coldCode.retagged<DisassemblyPtrTag>()), m_size - m_coldCodeOffset, "    ");
+        }
         return result;
     }
     
     dataLog(header);
-    disassemble(result.retaggedCode<DisassemblyPtrTag>(), m_size, "    ", WTF::dataFile());
+    disassemble(result.retaggedCode<DisassemblyPtrTag>(), hotSize, "    ", WTF::dataFile());
+    if (m_coldCode) {
+        dataLog(coldHeader);
+        disassemble(m_coldCode.retagged<DisassemblyPtrTag>(), m_size - m_coldCodeOffset, "    ", WTF::dataFile());
+    }
     
     return result;
 }
@@ -294,7 +310,20 @@ void LinkBuffer::linkCode(MacroAssembler& macroAssembler, void* ownerUID, JITCom
 #if CPU(ARM64)
     RELEASE_ASSERT(roundUpToMultipleOf<Assembler::instructionSize>(code) == code);
 #endif
-    performJITMemcpy(code, buffer.data(), buffer.codeSize());
+    if (m_coldCode) {
+        performJITMemcpy(code, buffer.data(), m_coldCodeOffset);
+        performJITMemcpy(m_coldCode.dataLocation(), static_cast<char*>(buffer.data()) + m_coldCodeOffset, buffer.codeSize() - m_coldCodeOffset);
+
+        // The assembler linked these relative to the buffer, as if the two parts stayed together.
+        for (auto& jump : macroAssembler.m_jumpsAcrossColdCodeStart) {
+            AssemblerLabel from = jump.first;
+            AssemblerLabel to = jump.second;
+            void* fromCode = codeForEndOf(from);
+            void* toCode = codeFor(to);
+            MacroAssembler::AssemblerType_T::linkJump(fromCode, from, static_cast<char*>(toCode) + to.m_offset);
+        }
+    } else
+        performJITMemcpy(code, buffer.data(), buffer.codeSize());
 #if CPU(MIPS)
     macroAssembler.m_assembler.relocateJumps(buffer.data(), code);
 #endif
@@ -325,7 +354,10 @@ void LinkBuffer::allocate(MacroAssembler& macroAssembler, void* ownerUID, JITCom
         initialSize = macroAssembler.m_assembler.codeSize();
     }
 
-    m_executableMemory = ExecutableAllocator::singleton().allocate(initialSize, ownerUID, effort);
+    if (allocateWithColdCode(macroAssembler, ownerUID))
+        return;
+
+    m_executableMemory = ExecutableAllocator::singleton().allocate(initialSize, ownerUID, effort, m_placement);
     if (!m_executableMemory)
         return;
     m_code = MacroAssemblerCodePtr<LinkBufferPtrTag>(m_executableMemory->start().retaggedPtr<LinkBufferPtrTag>());
@@ -333,6 +365,54 @@ void LinkBuffer::allocate(MacroAssembler& macroAssembler, void* ownerUID, JITCom
     m_didAllocate = true;
 }
 
+bool LinkBuffer::allocateWithColdCode(MacroAssembler& macroAssembler, void* ownerUID)
+{
+    // Jumps between the parts are relinked after copying, which needs an assembler that links
+    // jumps in place, with displacements wide enough to reach anywhere in the pool.
+#if CPU(X86_64) && !ENABLE(BRANCH_COMPACTION)
+    if (!macroAssembler.m_coldCodeStart.isSet())
+        return false;
+
+    // The perf JIT dump describes each piece of code as one range.
+    if (Options::logJITCodeForPerf())
+        return false;
+
+    size_t size = macroAssembler.m_assembler.codeSize();
+    uint32_t coldCodeOffset = macroAssembler.m_coldCodeStart.m_label.m_offset;
+    if (!coldCodeOffset || coldCodeOffset >= size)
+        return false;
+
+    ExecutableAllocator& allocator = ExecutableAllocator::singleton();
+    RefPtr<ExecutableMemoryHandle> hotMemory = allocator.allocate(coldCodeOffset, ownerUID, JITCompilationCanFail, m_placement);
+    if (!hotMemory)
+        return false;
+    // The cold part starts as far into its memory as it was into a granule, so that anything the
+    // assembler aligned is still aligned.
+    size_t coldCodeSkew = coldCodeOffset % jitAllocationGranule;
+    RefPtr<ExecutableMemoryHandle> coldMemory = allocator.allocate(coldCodeSkew + size - coldCodeOffset, ownerUID, JITCompilationCanFail, ExecutableMemoryPlacement::Cold);
+    if (!coldMemory)
+        return false;
+
+    uint8_t* lowest = std::min(hotMemory->start().untaggedPtr<uint8_t*>(), coldMemory->start().untaggedPtr<uint8_t*>());
+    uint8_t* highest = std::max(hotMemory->end().untaggedPtr<uint8_t*>(), coldMemory->end().untaggedPtr<uint8_t*>());
+    if (static_cast<size_t>(highest - lowest) > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        return false;
+
+    m_executableMemory = WTFMove(hotMemory);
+    m_coldExecutableMemory = WTFMove(coldMemory);
+    m_code = MacroAssemblerCodePtr<LinkBufferPtrTag>(m_executableMemory->start().retaggedPtr<LinkBufferPtrTag>());
+    m_coldCode = MacroAssemblerCodePtr<LinkBufferPtrTag>(tagCodePtr<LinkBufferPtrTag>(m_coldExecutableMemory->start().untaggedPtr<uint8_t*>() + coldCodeSkew));
+    m_coldCodeOffset = coldCodeOffset;
+    m_size = size;
+    m_didAllocate = true;
+    return true;
+#else
+    UNUSED_PARAM(macroAssembler);
+    UNUSED_PARAM(ownerUID);
+    return false;
+#endif
+}
+
 void LinkBuffer::performFinalization()
 {
     for (auto& task : m_linkTasks)
@@ -345,6 +425,11 @@ void LinkBuffer::performFinalization()
     m_completed = true;
 #endif
     
+    if (m_coldCode) {
+        MacroAssembler::cacheFlush(code(), m_coldCodeOffset);
+        MacroAssembler::cacheFlush(m_coldCode.dataLocation(), m_size - m_coldCodeOffset);
+        return;
+    }
     MacroAssembler::cacheFlush(code(), m_size);
 }
 
@@ -59,6 +59,10 @@ class CodeBlock;
 //   * The address of a Label pointing into the code may be resolved.
 //   * The value referenced by a DataLabel may be set.
 //
+// If the macro assembler has a cold code start, the code from there on is linked into cold
+// executable memory, apart from the code before it. Labels are resolved to whichever part they
+// ended up in.
+//
 class LinkBuffer {
     WTF_MAKE_NONCOPYABLE(LinkBuffer); WTF_MAKE_FAST_ALLOCATED;
     
@@ -79,8 +83,9 @@ class LinkBuffer {
 #endif
 
 public:
-    LinkBuffer(MacroAssembler& macroAssembler, void* ownerUID, JITCompilationEffort effort = JITCompilationMustSucceed)
+    LinkBuffer(MacroAssembler& macroAssembler, void* ownerUID, JITCompilationEffort effort = JITCompilationMustSucceed, ExecutableMemoryPlacement placement = ExecutableMemoryPlacement::Hot)
         : m_size(0)
+        , m_placement(placement)
         , m_didAllocate(false)
 #ifndef NDEBUG
         , m_completed(false)
@@ -134,7 +139,8 @@ public:
     {
         ASSERT(call.isFlagSet(Call::Linkable));
         call.m_label = applyOffset(call.m_label);
-        MacroAssembler::linkCall(code(), call, function);
+        void* codeBase = codeForEndOf(call.m_label);
+        MacroAssembler::linkCall(codeBase, call, function);
     }
     
     template<PtrTag tag>
@@ -147,7 +153,8 @@ public:
     void link(Jump jump, CodeLocationLabel<tag> label)
     {
         jump.m_label = applyOffset(jump.m_label);
-        MacroAssembler::linkJump(code(), jump, label);
+        void* codeBase = codeForEndOf(jump.m_label);
+        MacroAssembler::linkJump(codeBase, jump, label);
     }
 
     template<PtrTag tag>
@@ -160,14 +167,16 @@ public:
     void patch(DataLabelPtr label, void* value)
     {
         AssemblerLabel target = applyOffset(label.m_label);
-        MacroAssembler::linkPointer(code(), target, value);
+        void* codeBase = codeForEndOf(target);
+        MacroAssembler::linkPointer(codeBase, target, value);
     }
 
     template<PtrTag tag>
     void patch(DataLabelPtr label, CodeLocationLabel<tag> value)
     {
         AssemblerLabel target = applyOffset(label.m_label);
-        MacroAssembler::linkPointer(code(), target, value);
+        void* codeBase = codeForEndOf(target);
+        MacroAssembler::linkPointer(codeBase, target, value);
     }
 
     // These methods are used to obtain handles to allow the code to be relinked / repatched later.
@@ -183,7 +192,9 @@ public:
     {
         ASSERT(call.isFlagSet(Call::Linkable));
         ASSERT(!call.isFlagSet(Call::Near));
-        return CodeLocationCall<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(call.m_label)));
+        AssemblerLabel label = applyOffset(call.m_label);
+        void* codeBase = codeForEndOf(label);
+        return CodeLocationCall<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, label));
     }
 
     template<PtrTag tag>
@@ -191,44 +202,58 @@ public:
     {
         ASSERT(call.isFlagSet(Call::Linkable));
         ASSERT(call.isFlagSet(Call::Near));
-        return CodeLocationNearCall<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(call.m_label)),
+        AssemblerLabel label = applyOffset(call.m_label);
+        void* codeBase = codeForEndOf(label);
+        return CodeLocationNearCall<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, label),
             call.isFlagSet(Call::Tail) ? NearCallMode::Tail : NearCallMode::Regular);
     }
 
     template<PtrTag tag>
     CodeLocationLabel<tag> locationOf(PatchableJump jump)
     {
-        return CodeLocationLabel<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(jump.m_jump.m_label)));
+        AssemblerLabel label = applyOffset(jump.m_jump.m_label);
+        void* codeBase = codeForEndOf(label);
+        return CodeLocationLabel<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, label));
     }
 
     template<PtrTag tag>
     CodeLocationLabel<tag> locationOf(Label label)
     {
-        return CodeLocationLabel<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(label.m_label)));
+        AssemblerLabel target = applyOffset(label.m_label);
+        void* codeBase = codeFor(target);
+        return CodeLocationLabel<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, target));
     }
 
     template<PtrTag tag>
     CodeLocationDataLabelPtr<tag> locationOf(DataLabelPtr label)
     {
-        return CodeLocationDataLabelPtr<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(label.m_label)));
+        AssemblerLabel target = applyOffset(label.m_label);
+        void* codeBase = codeForEndOf(target);
+        return CodeLocationDataLabelPtr<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, target));
     }
 
     template<PtrTag tag>
     CodeLocationDataLabel32<tag> locationOf(DataLabel32 label)
     {
-        return CodeLocationDataLabel32<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(label.m_label)));
+        AssemblerLabel target = applyOffset(label.m_label);
+        void* codeBase = codeForEndOf(target);
+        return CodeLocationDataLabel32<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, target));
     }
     
     template<PtrTag tag>
     CodeLocationDataLabelCompact<tag> locationOf(DataLabelCompact label)
     {
-        return CodeLocationDataLabelCompact<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(label.m_label)));
+        AssemblerLabel target = applyOffset(label.m_label);
+        void* codeBase = codeForEndOf(target);
+        return CodeLocationDataLabelCompact<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, target));
     }
 
     template<PtrTag tag>
     CodeLocationConvertibleLoad<tag> locationOf(ConvertibleLoadLabel label)
     {
-        return CodeLocationConvertibleLoad<tag>(MacroAssembler::getLinkerAddress<tag>(code(), applyOffset(label.m_label)));
+        AssemblerLabel target = applyOffset(label.m_label);
+        void* codeBase = codeFor(target);
+        return CodeLocationConvertibleLoad<tag>(MacroAssembler::getLinkerAddress<tag>(codeBase, target));
     }
 
     // This method obtains the return address of the call, given as an offset from
@@ -236,16 +261,19 @@ public:
     unsigned returnAddressOffset(Call call)
     {
         call.m_label = applyOffset(call.m_label);
+        ASSERT(call.m_label.m_offset <= m_coldCodeOffset);
         return MacroAssembler::getLinkerCallReturnOffset(call);
     }
 
     uint32_t offsetOf(Label label)
     {
+        ASSERT(applyOffset(label.m_label).m_offset < m_coldCodeOffset);
         return applyOffset(label.m_label).m_offset;
     }
 
     unsigned offsetOf(PatchableJump jump)
     {
+        ASSERT(applyOffset(jump.m_jump.m_label).m_offset <= m_coldCodeOffset);
         return applyOffset(jump.m_jump.m_label).m_offset;
     }
 
@@ -273,7 +301,9 @@ public:
     template<PtrTag tag>
     CodePtr<tag> trampolineAt(Label label)
     {
-        return CodePtr<tag>(MacroAssembler::AssemblerType_T::getRelocatedAddress(code(), applyOffset(label.m_label)));
+        AssemblerLabel target = applyOffset(label.m_label);
+        void* codeBase = codeFor(target);
+        return CodePtr<tag>(MacroAssembler::AssemblerType_T::getRelocatedAddress(codeBase, target));
     }
 
     void* debugAddress()
@@ -282,6 +312,10 @@ public:
     }
 
     size_t size() const { return m_size; }
+
+    // Set if part of the code was linked into cold memory. The CodeRef from finalizeCode() only
+    // owns the hot part, so whoever keeps the code alive has to keep this too.
+    RefPtr<ExecutableMemoryHandle> coldExecutableMemory() const { return m_coldExecutableMemory; }
     
     bool wasAlreadyDisassembled() const { return m_alreadyDisassembled; }
     void didAlreadyDisassemble() { m_alreadyDisassembled = true; }
@@ -316,8 +350,28 @@ private:
     {
         return m_code.dataLocation();
     }
+
+    // These rebase a label onto the part of the code it was linked into, and return that part. A
+    // label that marks the start of something belongs to the cold part if it is at the boundary;
+    // one that marks the end of an instruction, like a jump's or a call's, still belongs to the hot part.
+    void* codeFor(AssemblerLabel& label)
+    {
+        if (label.m_offset < m_coldCodeOffset)
+            return code();
+        label.m_offset -= m_coldCodeOffset;
+        return m_coldCode.dataLocation();
+    }
+
+    void* codeForEndOf(AssemblerLabel& label)
+    {
+        if (label.m_offset <= m_coldCodeOffset)
+            return code();
+        label.m_offset -= m_coldCodeOffset;
+        return m_coldCode.dataLocation();
+    }
     
     void allocate(MacroAssembler&, void* ownerUID, JITCompilationEffort);
+    bool allocateWithColdCode(MacroAssembler&, void* ownerUID);
 
     JS_EXPORT_PRIVATE void linkCode(MacroAssembler&, void* ownerUID, JITCompilationEffort);
 #if ENABLE(BRANCH_COMPACTION)
@@ -336,7 +390,10 @@ private:
 #endif
     
     RefPtr<ExecutableMemoryHandle> m_executableMemory;
+    RefPtr<ExecutableMemoryHandle> m_coldExecutableMemory;
     size_t m_size;
+    ExecutableMemoryPlacement m_placement { ExecutableMemoryPlacement::Hot };
+    uint32_t m_coldCodeOffset { std::numeric_limits<uint32_t>::max() };
 #if ENABLE(BRANCH_COMPACTION)
     AssemblerData m_assemblerStorage;
     bool m_shouldPerformBranchCompaction { true };
@@ -347,6 +404,7 @@ private:
 #endif
     bool m_alreadyDisassembled { false };
     MacroAssemblerCodePtr<LinkBufferPtrTag> m_code;
+    MacroAssemblerCodePtr<LinkBufferPtrTag> m_coldCode;
     Vector<RefPtr<SharedTask<void(LinkBuffer&)>>> m_linkTasks;
 };
 
@@ -27,6 +27,7 @@
 
 #include "CCallHelpers.h"
 #include "CPU.h"
+#include "ExecutableAllocator.h"
 #include "FPRInfo.h"
 #include "GPRInfo.h"
 #include "InitializeThreading.h"
@@ -1081,6 +1082,76 @@ static void testCagePreservesPACFailureBit()
 #endif
 }
 
+// Everything that touches the cold region is in one test: isValidExecutableMemory() gives up on
+// that region while anyone else holds its lock.
+static void testExecutableMemoryRegions()
+{
+    ExecutableAllocator& allocator = ExecutableAllocator::singleton();
+
+    RefPtr<ExecutableMemoryHandle> cold = allocator.allocate(jitAllocationGranule, nullptr, JITCompilationCanFail, ExecutableMemoryPlacement::Cold);
+    CHECK_EQ(!!cold, true);
+    char* coldAddress = cold->start().untaggedPtr<char*>();
+    CHECK_EQ(allocator.placementOf(coldAddress) == ExecutableMemoryPlacement::Cold, true);
+    {
+        auto locker = holdLock(allocator.getLock());
+        CHECK_EQ(allocator.isValidExecutableMemory(locker, coldAddress), true);
+        CHECK_EQ(allocator.isValidExecutableMemory(locker, coldAddress + jitAllocationGranule - 1), true);
+    }
+
+    // Code after the cold code start is linked into the cold region, and jumps between the two parts
+    // still land.
+    CCallHelpers jit;
+    jit.emitFunctionPrologue();
+    jit.move(CCallHelpers::TrustedImm32(0), GPRInfo::returnValueGPR);
+    CCallHelpers::Jump toColdCode = jit.jump();
+    CCallHelpers::Label backInHotCode = jit.label();
+    jit.add32(CCallHelpers::TrustedImm32(2), GPRInfo::returnValueGPR);
+    jit.emitFunctionEpilogue();
+    jit.ret();
+    jit.setColdCodeStart(jit.label());
+    toColdCode.link(&jit);
+    CCallHelpers::Label coldCode = jit.label();
+    jit.add32(CCallHelpers::TrustedImm32(40), GPRInfo::returnValueGPR);
+    jit.jump().linkTo(backInHotCode, &jit);
+
+    LinkBuffer linkBuffer(jit, nullptr);
+    RefPtr<ExecutableMemoryHandle> coldCodeMemory = linkBuffer.coldExecutableMemory();
+    CHECK_EQ(!!coldCodeMemory, isX86_64());
+    char* coldCodeAddress = linkBuffer.locationOf<NoPtrTag>(coldCode).dataLocation<char*>();
+    MacroAssemblerCodeRef<JSEntryPtrTag> code = FINALIZE_CODE(linkBuffer, JSEntryPtrTag, "testmasm cold code");
+    CHECK_EQ(invoke<int>(code), 42);
+    if (coldCodeMemory) {
+        CHECK_EQ(coldCodeMemory->start().untaggedPtr<char*>() <= coldCodeAddress, true);
+        CHECK_EQ(coldCodeAddress < coldCodeMemory->end().untaggedPtr<char*>(), true);
+        CHECK_EQ(allocator.placementOf(coldCodeAddress) == ExecutableMemoryPlacement::Cold, true);
+        auto locker = holdLock(allocator.getLock());
+        CHECK_EQ(allocator.isValidExecutableMemory(locker, coldCodeAddress), true);
+    }
+
+    // Once the cold region is full, cold allocations come from the hot region.
+    Vector<RefPtr<ExecutableMemoryHandle>> coldRegionFiller;
+    RefPtr<ExecutableMemoryHandle> fallback;
+    for (;;) {
+        RefPtr<ExecutableMemoryHandle> handle = allocator.allocate(1 * MB, nullptr, JITCompilationCanFail, ExecutableMemoryPlacement::Cold);
+        CHECK_EQ(!!handle, true);
+        if (allocator.placementOf(handle->start().untaggedPtr()) == ExecutableMemoryPlacement::Hot) {
+            fallback = WTFMove(handle);
+            break;
+        }
+        coldRegionFiller.append(WTFMove(handle));
+    }
+    {
+        auto locker = holdLock(allocator.getLock());
+        CHECK_EQ(allocator.isValidExecutableMemory(locker, fallback->start().untaggedPtr()), true);
+    }
+
+    // Freeing cold memory makes it available again.
+    coldRegionFiller.clear();
+    RefPtr<ExecutableMemoryHandle> coldAgain = allocator.allocate(1 * MB, nullptr, JITCompilationCanFail, ExecutableMemoryPlacement::Cold);
+    CHECK_EQ(!!coldAgain, true);
+    CHECK_EQ(allocator.placementOf(coldAgain->start().untaggedPtr()) == ExecutableMemoryPlacement::Cold, true);
+}
+
 #define RUN(test) do {                          \
         if (!shouldRun(#test))                  \
             break;                              \
@@ -1172,6 +1243,8 @@ void run(const char* filter)
 
     RUN(testCagePreservesPACFailureBit());
 
+    RUN(testExecutableMemoryRegions());
+
     if (tasks.isEmpty())
         usage();
 
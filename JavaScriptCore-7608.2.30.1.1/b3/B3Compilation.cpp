@@ -33,15 +33,17 @@
 
 namespace JSC { namespace B3 {
 
-Compilation::Compilation(MacroAssemblerCodeRef<B3CompilationPtrTag> codeRef, std::unique_ptr<OpaqueByproducts> byproducts)
+Compilation::Compilation(MacroAssemblerCodeRef<B3CompilationPtrTag> codeRef, std::unique_ptr<OpaqueByproducts> byproducts, RefPtr<ExecutableMemoryHandle> coldCode)
     : m_codeRef(codeRef)
     , m_byproducts(WTFMove(byproducts))
+    , m_coldCode(WTFMove(coldCode))
 {
 }
 
 Compilation::Compilation(Compilation&& other)
     : m_codeRef(WTFMove(other.m_codeRef))
     , m_byproducts(WTFMove(other.m_byproducts))
+    , m_coldCode(WTFMove(other.m_coldCode))
 {
 }
 
@@ -48,18 +48,22 @@ class Compilation {
     WTF_MAKE_FAST_ALLOCATED;
 
 public:
-    JS_EXPORT_PRIVATE Compilation(MacroAssemblerCodeRef<B3CompilationPtrTag>, std::unique_ptr<OpaqueByproducts>);
+    JS_EXPORT_PRIVATE Compilation(MacroAssemblerCodeRef<B3CompilationPtrTag>, std::unique_ptr<OpaqueByproducts>, RefPtr<ExecutableMemoryHandle> coldCode = nullptr);
     JS_EXPORT_PRIVATE Compilation(Compilation&&);
     JS_EXPORT_PRIVATE ~Compilation();
 
     MacroAssemblerCodePtr<B3CompilationPtrTag> code() const { return m_codeRef.code(); }
     MacroAssemblerCodeRef<B3CompilationPtrTag> codeRef() const { return m_codeRef; }
+
+    // Set if the procedure separated its rare code, and it got linked into cold memory.
+    ExecutableMemoryHandle* coldCode() const { return m_coldCode.get(); }
     
     CString disassembly() const { return m_codeRef.disassembly(); }
 
 private:
     MacroAssemblerCodeRef<B3CompilationPtrTag> m_codeRef;
     std::unique_ptr<OpaqueByproducts> m_byproducts;
+    RefPtr<ExecutableMemoryHandle> m_coldCode;
 };
 
 } } // namespace JSC::B3
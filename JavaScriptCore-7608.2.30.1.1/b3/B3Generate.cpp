@@ -50,6 +50,7 @@
 #include "B3ReduceDoubleToFloat.h"
 #include "B3ReduceStrength.h"
 #include "B3TimingScope.h"
+#include "B3UnrollLoops.h"
 #include "B3Validate.h"
 #include "PCToCodeOriginMap.h"
 
@@ -91,6 +92,8 @@ void generateToAir(Procedure& procedure)
             eliminateCommonSubexpressions(procedure);
         eliminateDeadCode(procedure);
         inferSwitches(procedure);
+        if (Options::useB3LoopUnrolling())
+            unrollLoops(procedure);
         if (Options::useB3TailDup())
             duplicateTails(procedure);
         fixSSA(procedure);
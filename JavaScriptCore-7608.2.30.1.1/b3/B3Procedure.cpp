@@ -367,6 +367,16 @@ void Procedure::setOptLevel(unsigned optLevel)
     code().setOptLevel(optLevel);
 }
 
+void Procedure::setSeparatesRareCode(bool value)
+{
+    code().setSeparatesRareCode(value);
+}
+
+bool Procedure::separatesRareCode() const
+{
+    return code().separatesRareCode();
+}
+
 unsigned Procedure::frameSize() const
 {
     return code().frameSize();
@@ -405,6 +415,13 @@ void Procedure::setBlockOrderImpl(Vector<BasicBlock*>& blocks)
     }
 }
 
+void Procedure::addRemarkImpl(CString&& message)
+{
+    if (Options::logB3Remarks())
+        dataLog("B3 remark in ", m_lastPhaseName, ": ", message, "\n");
+    m_remarks.append(Remark { m_lastPhaseName, WTFMove(message) });
+}
+
 void Procedure::setWasmBoundsCheckGenerator(RefPtr<WasmBoundsCheckGenerator> generator)
 {
     code().setWasmBoundsCheckGenerator(generator);
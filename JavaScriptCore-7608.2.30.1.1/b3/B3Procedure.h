@@ -43,6 +43,7 @@
 #include <wtf/Noncopyable.h>
 #include <wtf/PrintStream.h>
 #include <wtf/SharedTask.h>
+#include <wtf/StringPrintStream.h>
 #include <wtf/TriState.h>
 #include <wtf/Vector.h>
 
@@ -201,6 +202,22 @@ public:
 
     const char* lastPhaseName() const { return m_lastPhaseName; }
 
+    // Phases that make a judgement call, like whether to unroll a loop, record what they decided and
+    // why as a remark, tagged with the phase that is running. Remarks are also logged as they are
+    // added if Options::logB3Remarks() is set.
+    struct Remark {
+        const char* phase;
+        CString message;
+    };
+
+    template<typename... Arguments>
+    void addRemark(const Arguments&... arguments)
+    {
+        addRemarkImpl(toCString(arguments...));
+    }
+
+    const Vector<Remark>& remarks() const { return m_remarks; }
+
     // Allocates a slab of memory that will be kept alive by anyone who keeps the resulting code
     // alive. Great for compiler-generated data sections, like switch jump tables and constant pools.
     // This returns memory that has been zero-initialized.
@@ -248,6 +265,14 @@ public:
     void setNeedsUsedRegisters(bool value) { m_needsUsedRegisters = value; }
     bool needsUsedRegisters() const { return m_needsUsedRegisters; }
 
+    // If you turn this on, blocks only reached through rare edges and the late paths of checks and
+    // patchpoints are generated after all other code, and the CCallHelpers passed to generate() gets
+    // a cold code start. LinkBuffer then links that tail into cold executable memory, and you have to
+    // keep LinkBuffer::coldExecutableMemory() alive along with the code. Labels still resolve as usual,
+    // but code from the two parts isn't contiguous, so don't take the distance between them.
+    JS_EXPORT_PRIVATE void setSeparatesRareCode(bool);
+    JS_EXPORT_PRIVATE bool separatesRareCode() const;
+
     JS_EXPORT_PRIVATE unsigned frameSize() const;
     JS_EXPORT_PRIVATE RegisterAtOffsetList calleeSaveRegisterAtOffsetList() const;
 
@@ -270,6 +295,7 @@ private:
 
     JS_EXPORT_PRIVATE Value* addValueImpl(Value*);
     void setBlockOrderImpl(Vector<BasicBlock*>&);
+    JS_EXPORT_PRIVATE void addRemarkImpl(CString&&);
 
     SparseCollection<StackSlot> m_stackSlots;
     SparseCollection<Variable> m_variables;
@@ -283,6 +309,7 @@ private:
     HashSet<ValueKey> m_fastConstants;
     unsigned m_numEntrypoints { 1 };
     const char* m_lastPhaseName;
+    Vector<Remark> m_remarks;
     std::unique_ptr<OpaqueByproducts> m_byproducts;
     std::unique_ptr<Air::Code> m_code;
     RefPtr<SharedTask<void(PrintStream&, Origin)>> m_originPrinter;
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "B3UnrollLoops.h"
+
+#if ENABLE(B3_JIT)
+
+#include "B3BasicBlockInlines.h"
+#include "B3FixSSA.h"
+#include "B3MemoryValue.h"
+#include "B3PhaseScope.h"
+#include "B3ProcedureInlines.h"
+#include "B3UpsilonValue.h"
+#include "B3ValueInlines.h"
+#include <wtf/IndexSet.h>
+
+namespace JSC { namespace B3 {
+
+namespace {
+
+// A loop we can unroll looks like this:
+//
+//     PreHeader:
+//         Upsilon(@initial, ^i)
+//         ...
+//     Loop:
+//         i = Phi()
+//         ... unit stride loads and stores indexed by i ...
+//         next = Add(i, 1)
+//         Upsilon(next, ^i)
+//         Branch(LessThan(next, @limit), Loop, Exit)
+//
+// We turn it into:
+//
+//     PreHeader:
+//         Jump(Guard)
+//     Guard:
+//         Branch(LessThan(SExt32(@initial) + factor - 1, SExt32(@limit)), Unrolled, Loop)
+//     Unrolled:
+//         ... factor copies of Loop's body ...
+//         Branch(LessThan(SExt32(next') + factor - 1, SExt32(@limit)), Unrolled, Remainder)
+//     Remainder:
+//         Branch(LessThan(next', @limit), Loop, Exit)
+//
+// The original loop becomes the epilogue that runs the iterations that don't fill a whole trip
+// through Unrolled. The trip checks are done in 64 bits so that they cannot overflow.
+struct Candidate {
+    BasicBlock* loop { nullptr };
+    BasicBlock* preHeader { nullptr };
+    Value* induction { nullptr };
+    Value* initial { nullptr };
+    Value* increment { nullptr };
+    Value* condition { nullptr };
+    Value* limit { nullptr };
+};
+
+class UnrollLoops {
+public:
+    UnrollLoops(Procedure& proc)
+        : m_proc(proc)
+        , m_factor(Options::b3LoopUnrollFactor())
+        , m_maxSize(Options::maxB3LoopUnrollBlockSize())
+    {
+    }
+
+    bool run()
+    {
+        if (m_factor < 2)
+            return false;
+
+        m_proc.resetValueOwners();
+
+        Vector<Candidate> candidates;
+        IndexSet<BasicBlock*> loops;
+        for (BasicBlock* block : m_proc) {
+            Candidate candidate;
+            if (!findCandidate(block, candidate))
+                continue;
+            candidates.append(candidate);
+            loops.add(block);
+        }
+
+        // Unrolling a loop gives each value it defines more than one definition, so the guard
+        // must not use values that come out of another loop we are unrolling.
+        candidates.removeAllMatching(
+            [&] (const Candidate& candidate) -> bool {
+                if (loops.contains(candidate.initial->owner) || loops.contains(candidate.limit->owner)) {
+                    m_proc.addRemark("Not unrolling ", *candidate.loop, ": trip count comes from another unrolled loop");
+                    return true;
+                }
+                return false;
+            });
+        if (candidates.isEmpty())
+            return false;
+
+        IndexSet<BasicBlock*> loopsToUnroll;
+        for (const Candidate& candidate : candidates)
+            loopsToUnroll.add(candidate.loop);
+
+        IndexSet<Value*> valuesToDemote;
+        for (BasicBlock* block : m_proc) {
+            for (Value* value : *block) {
+                if (loopsToUnroll.contains(block)) {
+                    if (value->opcode() == Phi)
+                        valuesToDemote.add(value);
+                    // The Upsilons that feed the exit's Phis get duplicated along with the body.
+                    if (UpsilonValue* upsilon = value->as<UpsilonValue>())
+                        valuesToDemote.add(upsilon->phi());
+                }
+                for (Value* child : value->children()) {
+                    if (child->owner != block && loopsToUnroll.contains(child->owner))
+                        valuesToDemote.add(child);
+                }
+            }
+        }
+        demoteValues(m_proc, valuesToDemote);
+
+        for (const Candidate& candidate : candidates)
+            unroll(candidate);
+
+        m_proc.resetReachability();
+        m_proc.invalidateCFG();
+        return true;
+    }
+
+private:
+    bool reject(BasicBlock* block, const char* reason)
+    {
+        m_proc.addRemark("Not unrolling ", *block, ": ", reason);
+        return false;
+    }
+
+    bool findCandidate(BasicBlock* block, Candidate& candidate)
+    {
+        Value* branch = block->last();
+        if (branch->opcode() != Branch)
+            return false;
+        if (block->successorBlock(0) != block && block->successorBlock(1) != block)
+            return false;
+        if (block->successorBlock(1) == block)
+            return reject(block, "loop does not continue on the taken edge");
+        if (block == m_proc[0])
+            return reject(block, "loop is the root block");
+        if (block->numPredecessors() != 2)
+            return reject(block, "loop has more than one entry");
+
+        BasicBlock* preHeader = block->predecessor(0) == block ? block->predecessor(1) : block->predecessor(0);
+        if (preHeader == block)
+            return reject(block, "loop has no entry");
+
+        Value* condition = branch->child(0);
+        if (condition->opcode() != LessThan || condition->owner != block)
+            return reject(block, "loop is not guarded by a signed less-than");
+
+        Value* increment = condition->child(0);
+        Value* limit = condition->child(1);
+        if (increment->type() != Int32)
+            return reject(block, "induction variable is not Int32");
+        if (limit->owner == block)
+            return reject(block, "limit is not loop invariant");
+        if ((increment->opcode() != Add && increment->opcode() != CheckAdd)
+            || increment->owner != block
+            || !increment->child(1)->isInt32(1))
+            return reject(block, "induction variable does not step by one");
+
+        Value* induction = increment->child(0);
+        if (induction->opcode() != Phi || induction->owner != block)
+            return reject(block, "induction variable is not a Phi of the loop");
+
+        Value* initial = nullptr;
+        for (Value* value : *preHeader) {
+            if (UpsilonValue* upsilon = value->as<UpsilonValue>()) {
+                if (upsilon->phi() == induction)
+                    initial = upsilon->child(0);
+            }
+        }
+        bool backEdgeIsIncrement = false;
+        for (Value* value : *block) {
+            if (UpsilonValue* upsilon = value->as<UpsilonValue>()) {
+                if (upsilon->phi() == induction)
+                    backEdgeIsIncrement = upsilon->child(0) == increment;
+            }
+        }
+        if (!initial || !backEdgeIsIncrement)
+            return reject(block, "induction variable is not updated by its increment");
+
+        if (block->size() > m_maxSize)
+            return reject(block, "loop is too large");
+
+        // Find out how every address in the loop moves from one iteration to the next. We only
+        // bother unrolling loops that walk memory one element at a time. This is only a
+        // profitability heuristic: the transformation is correct for any loop of this shape.
+        HashMap<Value*, int64_t> strides;
+        strides.add(induction, 1);
+        auto strideOf = [&] (Value* value, int64_t& stride) -> bool {
+            if (value->owner != block || value->isConstant()) {
+                stride = 0;
+                return true;
+            }
+            auto iter = strides.find(value);
+            if (iter == strides.end())
+                return false;
+            stride = iter->value;
+            return true;
+        };
+
+        bool sawUnitStrideAccess = false;
+        for (Value* value : *block) {
+            switch (value->opcode()) {
+            case Patchpoint:
+            case CCall:
+                return reject(block, "loop makes calls");
+            case Fence:
+                return reject(block, "loop has a fence");
+            default:
+                break;
+            }
+
+            if (MemoryValue* memory = value->as<MemoryValue>()) {
+                if (memory->isExotic())
+                    return reject(block, "loop has an exotic memory access");
+                int64_t stride;
+                if (!strideOf(memory->lastChild(), stride))
+                    return reject(block, "address is not affine in the induction variable");
+                if (stride && stride != static_cast<int64_t>(memory->accessByteSize()))
+                    return reject(block, "memory access does not have unit stride");
+                if (stride)
+                    sawUnitStrideAccess = true;
+                continue;
+            }
+
+            if (!value->isInteger() || value == induction)
+                continue;
+
+            int64_t left;
+            int64_t right;
+            int64_t stride;
+            switch (value->opcode()) {
+            case Add:
+                if (!strideOf(value->child(0), left) || !strideOf(value->child(1), right))
+                    continue;
+                stride = left + right;
+                break;
+            case Sub:
+                if (!strideOf(value->child(0), left) || !strideOf(value->child(1), right))
+                    continue;
+                stride = left - right;
+                break;
+            case Mul:
+                if (!strideOf(value->child(0), left) || !value->child(1)->hasInt()
+                    || std::abs(value->child(1)->asInt()) > 64)
+                    continue;
+                stride = left * value->child(1)->asInt();
+                break;
+            case Shl:
+                if (!strideOf(value->child(0), left) || !value->child(1)->hasInt32()
+                    || static_cast<uint32_t>(value->child(1)->asInt32()) > 4)
+                    continue;
+                stride = left * (static_cast<int64_t>(1) << value->child(1)->asInt32());
+                break;
+            case ZExt32:
+            case SExt32:
+            case Trunc:
+            case Identity:
+                if (!strideOf(value->child(0), stride))
+                    continue;
+                break;
+            default:
+                continue;
+            }
+            if (std::abs(stride) > 1024)
+                continue;
+            strides.add(value, stride);
+        }
+        if (!sawUnitStrideAccess)
+            return reject(block, "loop has no unit stride memory access");
+
+        m_proc.addRemark("Unrolling ", *block, " by ", m_factor, " with induction variable ", *induction);
+
+        candidate.loop = block;
+        candidate.preHeader = preHeader;
+        candidate.induction = induction;
+        candidate.initial = initial;
+        candidate.increment = increment;
+        candidate.condition = condition;
+        candidate.limit = limit;
+        return true;
+    }
+
+    Value* appendFullTripCheck(BasicBlock* block, Origin origin, Value* index, Value* limit)
+    {
+        Value* lastIndex = block->appendNew<Value>(
+            m_proc, Add, origin,
+            block->appendNew<Value>(m_proc, SExt32, origin, index),
+            block->appendIntConstant(m_proc, origin, Int64, m_factor - 1));
+        return block->appendNew<Value>(
+            m_proc, LessThan, origin, lastIndex,
+            block->appendNew<Value>(m_proc, SExt32, origin, limit));
+    }
+
+    void unroll(const Candidate& candidate)
+    {
+        BasicBlock* loop = candidate.loop;
+        Origin origin = loop->last()->origin();
+
+        BasicBlock* guard = m_proc.addBlock(candidate.preHeader->frequency());
+        BasicBlock* unrolled = m_proc.addBlock(loop->frequency());
+        BasicBlock* remainder = m_proc.addBlock(loop->frequency());
+
+        // The loop state is in variables now, so each copy of the body just picks up where the
+        // previous one left off.
+        HashMap<Value*, Value*> map;
+        for (unsigned copyIndex = 0; copyIndex < m_factor; ++copyIndex) {
+            map.clear();
+            for (unsigned valueIndex = 0; valueIndex + 1 < loop->size(); ++valueIndex) {
+                Value* value = loop->at(valueIndex);
+                if (value->opcode() == Nop)
+                    continue;
+                Value* clone = m_proc.clone(value);
+                for (Value*& child : clone->children()) {
+                    if (Value* replacement = map.get(child))
+                        child = replacement;
+                }
+                if (value->type() != Void)
+                    map.add(value, clone);
+                unrolled->append(clone);
+            }
+        }
+
+        Value* next = map.get(candidate.increment);
+        Value* condition = map.get(candidate.condition);
+        RELEASE_ASSERT(next && condition);
+
+        unrolled->appendNewControlValue(
+            m_proc, Branch, origin, appendFullTripCheck(unrolled, origin, next, candidate.limit),
+            FrequentedBlock(unrolled), FrequentedBlock(remainder));
+        remainder->appendNewControlValue(
+            m_proc, Branch, origin, condition, loop->taken(), loop->notTaken());
+        guard->appendNewControlValue(
+            m_proc, Branch, origin, appendFullTripCheck(guard, origin, candidate.initial, candidate.limit),
+            FrequentedBlock(unrolled), FrequentedBlock(loop));
+
+        candidate.preHeader->replaceSuccessor(loop, guard);
+    }
+
+    Procedure& m_proc;
+    unsigned m_factor;
+    unsigned m_maxSize;
+};
+
+} // anonymous namespace
+
+bool unrollLoops(Procedure& proc)
+{
+    PhaseScope phaseScope(proc, "unrollLoops");
+    UnrollLoops unrollLoops(proc);
+    return unrollLoops.run();
+}
+
+} } // namespace JSC::B3
+
+#endif // ENABLE(B3_JIT)
@@ -72,7 +72,7 @@ typedef Range<size_t> Interval;
 struct TmpData {
     void dump(PrintStream& out) const
     {
-        out.print("{interval = ", interval, ", spilled = ", pointerDump(spilled), ", assigned = ", assigned, ", isUnspillable = ", isUnspillable, ", possibleRegs = ", possibleRegs, ", didBuildPossibleRegs = ", didBuildPossibleRegs, "}");
+        out.print("{interval = ", interval, ", spilled = ", pointerDump(spilled), ", assigned = ", assigned, ", hint = ", hint, ", isUnspillable = ", isUnspillable, ", possibleRegs = ", possibleRegs, ", didBuildPossibleRegs = ", didBuildPossibleRegs, "}");
     }
     
     void validate()
@@ -84,6 +84,7 @@ struct TmpData {
     StackSlot* spilled { nullptr };
     RegisterSet possibleRegs;
     Reg assigned;
+    Tmp hint;
     bool isUnspillable { false };
     bool didBuildPossibleRegs { false };
     unsigned spillIndex { 0 };
@@ -231,6 +232,7 @@ private:
                             return;
                         m_map[tmp].interval |= interval(indexOfEarly, Arg::timing(role));
                     });
+                recordHints(inst);
             }
 
             RegLiveness::LocalCalcForUnifiedTmpLiveness localCalc(liveness, block);
@@ -291,6 +293,41 @@ private:
         }
     }
     
+    // If a tmp is moved to or from some other tmp, then giving both the same register turns the
+    // move into a nop. Prefer hints that are registers, since those come from calling conventions
+    // and other constraints that we cannot do anything about.
+    void recordHints(const Inst& inst)
+    {
+        switch (inst.kind.opcode) {
+        case Move:
+        case MoveDouble:
+            break;
+        default:
+            return;
+        }
+        if (inst.args.size() != 2 || !inst.args[0].isTmp() || !inst.args[1].isTmp())
+            return;
+
+        auto addHint = [&] (Tmp tmp, Tmp hint) {
+            if (tmp.isReg())
+                return;
+            Tmp& currentHint = m_map[tmp].hint;
+            if (!currentHint || (hint.isReg() && !currentHint.isReg()))
+                currentHint = hint;
+        };
+        addHint(inst.args[0].tmp(), inst.args[1].tmp());
+        addHint(inst.args[1].tmp(), inst.args[0].tmp());
+    }
+
+    Reg hintedReg(const TmpData& entry)
+    {
+        if (!entry.hint)
+            return Reg();
+        if (entry.hint.isReg())
+            return entry.hint.reg();
+        return m_map[entry.hint].assigned;
+    }
+
     bool shouldSpillEverything()
     {
         if (!Options::airLinearScanSpillsEverything())
@@ -442,9 +479,14 @@ private:
             if (verbose())
                 dataLog("  Possible regs: ", entry.possibleRegs, "\n");
             
-            // Find a free register that we are allowed to use.
+            // Find a free register that we are allowed to use, starting with the hinted one.
             if (m_active.size() != m_registers[bank].size()) {
                 bool didAssign = false;
+                Reg hint = hintedReg(entry);
+                if (hint && !m_activeRegs.contains(hint) && entry.possibleRegs.contains(hint)) {
+                    assign(tmp, hint);
+                    continue;
+                }
                 for (Reg reg : m_registers[bank]) {
                     // FIXME: Could do priority coloring here.
                     // https://bugs.webkit.org/show_bug.cgi?id=170304
@@ -516,15 +558,30 @@ private:
         m_didSpill = true;
     }
     
+    // Spill tmps normally live for just one instruction. We let a spill tmp stay in its register
+    // into the next instruction if that one uses the same spilled tmp, which splits the spilled
+    // live range into short register-resident pieces around each run of adjacent uses. Patches can
+    // clobber every register, so we never keep spill tmps alive across them.
+    static bool canKeepSpillTmpsAcross(const Inst& inst)
+    {
+        return inst.kind.opcode != Patch;
+    }
+
     void emitSpillCode()
     {
+        HashMap<StackSlot*, Tmp> previousFills;
+        HashMap<StackSlot*, Tmp> currentFills;
         for (BasicBlock* block : m_code) {
             size_t indexOfHead = this->indexOfHead(block);
+            previousFills.clear();
             for (unsigned instIndex = 0; instIndex < block->size(); ++instIndex) {
                 Inst& inst = block->at(instIndex);
                 unsigned indexOfEarly = indexOfHead + instIndex * 2;
+
+                if (!canKeepSpillTmpsAcross(inst))
+                    previousFills.clear();
                 
-                // First try to spill directly.
+                // First try to spill directly, unless the value is already in a register.
                 for (unsigned i = 0; i < inst.args.size(); ++i) {
                     Arg& arg = inst.args[i];
                     if (!arg.isTmp())
@@ -534,12 +591,15 @@ private:
                     StackSlot* spilled = m_map[arg.tmp()].spilled;
                     if (!spilled)
                         continue;
+                    if (previousFills.contains(spilled))
+                        continue;
                     if (!inst.admitsStack(i))
                         continue;
                     arg = Arg::stack(spilled);
                 }
                 
                 // Fall back on the hard way.
+                currentFills.clear();
                 inst.forEachTmp(
                     [&] (Tmp& tmp, Arg::Role role, Bank bank, Width) {
                         if (tmp.isReg())
@@ -548,14 +608,31 @@ private:
                         if (!spilled)
                             return;
                         Opcode move = bank == GP ? Move : MoveDouble;
-                        tmp = addSpillTmpWithInterval(bank, interval(indexOfEarly, Arg::timing(role)));
-                        if (role == Arg::Scratch)
-                            return;
-                        if (Arg::isAnyUse(role))
-                            m_insertionSets[block].insert(instIndex, secondPhase, move, inst.origin, Arg::stack(spilled), tmp);
-                        if (Arg::isAnyDef(role))
+                        Interval interval = this->interval(indexOfEarly, Arg::timing(role));
+
+                        auto iter = previousFills.find(spilled);
+                        if (role != Arg::Scratch && Arg::isAnyUse(role) && iter != previousFills.end()) {
+                            tmp = iter->value;
+                            m_map[tmp].interval |= interval;
+                        } else {
+                            tmp = addSpillTmpWithInterval(bank, interval);
+                            if (role == Arg::Scratch)
+                                return;
+                            if (Arg::isAnyUse(role))
+                                m_insertionSets[block].insert(instIndex, secondPhase, move, inst.origin, Arg::stack(spilled), tmp);
+                        }
+
+                        if (Arg::isAnyDef(role)) {
                             m_insertionSets[block].insert(instIndex + 1, firstPhase, move, inst.origin, tmp, Arg::stack(spilled));
+                            currentFills.set(spilled, tmp);
+                        } else
+                            currentFills.add(spilled, tmp);
                     });
+
+                if (canKeepSpillTmpsAcross(inst))
+                    std::swap(previousFills, currentFills);
+                else
+                    previousFills.clear();
             }
         }
     }
@@ -618,6 +695,7 @@ private:
         }
         
         for (BasicBlock* block : m_code) {
+            bool removedMoves = false;
             for (Inst& inst : *block) {
                 if (verbose())
                     dataLog("At: ", inst, "\n");
@@ -633,6 +711,20 @@ private:
                         }
                         tmp = Tmp(reg);
                     });
+
+                // Hinting makes lots of moves useless. Move32 is not one of them, since it
+                // zero-extends.
+                if ((inst.kind.opcode == Move || inst.kind.opcode == MoveDouble)
+                    && inst.args.size() == 2 && inst.args[0].isTmp() && inst.args[0] == inst.args[1]) {
+                    inst = Inst();
+                    removedMoves = true;
+                }
+            }
+            if (removedMoves) {
+                block->insts().removeAllMatching(
+                    [&] (const Inst& inst) -> bool {
+                        return !inst;
+                    });
             }
         }
     }
@@ -37,11 +37,12 @@ class Code;
 // This implements the Poletto and Sarkar register allocator called "linear scan":
 // http://dl.acm.org/citation.cfm?id=330250
 //
-// This is not Air's primary register allocator. We use it only when running at optLevel<2.
-// That's not the default level. This register allocator is optimized primarily for running
-// quickly. It's expected that improvements to this register allocator should focus on improving
-// its execution time without much regard for the quality of generated code. If you want good
-// code, use graph coloring.
+// This is not Air's primary register allocator. We use it when running at optLevel<2, and at
+// higher optLevels for functions that are too big for graph coloring to finish in reasonable time
+// (see Options::maximumTmpsForGraphColoring()). This register allocator is optimized primarily for
+// running quickly. Improvements to it should not cost much execution time. It does cheap things to
+// keep the code reasonable: it follows register hints from moves, and it keeps spilled values in
+// registers across runs of adjacent uses. If you want good code, use graph coloring.
 //
 // For Air's primary register allocator, see AirAllocateRegistersByGraphColoring.h|cpp.
 //
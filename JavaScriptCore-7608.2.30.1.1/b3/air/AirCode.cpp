@@ -287,7 +287,7 @@ unsigned Code::findNextBlockIndex(unsigned index) const
 BasicBlock* Code::findNextBlock(BasicBlock* block) const
 {
     unsigned index = findNextBlockIndex(block->index());
-    if (index < size())
+    if (index < size() && index != m_firstRareBlockIndex)
         return at(index);
     return nullptr;
 }
@@ -98,6 +98,16 @@ public:
     
     bool needsUsedRegisters() const;
 
+    // When set, generation puts the rare blocks and the late paths after everything else, never falls
+    // through into them, and makes them the assembler's cold code, which LinkBuffer links apart from
+    // the rest.
+    void setSeparatesRareCode(bool value) { m_separatesRareCode = value; }
+    bool separatesRareCode() const { return m_separatesRareCode; }
+
+    // This is set by optimizeBlockOrder().
+    void setFirstRareBlockIndex(unsigned index) { m_firstRareBlockIndex = index; }
+    unsigned firstRareBlockIndex() const { return m_firstRareBlockIndex; }
+
     JS_EXPORT_PRIVATE BasicBlock* addBlock(double frequency = 1);
 
     // Note that you can rely on stack slots always getting indices that are larger than the index
@@ -242,6 +252,7 @@ public:
     // Finds the smallest index' such that at(index') != null and index' > index.
     unsigned findNextBlockIndex(unsigned index) const;
 
+    // Returns null for the last block before the rare blocks, since that one cannot fall through.
     BasicBlock* findNextBlock(BasicBlock*) const;
 
     class iterator {
@@ -387,6 +398,8 @@ private:
     const char* m_lastPhaseName;
     std::unique_ptr<Disassembler> m_disassembler;
     unsigned m_optLevel { defaultOptLevel() };
+    unsigned m_firstRareBlockIndex { UINT_MAX };
+    bool m_separatesRareCode { false };
     Ref<PrologueGenerator> m_defaultPrologueGenerator;
 };
 
@@ -59,9 +59,70 @@
 #include "DisallowMacroScratchRegisterUsage.h"
 #include "LinkBuffer.h"
 #include <wtf/IndexMap.h>
+#include <wtf/MonotonicTime.h>
 
 namespace JSC { namespace B3 { namespace Air {
 
+static bool shouldUseLinearScan(Code& code)
+{
+    if (code.optLevel() < 2)
+        return true;
+
+    // Graph coloring is superlinear in the number of tmps and it may iterate many times before it
+    // stops spilling. For the biggest functions it dominates compile time, so we'd rather get code
+    // sooner than get good code.
+    unsigned numTmps = code.numTmps(GP) + code.numTmps(FP);
+    return numTmps > Options::maximumTmpsForGraphColoring();
+}
+
+namespace {
+
+struct RegisterAllocationStats {
+    void computeBefore(Code& code)
+    {
+        numTmps = code.numTmps(GP) + code.numTmps(FP);
+        for (BasicBlock* block : code)
+            numInstsBefore += block->size();
+    }
+
+    void computeAfter(Code& code)
+    {
+        for (StackSlot* slot : code.stackSlots()) {
+            if (slot->isSpill())
+                numSpillSlots++;
+        }
+        for (BasicBlock* block : code) {
+            numInstsAfter += block->size();
+            for (Inst& inst : *block) {
+                for (Arg& arg : inst.args) {
+                    if (arg.isStack() && arg.stackSlot()->isSpill()) {
+                        numSpillInsts++;
+                        weightedSpillInsts += block->frequency();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    void dump(PrintStream& out) const
+    {
+        out.print(
+            numTmps, " tmps, ", numInstsBefore, " insts before, ", numInstsAfter, " insts after, ",
+            numSpillSlots, " spill slots, ", numSpillInsts, " spill insts (", weightedSpillInsts,
+            " weighted by frequency)");
+    }
+
+    unsigned numTmps { 0 };
+    unsigned numInstsBefore { 0 };
+    unsigned numInstsAfter { 0 };
+    unsigned numSpillSlots { 0 };
+    unsigned numSpillInsts { 0 };
+    double weightedSpillInsts { 0 };
+};
+
+} // anonymous namespace
+
 void prepareForGeneration(Code& code)
 {
     TimingScope timingScope("Air::prepareForGeneration");
@@ -116,9 +177,18 @@ void prepareForGeneration(Code& code)
     
     eliminateDeadCode(code);
 
-    if (code.optLevel() == 1) {
-        // When we're compiling quickly, we do register and stack allocation in one linear scan
-        // phase. It's fast because it computes liveness only once.
+    RegisterAllocationStats stats;
+    MonotonicTime allocationStartTime;
+    if (Options::logAirRegisterAllocation()) {
+        stats.computeBefore(code);
+        allocationStartTime = MonotonicTime::now();
+    }
+
+    bool useLinearScan = shouldUseLinearScan(code);
+    if (useLinearScan) {
+        // When we're compiling quickly, or the function is too big for graph coloring, we do
+        // register and stack allocation in one linear scan phase. It's fast because it computes
+        // liveness only once.
         allocateRegistersAndStackByLinearScan(code);
         
         if (Options::logAirRegisterPressure()) {
@@ -154,6 +224,15 @@ void prepareForGeneration(Code& code)
         // bunch of other optimizations.
         allocateStackByGraphColoring(code);
     }
+
+    if (Options::logAirRegisterAllocation()) {
+        Seconds allocationTime = MonotonicTime::now() - allocationStartTime;
+        stats.computeAfter(code);
+        dataLog(
+            "Air register allocation at optLevel ", code.optLevel(), " using ",
+            useLinearScan ? "linear scan" : "graph coloring", ": ", allocationTime.milliseconds(),
+            " ms, ", stats, "\n");
+    }
     
     // This turns all Stack and CallArg Args into Addr args that use the frame pointer.
     lowerStackArgs(code);
@@ -228,9 +307,16 @@ static void generateWithAlreadyAllocatedRegisters(Code& code, CCallHelpers& jit)
 
     Disassembler* disassembler = code.disassembler();
 
+    auto startColdCode = [&] () {
+        if (code.separatesRareCode() && !jit.coldCodeStart().isSet())
+            jit.setColdCodeStart(jit.label());
+    };
+
     for (BasicBlock* block : code) {
         context.currentBlock = block;
         context.indexInBlock = UINT_MAX;
+        if (block->index() == code.firstRareBlockIndex())
+            startColdCode();
         blockJumps[block].link(&jit);
         CCallHelpers::Label label = jit.label();
         *context.blockLabels[block] = label;
@@ -328,6 +414,8 @@ static void generateWithAlreadyAllocatedRegisters(Code& code, CCallHelpers& jit)
     if (disassembler)
         disassembler->startLatePath(jit);
 
+    if (!context.latePaths.isEmpty())
+        startColdCode();
     for (auto& latePath : context.latePaths)
         latePath->run(jit, context);
 
@@ -73,7 +73,7 @@ private:
 
 } // anonymous namespace
 
-Vector<BasicBlock*> blocksInOptimizedOrder(Code& code)
+Vector<BasicBlock*> blocksInOptimizedOrder(Code& code, unsigned* numFastBlocks)
 {
     Vector<BasicBlock*> blocksInOrder;
 
@@ -106,6 +106,9 @@ Vector<BasicBlock*> blocksInOptimizedOrder(Code& code)
         sortedSuccessors.process(fastWorklist);
     }
 
+    if (numFastBlocks)
+        *numFastBlocks = blocksInOrder.size();
+
     BlockWorklist slowWorklist;
     sortedSlowSuccessors.process(slowWorklist);
 
@@ -130,7 +133,8 @@ void optimizeBlockOrder(Code& code)
 {
     PhaseScope phaseScope(code, "optimizeBlockOrder");
 
-    Vector<BasicBlock*> blocksInOrder = blocksInOptimizedOrder(code);
+    unsigned numFastBlocks;
+    Vector<BasicBlock*> blocksInOrder = blocksInOptimizedOrder(code, &numFastBlocks);
     
     // Place blocks into Code's block list according to the ordering in blocksInOrder. We do this by leaking
     // all of the blocks and then readopting them.
@@ -145,6 +149,11 @@ void optimizeBlockOrder(Code& code)
         code.blockList().append(std::unique_ptr<BasicBlock>(block));
     }
 
+    // This has to happen before we flip branches, so that the last fast block's branch doesn't count on
+    // falling through into the rare blocks.
+    if (code.separatesRareCode())
+        code.setFirstRareBlockIndex(numFastBlocks);
+
     // Finally, flip any branches that we recognize. It's most optimal if the taken successor does not point
     // at the next block.
     for (BasicBlock* block : code) {
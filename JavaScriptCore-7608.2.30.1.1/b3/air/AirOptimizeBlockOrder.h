@@ -36,11 +36,13 @@ class Code;
 
 // Returns a list of blocks sorted according to what would be the current optimal order. This shares
 // some properties with a pre-order traversal. In particular, each block will appear after at least
-// one of its predecessors.
-Vector<BasicBlock*> blocksInOptimizedOrder(Code&);
+// one of its predecessors. Blocks that are only reachable through rare edges come last; if you pass
+// numFastBlocks, it is set to the number of blocks before them.
+Vector<BasicBlock*> blocksInOptimizedOrder(Code&, unsigned* numFastBlocks = nullptr);
 
 // Reorders the basic blocks to keep hot blocks at the top, and maximize the likelihood that a frequently
-// taken edge is just a fall-through.
+// taken edge is just a fall-through. If the Code separates rare code, this also records where the rare
+// blocks start.
 
 void optimizeBlockOrder(Code&);
 
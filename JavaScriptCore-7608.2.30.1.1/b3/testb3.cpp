@@ -55,6 +55,7 @@
 #include "B3StackSlot.h"
 #include "B3StackmapGenerationParams.h"
 #include "B3SwitchValue.h"
+#include "B3UnrollLoops.h"
 #include "B3UpsilonValue.h"
 #include "B3UseCounts.h"
 #include "B3Validate.h"
@@ -11275,6 +11276,48 @@ void testLinearScanWithCalleeOnStack()
     Options::airLinearScanSpillsEverything() = original;
 }
 
+void testLinearScanForLargeFunctions()
+{
+    // Loads a lot of values and then combines them in reverse order, so that they are all live at
+    // once and some of them have to be spilled.
+    const unsigned numValues = 64;
+
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+
+    Value* base = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    Vector<Value*> values;
+    for (unsigned i = 0; i < numValues; ++i) {
+        values.append(
+            root->appendNew<MemoryValue>(
+                proc, Load, Int64, Origin(), base, static_cast<int32_t>(i * sizeof(int64_t))));
+    }
+    Value* result = root->appendNew<Const64Value>(proc, Origin(), 0);
+    for (unsigned i = numValues; i--;) {
+        result = root->appendNew<Value>(
+            proc, Add, Origin(),
+            root->appendNew<Value>(proc, Mul, Origin(), result, root->appendNew<Const64Value>(proc, Origin(), 3)),
+            values[i]);
+    }
+    root->appendNewControlValue(proc, Return, Origin(), result);
+
+    Vector<int64_t> data;
+    uint64_t expected = 0;
+    for (unsigned i = 0; i < numValues; ++i)
+        data.append(static_cast<int64_t>(i) * 7 - 100);
+    for (unsigned i = numValues; i--;)
+        expected = expected * 3 + static_cast<uint64_t>(data[i]);
+
+    // Make every function look too big for graph coloring.
+    auto original = Options::maximumTmpsForGraphColoring();
+    Options::maximumTmpsForGraphColoring() = 0;
+
+    auto code = compileProc(proc, 2);
+    CHECK_EQ(invoke<int64_t>(*code, data.data()), static_cast<int64_t>(expected));
+
+    Options::maximumTmpsForGraphColoring() = original;
+}
+
 void testChillDiv(int num, int den, int res)
 {
     // Test non-constant.
@@ -11604,6 +11647,131 @@ void testLoopWithMultipleHeaderEdges()
     CHECK(invoke<int32_t>(*code, 0, 12345) == 5678);
 }
 
+void testUnrollCountedLoop(int32_t length)
+{
+    // for (i = 0; i < length; ++i) { sum += array[i]; array[i]++; } return sum;
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* loop = proc.addBlock();
+    BasicBlock* done = proc.addBlock();
+
+    Value* array = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    Value* limit = root->appendNew<Value>(
+        proc, Trunc, Origin(),
+        root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+    Value* zero = root->appendNew<Const32Value>(proc, Origin(), 0);
+    UpsilonValue* initialIndex = root->appendNew<UpsilonValue>(proc, Origin(), zero);
+    UpsilonValue* initialSum = root->appendNew<UpsilonValue>(proc, Origin(), zero);
+    UpsilonValue* emptyResult = root->appendNew<UpsilonValue>(proc, Origin(), zero);
+    root->appendNewControlValue(
+        proc, Branch, Origin(),
+        root->appendNew<Value>(proc, LessThan, Origin(), zero, limit),
+        FrequentedBlock(loop), FrequentedBlock(done));
+
+    Value* index = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    Value* sum = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    Value* address = loop->appendNew<Value>(
+        proc, Add, Origin(), array,
+        loop->appendNew<Value>(
+            proc, Shl, Origin(),
+            loop->appendNew<Value>(proc, ZExt32, Origin(), index),
+            loop->appendNew<Const32Value>(proc, Origin(), 2)));
+    Value* element = loop->appendNew<MemoryValue>(proc, Load, Int32, Origin(), address);
+    loop->appendNew<MemoryValue>(
+        proc, Store, Origin(),
+        loop->appendNew<Value>(proc, Add, Origin(), element, loop->appendNew<Const32Value>(proc, Origin(), 1)),
+        address);
+    Value* newSum = loop->appendNew<Value>(proc, Add, Origin(), sum, element);
+    Value* next = loop->appendNew<Value>(proc, Add, Origin(), index, loop->appendNew<Const32Value>(proc, Origin(), 1));
+    loop->appendNew<UpsilonValue>(proc, Origin(), next, index);
+    loop->appendNew<UpsilonValue>(proc, Origin(), newSum, sum);
+    UpsilonValue* loopResult = loop->appendNew<UpsilonValue>(proc, Origin(), newSum);
+    loop->appendNewControlValue(
+        proc, Branch, Origin(),
+        loop->appendNew<Value>(proc, LessThan, Origin(), next, limit),
+        FrequentedBlock(loop), FrequentedBlock(done));
+
+    Value* result = done->appendNew<Value>(proc, Phi, Int32, Origin());
+    initialIndex->setPhi(index);
+    initialSum->setPhi(sum);
+    emptyResult->setPhi(result);
+    loopResult->setPhi(result);
+    done->appendNewControlValue(proc, Return, Origin(), result);
+
+    Vector<int32_t> values;
+    int32_t expected = 0;
+    for (int32_t i = 0; i < length; ++i) {
+        values.append(i * 3 + 1);
+        expected += i * 3 + 1;
+    }
+    // Guard against writes past the end.
+    values.append(42);
+
+    // Unrolling is off by default, so run the phase ahead of the pipeline, whose fixSSA() cleans up
+    // after it.
+    CHECK(unrollLoops(proc));
+    bool sawRemark = false;
+    for (const Procedure::Remark& remark : proc.remarks()) {
+        if (!strcmp(remark.phase, "unrollLoops") && !strncmp(remark.message.data(), "Unrolling ", 10))
+            sawRemark = true;
+    }
+    CHECK(sawRemark);
+
+    CHECK_EQ(compileAndRun<int32_t>(proc, values.data(), length), expected);
+}
+
+void testSeparateRareCode()
+{
+    // x = arg; if (x < 0) /* rarely */ x *= 3; return checkedAdd(x, 1) or -1 on overflow.
+    Procedure proc;
+    if (proc.optLevel() < 1)
+        return;
+    proc.setSeparatesRareCode(true);
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* rare = proc.addBlock();
+    BasicBlock* common = proc.addBlock();
+
+    Value* arg = root->appendNew<Value>(
+        proc, Trunc, Origin(),
+        root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0));
+    UpsilonValue* fromRoot = root->appendNew<UpsilonValue>(proc, Origin(), arg);
+    root->appendNewControlValue(
+        proc, Branch, Origin(),
+        root->appendNew<Value>(proc, LessThan, Origin(), arg, root->appendNew<Const32Value>(proc, Origin(), 0)),
+        FrequentedBlock(rare, FrequencyClass::Rare),
+        FrequentedBlock(common));
+
+    UpsilonValue* fromRare = rare->appendNew<UpsilonValue>(
+        proc, Origin(),
+        rare->appendNew<Value>(proc, Mul, Origin(), arg, rare->appendNew<Const32Value>(proc, Origin(), 3)));
+    rare->appendNewControlValue(proc, Jump, Origin(), FrequentedBlock(common));
+
+    Value* x = common->appendNew<Value>(proc, Phi, Int32, Origin());
+    fromRoot->setPhi(x);
+    fromRare->setPhi(x);
+    CheckValue* checkAdd = common->appendNew<CheckValue>(
+        proc, CheckAdd, Origin(), x, common->appendNew<Const32Value>(proc, Origin(), 1));
+    checkAdd->setGenerator(
+        [&] (CCallHelpers& jit, const StackmapGenerationParams&) {
+            AllowMacroScratchRegisterUsage allowScratch(jit);
+            jit.move(CCallHelpers::TrustedImm32(-1), GPRInfo::returnValueGPR);
+            jit.emitFunctionEpilogue();
+            jit.ret();
+        });
+    common->appendNewControlValue(proc, Return, Origin(), checkAdd);
+
+    auto code = compileProc(proc);
+    // The rare block and the check's exit path form the cold tail. Only x86-64 links it apart.
+    CHECK_EQ(!!code->coldCode(), isX86_64());
+
+    CHECK_EQ(invoke<int32_t>(*code, 5), 6);
+    CHECK_EQ(invoke<int32_t>(*code, -5), -14);
+    CHECK_EQ(invoke<int32_t>(*code, std::numeric_limits<int32_t>::max()), -1);
+    for (int32_t i = 0; i < length; ++i)
+        CHECK_EQ(values[i], i * 3 + 2);
+    CHECK_EQ(values[std::max(length, 0)], 42);
+}
+
 void testSwitch(unsigned degree, unsigned gap = 1)
 {
     Procedure proc;
@@ -18266,6 +18434,7 @@ void run(const char* filter)
     RUN(testCallFunctionWithHellaFloatArguments());
 
     RUN(testLinearScanWithCalleeOnStack());
+    RUN(testLinearScanForLargeFunctions());
 
     RUN(testChillDiv(4, 2, 2));
     RUN(testChillDiv(1, 0, 0));
@@ -18850,6 +19019,14 @@ void run(const char* filter)
     RUN(testDemotePatchpointTerminal());
 
     RUN(testLoopWithMultipleHeaderEdges());
+    RUN(testUnrollCountedLoop(0));
+    RUN(testUnrollCountedLoop(1));
+    RUN(testUnrollCountedLoop(3));
+    RUN(testUnrollCountedLoop(4));
+    RUN(testUnrollCountedLoop(5));
+    RUN(testUnrollCountedLoop(16));
+    RUN(testUnrollCountedLoop(103));
+    RUN(testSeparateRareCode());
 
     RUN(testInfiniteLoopDoesntCauseBadHoisting());
 
@@ -47,6 +47,27 @@ function asyncFunctionResume(generator, promiseCapability, sentValue, resumeMode
         return promiseCapability.@promise;
     }
 
+    // Resume directly when the awaited value is a primitive or a native promise, as PromiseResolve
+    // would hand back an already settled promise or the promise itself. Only other objects, which
+    // may be thenables, need a wrapping promise.
+    if (!@isObject(value)) {
+        @enqueueJob(@asyncFunctionResume, generator, promiseCapability, value, @GeneratorResumeModeNormal);
+        return promiseCapability.@promise;
+    }
+
+    if (@isPromise(value)) {
+        let constructor;
+        try {
+            constructor = value.constructor;
+        } catch (error) {
+            return @asyncFunctionResume(generator, promiseCapability, error, @GeneratorResumeModeThrow);
+        }
+        if (constructor === @Promise) {
+            @awaitPromise(value, generator, promiseCapability);
+            return promiseCapability.@promise;
+        }
+    }
+
     let wrappedValue = @newPromiseCapability(@Promise);
     wrappedValue.@resolve.@call(@undefined, value);
 
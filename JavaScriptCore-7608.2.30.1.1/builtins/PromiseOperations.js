@@ -99,7 +99,7 @@ function triggerPromiseReactions(state, reactions, argument)
     "use strict";
 
     for (var index = 0, length = reactions.length; index < length; ++index)
-        @enqueueJob(@promiseReactionJob, [state, reactions[index], argument]);
+        @enqueueJob(@promiseReactionJob, state, reactions[index], argument);
 }
 
 @globalPrivate
@@ -163,7 +163,7 @@ function createResolvingFunctions(promise)
         if (typeof then !== 'function')
             return @fulfillPromise(promise, resolution);
 
-        @enqueueJob(@promiseResolveThenableJob, [promise, resolution, then]);
+        @enqueueJob(@promiseResolveThenableJob, promise, resolution, then);
 
         return @undefined;
     }
@@ -179,6 +179,33 @@ function createResolvingFunctions(promise)
     return { @resolve, @reject };
 }
 
+@globalPrivate
+function awaitPromise(promise, generator, promiseCapability)
+{
+    "use strict";
+
+    // This is promise.@then() for an await on a native promise, without the derived promise and
+    // handler closures that @then would create and that nobody can observe.
+    var reaction = {
+        @capabilities: promiseCapability,
+        @onFulfilled: @undefined,
+        @onRejected: @undefined,
+        @generator: generator,
+    };
+
+    var state = @getByIdDirectPrivate(promise, "promiseState");
+    if (state === @promiseStatePending) {
+        var reactions = @getByIdDirectPrivate(promise, "promiseReactions");
+        @putByValDirect(reactions, reactions.length, reaction);
+    } else {
+        if (state === @promiseStateRejected && !@getByIdDirectPrivate(promise, "promiseIsHandled"))
+            @hostPromiseRejectionTracker(promise, @promiseRejectionHandle);
+        @enqueueJob(@promiseReactionJob, state, reaction, @getByIdDirectPrivate(promise, "promiseResult"));
+    }
+
+    @putByIdDirectPrivate(promise, "promiseIsHandled", true);
+}
+
 @globalPrivate
 function promiseReactionJob(state, reaction, argument)
 {
@@ -186,6 +213,10 @@ function promiseReactionJob(state, reaction, argument)
 
     var promiseCapability = reaction.@capabilities;
 
+    // Reactions added by @awaitPromise have no handlers. They resume the awaiting async function directly.
+    if (reaction.@onFulfilled === @undefined)
+        return @asyncFunctionResume(reaction.@generator, promiseCapability, argument, state === @promiseStateFulfilled ? @GeneratorResumeModeNormal : @GeneratorResumeModeThrow);
+
     var result;
     var handler = (state === @promiseStateFulfilled) ? reaction.@onFulfilled: reaction.@onRejected;
     try {
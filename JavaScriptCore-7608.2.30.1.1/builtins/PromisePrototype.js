@@ -56,7 +56,7 @@ function then(onFulfilled, onRejected)
     } else {
         if (state === @promiseStateRejected && !@getByIdDirectPrivate(this, "promiseIsHandled"))
             @hostPromiseRejectionTracker(this, @promiseRejectionHandle);
-        @enqueueJob(@promiseReactionJob, [state, reaction, @getByIdDirectPrivate(this, "promiseResult")]);
+        @enqueueJob(@promiseReactionJob, state, reaction, @getByIdDirectPrivate(this, "promiseResult"));
     }
 
     @putByIdDirectPrivate(this, "promiseIsHandled", true);
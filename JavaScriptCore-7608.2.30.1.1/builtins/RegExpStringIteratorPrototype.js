@@ -41,6 +41,9 @@ function next()
     let string = @getByIdDirectPrivate(this, "regExpStringIteratorString");
     let global = @getByIdDirectPrivate(this, "regExpStringIteratorGlobal");
     let fullUnicode = @getByIdDirectPrivate(this, "regExpStringIteratorUnicode");
+    // Unlike a global replace or split, this can't find its matches in batches, even for a pristine
+    // RegExp. Each step has to call RegExpExec when next() is called, because exec may have been
+    // replaced in the meantime, and RegExp.lastMatch has to describe the match this step returns.
     let match = @regExpExec(regExp, string);
     if (match === null) {
         @putByIdDirectPrivate(this, "regExpStringIteratorDone", true);
@@ -52,22 +52,6 @@ function typedArraySpeciesConstructor(value)
     return constructor;
 }
 
-@globalPrivate
-function typedArrayClampArgumentToStartOrEnd(value, length, undefinedValue)
-{
-    "use strict";
-
-    if (value === @undefined)
-        return undefinedValue;
-
-    let int = @toInteger(value);
-    if (int < 0) {
-        int += length;
-        return int < 0 ? 0 : int;
-    }
-    return int > length ? length : int;
-}
-
 function values()
 {
     "use strict";
@@ -106,23 +90,6 @@ function every(callback /*, thisArg */)
     return true;
 }
 
-function fill(value /* [, start [, end]] */)
-{
-    "use strict";
-
-    let length = @typedArrayLength(this);
-
-    let start = @argument(1);
-    let end = @argument(2);
-
-    start = @typedArrayClampArgumentToStartOrEnd(start, length, 0);
-    end = @typedArrayClampArgumentToStartOrEnd(end, length, length);
-
-    for (let i = start; i < end; i++)
-        this[i] = value;
-    return this;
-}
-
 function find(callback /* [, thisArg] */)
 {
     "use strict";
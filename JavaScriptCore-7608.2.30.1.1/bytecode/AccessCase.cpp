@@ -31,6 +31,7 @@
 #include "CCallHelpers.h"
 #include "CallLinkInfo.h"
 #include "DOMJITGetterSetter.h"
+#include "DictionaryAccessCase.h"
 #include "DirectArguments.h"
 #include "GetterSetter.h"
 #include "GetterSetterAccessCase.h"
@@ -1225,6 +1226,10 @@ void AccessCase::generateImpl(AccessGenerationState& state)
         return;
     }
         
+    case DictionaryLoad:
+        this->as<DictionaryAccessCase>().emit(state);
+        return;
+
     case IntrinsicGetter: {
         RELEASE_ASSERT(isValidOffset(offset()));
 
@@ -99,6 +99,7 @@ public:
         DirectArgumentsLength,
         ScopedArgumentsLength,
         ModuleNamespaceLoad,
+        DictionaryLoad,
         InstanceOfHit,
         InstanceOfMiss,
         InstanceOfGeneric
@@ -242,7 +242,12 @@ CallLinkStatus CallLinkStatus::computeFromCallLinkInfo(
             return takesSlowPath();
         
         // We require that the distribution of callees is skewed towards a handful of common ones.
-        if (totalCallsToKnown / totalCallsToUnknown < Options::minimumCallToKnownRate())
+        // Megamorphic sites are let off more lightly: the calls we don't inline will still go
+        // through a dispatch table rather than a virtual call.
+        double minimumCallToKnownRate = stub->hasDispatchTable()
+            ? Options::minimumCallToKnownRateForDispatchTable()
+            : Options::minimumCallToKnownRate();
+        if (totalCallsToKnown / totalCallsToUnknown < minimumCallToKnownRate)
             return takesSlowPath();
         
         RELEASE_ASSERT(totalCallsToKnown);
@@ -1541,6 +1541,25 @@ CallLinkInfo* CodeBlock::getCallLinkInfoForBytecodeIndex(unsigned index)
     return nullptr;
 }
 
+Vector<PolymorphicCallDispatchTableStatistics> CodeBlock::callDispatchTableStatistics()
+{
+    Vector<PolymorphicCallDispatchTableStatistics> result;
+    ConcurrentJSLocker locker(m_lock);
+    if (auto* jitData = m_jitData.get()) {
+        for (CallLinkInfo* callLinkInfo : jitData->m_callLinkInfos) {
+            PolymorphicCallStubRoutine* stub = callLinkInfo->stub();
+            if (!stub || !stub->dispatchTable())
+                continue;
+            const PolymorphicCallDispatchTable& table = *stub->dispatchTable();
+            PolymorphicCallDispatchTableStatistics statistics { callLinkInfo->codeOrigin(), table.size(), table.hitCount(), table.missCount(), { } };
+            for (CallVariant variant : stub->variants())
+                statistics.targets.append(variant.executable());
+            result.append(WTFMove(statistics));
+        }
+    }
+    return result;
+}
+
 RareCaseProfile* CodeBlock::addRareCaseProfile(int bytecodeOffset)
 {
     ConcurrentJSLocker locker(m_lock);
@@ -310,6 +310,9 @@ public:
     // that there had been inlining. Chances are if you want to use this, you're really
     // looking for a CallLinkInfoMap to amortize the cost of calling this.
     CallLinkInfo* getCallLinkInfoForBytecodeIndex(unsigned bytecodeIndex);
+
+    // One entry per call site in this code block that is linked through a dispatch table.
+    JS_EXPORT_PRIVATE Vector<PolymorphicCallDispatchTableStatistics> callDispatchTableStatistics();
     
     void setJITCodeMap(JITCodeMap&& jitCodeMap)
     {
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "DictionaryAccessCase.h"
+
+#if ENABLE(JIT)
+
+#include "CCallHelpers.h"
+#include "JSCInlines.h"
+#include "PolymorphicAccess.h"
+#include "PropertyMapHashTable.h"
+#include "StructureStubInfo.h"
+
+namespace JSC {
+
+DictionaryAccessCase::DictionaryAccessCase(VM& vm, JSCell* owner, Structure* structure)
+    : Base(vm, owner, DictionaryLoad, invalidOffset, structure, ObjectPropertyConditionSet(), nullptr)
+{
+}
+
+std::unique_ptr<AccessCase> DictionaryAccessCase::create(VM& vm, JSCell* owner, Structure* structure)
+{
+    return std::unique_ptr<AccessCase>(new DictionaryAccessCase(vm, owner, structure));
+}
+
+DictionaryAccessCase::~DictionaryAccessCase()
+{
+}
+
+bool DictionaryAccessCase::canBeUsedFor(VM& vm, JSCell* base, const PropertySlot& slot)
+{
+    if (!Options::useDictionaryAccessInlineCaches())
+        return false;
+
+    if (!base->isObject())
+        return false;
+
+    Structure* structure = base->structure(vm);
+    if (!structure->isUncacheableDictionary())
+        return false;
+
+    TypeInfo typeInfo = structure->typeInfo();
+    if (typeInfo.prohibitsPropertyCaching() || typeInfo.getOwnPropertySlotIsImpure())
+        return false;
+
+    // We only handle own data properties. Misses and prototype hits would need us to prove that
+    // nothing on the way up the chain changed, which is exactly what dictionaries prevent.
+    return slot.isCacheableValue()
+        && slot.slotBase() == base
+        && !slot.watchpointSet();
+}
+
+std::unique_ptr<AccessCase> DictionaryAccessCase::clone() const
+{
+    std::unique_ptr<DictionaryAccessCase> result(new DictionaryAccessCase(*this));
+    result->resetState();
+    return result;
+}
+
+void DictionaryAccessCase::emit(AccessGenerationState& state)
+{
+    CCallHelpers& jit = *state.jit;
+    JSValueRegs valueRegs = state.valueRegs;
+    GPRReg baseGPR = state.baseGPR;
+    GPRReg propertyTableGPR = state.scratchGPR;
+
+    UniquedStringImpl* uid = state.ident->impl();
+    unsigned hash = IdentifierRepHash::hash(uid);
+
+    ScratchRegisterAllocator allocator(state.stubInfo->patch.usedRegisters);
+    allocator.lock(baseGPR);
+    allocator.lock(valueRegs);
+    if (state.thisGPR != InvalidGPRReg)
+        allocator.lock(state.thisGPR);
+    allocator.lock(propertyTableGPR);
+
+    GPRReg hashGPR = allocator.allocateScratchGPR();
+    GPRReg entryGPR = allocator.allocateScratchGPR();
+    GPRReg indexGPR = allocator.allocateScratchGPR();
+
+    ScratchRegisterAllocator::PreservedState preservedState =
+        allocator.preserveReusedRegistersByPushing(
+            jit,
+            ScratchRegisterAllocator::ExtraStackSpace::NoExtraSpace);
+    CCallHelpers::JumpList failAndIgnore;
+
+    // Dictionary tables are pinned, but be conservative in case this structure got flattened and
+    // lost its table after we generated the stub.
+    jit.move(CCallHelpers::TrustedImmPtr(structure()), propertyTableGPR);
+    jit.loadPtr(CCallHelpers::Address(propertyTableGPR, Structure::propertyTableUnsafeOffset()), propertyTableGPR);
+    failAndIgnore.append(jit.branchTestPtr(CCallHelpers::Zero, propertyTableGPR));
+
+    // This is PropertyTable::find(). The table is never full, so the probe terminates at an empty
+    // slot if the key is not there.
+    jit.move(CCallHelpers::TrustedImm32(hash), hashGPR);
+    CCallHelpers::Label loop = jit.label();
+    jit.load32(CCallHelpers::Address(propertyTableGPR, PropertyTable::offsetOfIndexMask()), entryGPR);
+    jit.and32(hashGPR, entryGPR);
+    jit.loadPtr(CCallHelpers::Address(propertyTableGPR, PropertyTable::offsetOfIndex()), indexGPR);
+    jit.load32(CCallHelpers::BaseIndex(indexGPR, entryGPR, CCallHelpers::TimesFour), entryGPR);
+    failAndIgnore.append(jit.branch32(CCallHelpers::Equal, entryGPR, CCallHelpers::TrustedImm32(PropertyTable::EmptyEntryIndex)));
+
+    // The entries live right after the m_indexSize slots of the index vector. Deleted slots point
+    // at a sentinel entry whose key never matches, so they just make us keep probing.
+    jit.load32(CCallHelpers::Address(propertyTableGPR, PropertyTable::offsetOfIndexSize()), indexGPR);
+    jit.zeroExtend32ToPtr(indexGPR, indexGPR);
+    jit.lshiftPtr(CCallHelpers::TrustedImm32(2), indexGPR);
+    jit.addPtr(CCallHelpers::Address(propertyTableGPR, PropertyTable::offsetOfIndex()), indexGPR);
+    jit.sub32(CCallHelpers::TrustedImm32(1), entryGPR);
+    jit.mul32(CCallHelpers::TrustedImm32(sizeof(PropertyMapEntry)), entryGPR, entryGPR);
+    jit.zeroExtend32ToPtr(entryGPR, entryGPR);
+    jit.addPtr(indexGPR, entryGPR);
+
+    CCallHelpers::Jump found = jit.branchPtr(
+        CCallHelpers::Equal,
+        CCallHelpers::Address(entryGPR, OBJECT_OFFSETOF(PropertyMapEntry, key)),
+        CCallHelpers::TrustedImmPtr(uid));
+    jit.add32(CCallHelpers::TrustedImm32(1), hashGPR);
+    jit.jump().linkTo(loop, &jit);
+
+    found.link(&jit);
+    failAndIgnore.append(
+        jit.branchTest8(
+            CCallHelpers::NonZero,
+            CCallHelpers::Address(entryGPR, OBJECT_OFFSETOF(PropertyMapEntry, attributes)),
+            CCallHelpers::TrustedImm32(static_cast<int32_t>(PropertyAttribute::AccessorOrCustomAccessorOrValue))));
+    jit.load32(CCallHelpers::Address(entryGPR, OBJECT_OFFSETOF(PropertyMapEntry, offset)), entryGPR);
+    jit.loadProperty(baseGPR, entryGPR, valueRegs);
+
+    allocator.restoreReusedRegistersByPopping(jit, preservedState);
+    state.succeed();
+
+    if (allocator.didReuseRegisters()) {
+        failAndIgnore.link(&jit);
+        allocator.restoreReusedRegistersByPopping(jit, preservedState);
+        state.failAndIgnore.append(jit.jump());
+    } else
+        state.failAndIgnore.append(failAndIgnore);
+}
+
+} // namespace JSC
+
+#endif // ENABLE(JIT)
@@ -204,6 +204,11 @@ GetByIdStatus GetByIdStatus::computeForStubInfoWithoutExitSiteFeedback(
 
             if (access.usesPolyProto())
                 return GetByIdStatus(JSC::slowVersion(summary));
+
+            // The offset of a property in an uncacheable dictionary is not a function of its
+            // structure, so there is nothing the DFG could fold here.
+            if (access.type() == AccessCase::DictionaryLoad)
+                return GetByIdStatus(JSC::slowVersion(summary));
             
             Structure* structure = access.structure();
             if (!structure) {
@@ -729,6 +729,9 @@ void printInternal(PrintStream& out, AccessCase::AccessType type)
     case AccessCase::ModuleNamespaceLoad:
         out.print("ModuleNamespaceLoad");
         return;
+    case AccessCase::DictionaryLoad:
+        out.print("DictionaryLoad");
+        return;
     case AccessCase::InstanceOfHit:
         out.print("InstanceOfHit");
         return;
@@ -303,6 +303,14 @@ public:
         m_endColumn = endColumn;
     }
 
+    // Function code blocks can be shared by functions at different positions, so they only record the
+    // results of the parse that don't depend on where the function is.
+    void recordParse(CodeFeatures features, bool hasCapturedVariables)
+    {
+        m_features = features;
+        m_hasCapturedVariables = hasCapturedVariables;
+    }
+
     const String& sourceURLDirective() const { return m_sourceURLDirective; }
     const String& sourceMappingURLDirective() const { return m_sourceMappingURLDirective; }
     void setSourceURLDirective(const String& sourceURL) { m_sourceURLDirective = sourceURL; }
@@ -57,6 +57,14 @@ static UnlinkedFunctionCodeBlock* generateUnlinkedFunctionCodeBlock(
     JSParserStrictMode strictMode = executable->isInStrictContext() ? JSParserStrictMode::Strict : JSParserStrictMode::NotStrict;
     JSParserScriptMode scriptMode = executable->scriptMode();
     ASSERT(isFunctionParseMode(executable->parseMode()));
+
+    CodeCache* codeCache = vm.codeCache();
+    if (UnlinkedFunctionCodeBlock* sharedCodeBlock = codeCache->findSharedFunctionCodeBlock(*executable, source, kind, parseMode, codeGenerationMode)) {
+        executable->recordParse(sharedCodeBlock->codeFeatures(), sharedCodeBlock->hasCapturedVariables());
+        codeCache->updateCache(executable, source, kind, sharedCodeBlock);
+        return sharedCodeBlock;
+    }
+
     std::unique_ptr<FunctionNode> function = parse<FunctionNode>(
         &vm, source, executable->name(), builtinMode, strictMode, scriptMode, executable->parseMode(), executable->superBinding(), error, nullptr);
 
@@ -71,13 +79,16 @@ static UnlinkedFunctionCodeBlock* generateUnlinkedFunctionCodeBlock(
     bool isClassContext = executable->superBinding() == SuperBinding::Needed;
 
     UnlinkedFunctionCodeBlock* result = UnlinkedFunctionCodeBlock::create(&vm, FunctionCode, ExecutableInfo(function->usesEval(), function->isStrictMode(), kind == CodeForConstruct, functionKind == UnlinkedBuiltinFunction, executable->constructorKind(), scriptMode, executable->superBinding(), parseMode, executable->derivedContextType(), false, isClassContext, EvalContextType::FunctionEvalContext), codeGenerationMode);
+    // Functions that pick this code block up from the CodeCache take their parse results from it.
+    result->recordParse(function->features(), function->hasCapturedVariables());
 
     VariableEnvironment parentScopeTDZVariables = executable->parentScopeTDZVariables();
     error = BytecodeGenerator::generate(vm, function.get(), source, result, codeGenerationMode, &parentScopeTDZVariables);
 
     if (error.isValid())
         return nullptr;
-    vm.codeCache()->updateCache(executable, source, kind, result);
+    codeCache->addSharedFunctionCodeBlock(vm, *executable, source, kind, parseMode, codeGenerationMode, result);
+    codeCache->updateCache(executable, source, kind, result);
     return result;
 }
 
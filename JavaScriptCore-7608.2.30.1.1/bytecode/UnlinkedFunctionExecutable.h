@@ -162,6 +162,13 @@ public:
             return VariableEnvironment();
         return m_rareData->m_parentScopeTDZVariables.environment().toVariableEnvironment();
     }
+
+    CompactVariableMap::Handle parentScopeTDZVariablesHandle() const
+    {
+        if (!m_rareData)
+            return { };
+        return m_rareData->m_parentScopeTDZVariables;
+    }
     
     bool isArrowFunction() const { return isArrowFunctionParseMode(parseMode()); }
 
@@ -91,6 +91,16 @@ public:
     }
 
 private:
+    // A Spread of an array that this phase did not create. Its JSFixedArray can still be eliminated
+    // when the spread is only consumed by NewArrayWithSpread, because the consumer and OSR exit can
+    // read the elements out of the array itself as long as nothing writes to it in between.
+    static bool isSpreadOfExistingArray(Node* node)
+    {
+        return node->op() == Spread
+            && node->child1()->op() != CreateRest
+            && node->child1()->op() != NewArrayBuffer;
+    }
+
     // Just finds nodes that we know how to work with.
     void identifyCandidates()
     {
@@ -121,6 +131,11 @@ private:
                         if (node->child1().useKind() == ArrayUse) {
                             if ((node->child1()->op() == CreateRest || node->child1()->op() == NewArrayBuffer) && m_candidates.contains(node->child1().node()))
                                 m_candidates.add(node);
+                            else if (isSpreadOfExistingArray(node) && !m_graph.hasExitSite(node, BadCache)) {
+                                // We'll check that the array has one of the original array structures
+                                // when we transform this. Don't bother if that check has been failing.
+                                m_candidates.add(node);
+                            }
                         }
                     }
                     break;
@@ -129,6 +144,7 @@ private:
                     if (m_graph.isWatchingHavingABadTimeWatchpoint(node)) {
                         BitVector* bitVector = node->bitVector();
                         // We only allow for Spreads to be of CreateRest or NewArrayBuffer nodes for now.
+                        // A spread of an existing array is only eliminated into a NewArrayWithSpread that we keep.
                         bool isOK = true;
                         for (unsigned i = 0; i < node->numChildren(); i++) {
                             if (bitVector->get(i)) {
@@ -176,6 +192,8 @@ private:
     {
         switch (candidate->op()) {
         case Spread:
+            if (isSpreadOfExistingArray(candidate))
+                return true;
             return m_candidates.contains(candidate->child1().node());
 
         case NewArrayWithSpread: {
@@ -321,6 +339,8 @@ private:
 
                 case GetArrayLength:
                     escape(node->child2(), node);
+                    if (isSpreadOfExistingArray(node->child1().node()))
+                        escape(node->child1(), node);
                     // Computing the length of a NewArrayWithSpread can require some additions.
                     // These additions can overflow if the array is sufficiently enormous, and in that case we will need to exit.
                     if ((node->child1()->op() == NewArrayWithSpread) && !node->origin.exitOK)
@@ -334,9 +354,9 @@ private:
                         Edge child = m_graph.varArgChild(node, i);
                         bool dontEscape;
                         if (bitVector->get(i)) {
+                            // This covers spreads of CreateRest, NewArrayBuffer and existing arrays.
                             dontEscape = child->op() == Spread
                                 && child->child1().useKind() == ArrayUse
-                                && (child->child1()->op() == CreateRest || child->child1()->op() == NewArrayBuffer)
                                 && isWatchingHavingABadTimeWatchpoint;
                         } else
                             dontEscape = false;
@@ -361,6 +381,8 @@ private:
                 case LoadVarargs:
                     if (node->loadVarargsData()->offset && (node->child1()->op() == NewArrayWithSpread || node->child1()->op() == Spread || node->child1()->op() == NewArrayBuffer))
                         escape(node->child1(), node);
+                    else if (isSpreadOfExistingArray(node->child1().node()))
+                        escape(node->child1(), node);
                     break;
                     
                 case CallVarargs:
@@ -371,6 +393,8 @@ private:
                     escape(node->child2(), node);
                     if (node->callVarargsData()->firstVarArgOffset && (node->child3()->op() == NewArrayWithSpread || node->child3()->op() == Spread || node->child1()->op() == NewArrayBuffer))
                         escape(node->child3(), node);
+                    else if (isSpreadOfExistingArray(node->child3().node()))
+                        escape(node->child3(), node);
                     break;
 
                 case Check:
@@ -509,7 +533,8 @@ private:
             functor(node);
 
             if (node->op() == Spread) {
-                self(node->child1().node(), functor);
+                if (!isSpreadOfExistingArray(node))
+                    self(node->child1().node(), functor);
                 return;
             }
 
@@ -523,12 +548,64 @@ private:
             }
         });
         for (Node* candidate : m_candidates) {
+            // A spread of an existing array doesn't read the stack.
+            if (isSpreadOfExistingArray(candidate))
+                continue;
             auto& set = inlineCallFramesForCandidate.add(candidate, InlineCallFrames()).iterator->value;
             forEachDependentNode(candidate, [&](Node* dependent) {
                 set.add(dependent->origin.semantic.inlineCallFrame());
             });
         }
 
+        // A spread of an existing array reads the array where it is consumed, or where OSR exit
+        // materializes it, rather than where it executes. So we require the spread to die in the
+        // block that defines it, and nothing before it dies may write to the array.
+        auto writesToArrayElements = [] (AbstractHeap heap) -> bool {
+            for (AbstractHeapKind kind : { JSCell_structureID, JSCell_indexingType, JSObject_butterfly, Butterfly_publicLength, IndexedInt32Properties, IndexedDoubleProperties, IndexedContiguousProperties }) {
+                if (heap.overlaps(kind))
+                    return true;
+            }
+            return false;
+        };
+        for (BasicBlock* block : m_graph.blocksInNaturalOrder()) {
+            forAllKillsInBlock(
+                m_graph, combinedLiveness, block,
+                [&] (unsigned nodeIndex, Node* candidate) {
+                    if (!m_candidates.contains(candidate) || !isSpreadOfExistingArray(candidate))
+                        return;
+
+                    if (nodeIndex == block->size() || candidate->owner != block) {
+                        if (DFGArgumentsEliminationPhaseInternal::verbose)
+                            dataLog("eliminating candidate: ", candidate, " because it is live out of its block\n");
+                        transitivelyRemoveCandidate(candidate);
+                        return;
+                    }
+
+                    while (nodeIndex) {
+                        --nodeIndex;
+                        Node* node = block->at(nodeIndex);
+                        if (node == candidate)
+                            break;
+
+                        bool found = false;
+                        clobberize(
+                            m_graph, node, NoOpClobberize(),
+                            [&] (AbstractHeap heap) {
+                                if (writesToArrayElements(heap))
+                                    found = true;
+                            },
+                            NoOpClobberize());
+
+                        if (found) {
+                            if (DFGArgumentsEliminationPhaseInternal::verbose)
+                                dataLog("eliminating candidate: ", candidate, " because its array is clobbered by ", node, "\n");
+                            transitivelyRemoveCandidate(candidate);
+                            return;
+                        }
+                    }
+                });
+        }
+
         for (BasicBlock* block : m_graph.blocksInNaturalOrder()) {
             // Stop if we've already removed all candidates.
             if (m_candidates.isEmpty())
@@ -725,6 +802,19 @@ private:
                 case Spread:
                     if (!m_candidates.contains(node))
                         break;
+
+                    if (isSpreadOfExistingArray(node)) {
+                        // The elements get read straight out of the butterfly, so the array had better
+                        // have a shape we know how to read without running user code.
+                        ASSERT(node->origin.exitOK);
+                        JSGlobalObject* globalObject = m_graph.globalObjectFor(node->child1()->origin.semantic);
+                        RegisteredStructureSet structures;
+                        for (IndexingType indexingType : { ArrayWithInt32, ArrayWithDouble, ArrayWithContiguous, CopyOnWriteArrayWithInt32, CopyOnWriteArrayWithDouble, CopyOnWriteArrayWithContiguous })
+                            structures.add(m_graph.registerStructure(globalObject->originalArrayStructureForIndexingType(indexingType)));
+                        insertionSet.insertNode(
+                            nodeIndex, SpecNone, CheckStructure, node->origin,
+                            OpInfo(m_graph.addStructureSet(structures)), Edge(node->child1().node(), CellUse));
+                    }
                     
                     node->setOpAndDefaultFlags(PhantomSpread);
                     break;
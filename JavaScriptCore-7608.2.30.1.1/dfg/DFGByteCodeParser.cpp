@@ -6629,7 +6629,7 @@ void ByteCodeParser::parseBlock(unsigned limit)
         }
         
         case op_check_traps: {
-            addToGraph(Options::usePollingTraps() ? CheckTraps : InvalidationPoint);
+            addToGraph(m_vm->traps().shouldEmitPollingTrapChecks() ? CheckTraps : InvalidationPoint);
             NEXT_OPCODE(op_check_traps);
         }
 
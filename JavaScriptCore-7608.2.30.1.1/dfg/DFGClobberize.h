@@ -1387,9 +1387,17 @@ void clobberize(Graph& graph, Node* node, const ReadFunctor& read, const WriteFu
         read(HeapObjectCount);
         for (unsigned i = 0; i < node->numChildren(); i++) {
             Node* child = graph.varArgChild(node, i).node();
-            if (child->op() == PhantomSpread) {
-                read(Stack);
-                break;
+            if (child->op() != PhantomSpread)
+                continue;
+            read(Stack);
+            if (!child->child1()->isPhantomAllocation()) {
+                // The elements of a spread existing array are read out of its butterfly here.
+                read(JSCell_indexingType);
+                read(JSObject_butterfly);
+                read(Butterfly_publicLength);
+                read(IndexedInt32Properties);
+                read(IndexedDoubleProperties);
+                read(IndexedContiguousProperties);
             }
         }
         write(HeapObjectCount);
@@ -404,7 +404,7 @@ bool doesGC(Graph& graph, Node* node)
 
     case CheckTraps:
         // FIXME: https://bugs.webkit.org/show_bug.cgi?id=194323
-        ASSERT(Options::usePollingTraps());
+        ASSERT(graph.m_vm.traps().shouldEmitPollingTrapChecks());
         return true;
 
     case CompareEq:
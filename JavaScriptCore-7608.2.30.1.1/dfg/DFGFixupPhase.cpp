@@ -1950,6 +1950,12 @@ private:
             // So if it the type check succeeds for type T in the instructionTypeSet, a type check for type T 
             // in the globalTypeSet would've also succeeded.
             // (The other direction does not hold in general).
+            //
+            // In sampled mode, the instructionTypeSet only has the types of the values that happened to be
+            // logged. A check based on it could keep exiting on a type that the profiler never gets to
+            // record, so we keep the node and let it log its own samples.
+            if (vm().typeProfilerLog()->isSampling())
+                break;
 
             RefPtr<TypeSet> typeSet = node->typeLocation()->m_instructionTypeSet;
             RuntimeTypeMask seenTypes = typeSet->seenTypes();
@@ -1084,7 +1084,7 @@ void JIT_OPERATION OSRExit::compileOSRExit(ExecState* exec)
 
         compileExit(jit, *vm, exit, operands, recovery);
 
-        LinkBuffer patchBuffer(jit, codeBlock);
+        LinkBuffer patchBuffer(jit, codeBlock, JITCompilationMustSucceed, ExecutableMemoryPlacement::Cold);
         exit.m_code = FINALIZE_CODE_IF(
             shouldDumpDisassembly() || Options::verboseOSR() || Options::verboseDFGOSRExit(),
             patchBuffer, OSRExitPtrTag,
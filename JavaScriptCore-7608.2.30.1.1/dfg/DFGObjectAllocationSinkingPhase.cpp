@@ -815,6 +815,95 @@ private:
         } while (changed);
     }
 
+    // Identity comparisons and type queries never need the object itself once we know they are
+    // looking at an allocation that has not escaped: nothing else can hold a pointer to it, and its
+    // kind tells us its type. Answering them here keeps closures, iterator results and the like
+    // sinkable when user code checks them. Returns the empty value if the query must run.
+    JSValue resultOfQueryOnLocalAllocation(Node* node)
+    {
+        auto localAllocation = [&] (Edge edge) -> Allocation* {
+            Allocation* allocation = m_heap.onlyLocalAllocation(edge.node());
+            if (!allocation || allocation->isEscapedAllocation() || allocation->isActivationAllocation())
+                return nullptr;
+            if (!edge.willNotHaveCheck() && !alreadyChecked(edge.useKind(), SpecObject))
+                return nullptr;
+            return allocation;
+        };
+
+        switch (node->op()) {
+        case CompareStrictEq:
+        case SameValue: {
+            Allocation* left = localAllocation(node->child1());
+            Allocation* right = localAllocation(node->child2());
+            if (left && right)
+                return jsBoolean(left->identifier() == right->identifier());
+            // Dropping the other side's type check would be unsound.
+            if ((left && node->child2().willNotHaveCheck()) || (right && node->child1().willNotHaveCheck()))
+                return jsBoolean(false);
+            return JSValue();
+        }
+
+        case CompareEqPtr:
+            if (localAllocation(node->child1()))
+                return jsBoolean(false);
+            return JSValue();
+
+        case IsEmpty:
+        case IsUndefined:
+        case IsUndefinedOrNull:
+        case IsBoolean:
+        case IsNumber:
+        case IsTypedArrayView:
+        case IsObject:
+        case IsObjectOrNull:
+        case IsFunction:
+        case IsCellWithType:
+        case TypeOf: {
+            Allocation* allocation = localAllocation(node->child1());
+            if (!allocation)
+                return JSValue();
+
+            bool isFunction = false;
+            JSType type;
+            switch (allocation->kind()) {
+            case Allocation::Kind::Object:
+                type = FinalObjectType;
+                break;
+            case Allocation::Kind::RegExpObject:
+                type = RegExpObjectType;
+                break;
+            case Allocation::Kind::Function:
+            case Allocation::Kind::GeneratorFunction:
+            case Allocation::Kind::AsyncFunction:
+            case Allocation::Kind::AsyncGeneratorFunction:
+                type = JSFunctionType;
+                isFunction = true;
+                break;
+            default:
+                return JSValue();
+            }
+
+            switch (node->op()) {
+            case IsObject:
+                return jsBoolean(true);
+            case IsObjectOrNull:
+                return jsBoolean(!isFunction);
+            case IsFunction:
+                return jsBoolean(isFunction);
+            case IsCellWithType:
+                return jsBoolean(node->queriedType() == type);
+            case TypeOf:
+                return isFunction ? m_graph.m_vm.smallStrings.functionString() : m_graph.m_vm.smallStrings.objectString();
+            default:
+                return jsBoolean(false);
+            }
+        }
+
+        default:
+            return JSValue();
+        }
+    }
+
     template<typename WriteFunctor, typename ResolveFunctor>
     void handleNode(
         Node* node,
@@ -1084,6 +1173,30 @@ private:
                 });
             break;
 
+        case CompareStrictEq:
+        case SameValue:
+        case CompareEqPtr:
+        case IsEmpty:
+        case IsUndefined:
+        case IsUndefinedOrNull:
+        case IsBoolean:
+        case IsNumber:
+        case IsTypedArrayView:
+        case IsObject:
+        case IsObjectOrNull:
+        case IsFunction:
+        case IsCellWithType:
+        case TypeOf:
+            // promoteLocalHeap() replaces these with constants when we can answer them.
+            if (!resultOfQueryOnLocalAllocation(node)) {
+                m_graph.doToChildren(
+                    node,
+                    [&] (Edge edge) {
+                        m_heap.escape(edge.node());
+                    });
+            }
+            break;
+
         case MovHint:
         case PutHint:
             // Handled by OSR availability analysis
@@ -1885,6 +1998,8 @@ private:
 
                 bool desiredNextExitOK = node->origin.exitOK && !clobbersExitState(m_graph, node);
 
+                JSValue queryResult = resultOfQueryOnLocalAllocation(node);
+
                 bool doLower = false;
                 handleNode(
                     node,
@@ -1960,6 +2075,11 @@ private:
                     }
                 }
 
+                if (queryResult) {
+                    node->convertToConstant(m_graph.freeze(queryResult));
+                    continue;
+                }
+
                 m_graph.doToChildren(
                     node,
                     [&] (Edge& edge) {
@@ -2900,6 +2900,14 @@ void JIT_OPERATION operationProcessTypeProfilerLogDFG(ExecState* exec)
     vm.typeProfilerLog()->processLogEntries(vm, "Log Full, called from inside DFG."_s);
 }
 
+void JIT_OPERATION operationRecordTypeProfilerEvent(ExecState* exec, TypeLocation* location, EncodedJSValue encodedValue)
+{
+    VM& vm = exec->vm();
+    NativeCallFrameTracer tracer(&vm, exec);
+
+    vm.typeProfilerLog()->recordEvent(location, JSValue::decode(encodedValue));
+}
+
 EncodedJSValue JIT_OPERATION operationResolveScopeForHoistingFuncDeclInEval(ExecState* exec, JSScope* scope, UniquedStringImpl* impl)
 {
     VM& vm = exec->vm();
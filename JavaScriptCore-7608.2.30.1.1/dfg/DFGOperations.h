@@ -31,7 +31,11 @@
 #include "JITOperations.h"
 #include "TypedArrayType.h"
 
-namespace JSC { namespace DFG {
+namespace JSC {
+
+class TypeLocation;
+
+namespace DFG {
 
 struct OSRExitBase;
 
@@ -288,6 +292,7 @@ JSCell* JIT_OPERATION operationNewObjectWithButterfly(ExecState*, Structure*, Bu
 JSCell* JIT_OPERATION operationNewObjectWithButterflyWithIndexingHeaderAndVectorLength(ExecState*, Structure*, unsigned length, Butterfly*) WTF_INTERNAL;
 
 void JIT_OPERATION operationProcessTypeProfilerLogDFG(ExecState*) WTF_INTERNAL;
+void JIT_OPERATION operationRecordTypeProfilerEvent(ExecState*, TypeLocation*, EncodedJSValue) WTF_INTERNAL;
 
 void JIT_OPERATION triggerReoptimizationNow(CodeBlock* baselineCodeBlock, CodeBlock* optiimzedCodeBlock, OSRExitBase*) WTF_INTERNAL;
 
@@ -28,6 +28,7 @@
 
 #if ENABLE(DFG_JIT)
 
+#include "CompilerTimingScope.h"
 #include "DFGArgumentsEliminationPhase.h"
 #include "DFGBackwardsPropagationPhase.h"
 #include "DFGByteCodeParser.h"
@@ -183,6 +184,11 @@ void Plan::compileInThread(ThreadData* threadData)
 
     CompilationScope compilationScope;
 
+    // Keep the profiler compilation alive even if the plan is cancelled while we compile, since
+    // the timing scopes of the phases that are still running will report to it.
+    RefPtr<Profiler::Compilation> compilation = m_compilation;
+    CompilerTimingRecordScope timingRecordScope(compilation.get());
+
     if (logCompilationChanges(m_mode) || Options::logPhaseTimes())
         dataLog("DFG(Plan) compiling ", *m_codeBlock, " with ", m_mode, ", instructions size = ", m_codeBlock->instructionsSize(), "\n");
 
@@ -204,6 +210,15 @@ void Plan::compileInThread(ThreadData* threadData)
                 totalDFGCompileTime += after - before;
         }
     }
+    if (UNLIKELY(compilation) && path != CancelPath) {
+        compilation->setBytecodeSize(m_codeBlock->instructionsSize());
+        unsigned inlinedBytecodeSize = 0;
+        for (auto* inlineCallFrame : *m_inlineCallFrames)
+            inlinedBytecodeSize += inlineCallFrame->baselineCodeBlock->instructionsSize();
+        compilation->setInlinedBytecodeSize(inlinedBytecodeSize);
+        compilation->setMachineCodeSize(m_finalizer->codeSize());
+        compilation->setCompileTime(after - before);
+    }
     const char* pathName = nullptr;
     switch (path) {
     case FailPath:
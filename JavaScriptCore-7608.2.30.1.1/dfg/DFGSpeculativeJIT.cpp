@@ -2044,7 +2044,7 @@ void SpeculativeJIT::linkOSREntries(LinkBuffer& linkBuffer)
     
 void SpeculativeJIT::compileCheckTraps(Node* node)
 {
-    ASSERT(Options::usePollingTraps());
+    ASSERT(m_jit.vm()->traps().shouldEmitPollingTrapChecks());
     GPRTemporary unused(this);
     GPRReg unusedGPR = unused.gpr();
 
@@ -13402,6 +13402,8 @@ void SpeculativeJIT::compileProfileType(Node* node)
     // Load the TypeProfilerLog into Scratch2.
     TypeProfilerLog* cachedTypeProfilerLog = m_jit.vm()->typeProfilerLog();
     m_jit.move(TrustedImmPtr(cachedTypeProfilerLog), scratch2GPR);
+    if (cachedTypeProfilerLog->isSampling())
+        jumpToEnd.append(m_jit.branchIfTypeProfilerEventNotSampled(cachedTypeProfilerLog, scratch2GPR, scratch1GPR));
 
     // Load the next LogEntry into Scratch1.
     m_jit.loadPtr(MacroAssembler::Address(scratch2GPR, TypeProfilerLog::currentLogEntryOffset()), scratch1GPR);
@@ -850,8 +850,8 @@ private:
 
                 case PhantomSpread:
                     VALIDATE((node), m_graph.m_form == SSA);
-                    // We currently support PhantomSpread over PhantomCreateRest and PhantomNewArrayBuffer.
-                    VALIDATE((node), node->child1()->op() == PhantomCreateRest || node->child1()->op() == PhantomNewArrayBuffer);
+                    // We currently support PhantomSpread over PhantomCreateRest, PhantomNewArrayBuffer and existing arrays.
+                    VALIDATE((node), !node->child1()->isPhantomAllocation() || node->child1()->op() == PhantomCreateRest || node->child1()->op() == PhantomNewArrayBuffer);
                     break;
 
                 case PhantomNewArrayWithSpread: {
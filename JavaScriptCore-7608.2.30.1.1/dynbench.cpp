@@ -27,6 +27,8 @@
 
 #include "Identifier.h"
 #include "InitializeThreading.h"
+#include "IntlDateTimeFormat.h"
+#include "IntlNumberFormat.h"
 #include "JSCInlines.h"
 #include "JSCJSValue.h"
 #include "JSGlobalObject.h"
@@ -235,6 +237,44 @@ int main(int argc, char** argv)
                     }
                 }
             });
+
+#if ENABLE(INTL)
+        // Number.prototype.toLocaleString creates a new NumberFormat for every call:
+        JSValue enUS = jsString(exec, "en-US");
+        benchmarkImpl(
+            "Intl Number toLocaleString",
+            100000,
+            [&] (unsigned iterationCount) {
+                for (unsigned i = iterationCount; i--;) {
+                    IntlNumberFormat* numberFormat = IntlNumberFormat::create(*vm, globalObject->numberFormatStructure());
+                    numberFormat->initializeNumberFormat(*exec, enUS, jsUndefined());
+                    CHECK(numberFormat->formatNumber(*exec, 1234567.5).isString());
+                }
+            });
+
+        // Reusing one NumberFormat:
+        IntlNumberFormat* numberFormat = IntlNumberFormat::create(*vm, globalObject->numberFormatStructure());
+        numberFormat->initializeNumberFormat(*exec, enUS, jsUndefined());
+        benchmarkImpl(
+            "Intl Number Format Reuse",
+            1000000,
+            [&] (unsigned iterationCount) {
+                for (unsigned i = iterationCount; i--;)
+                    CHECK(numberFormat->formatNumber(*exec, i + 0.25).isString());
+            });
+
+        // Date.prototype.toLocaleString creates a new DateTimeFormat for every call:
+        benchmarkImpl(
+            "Intl Date toLocaleString",
+            10000,
+            [&] (unsigned iterationCount) {
+                for (unsigned i = iterationCount; i--;) {
+                    IntlDateTimeFormat* dateTimeFormat = IntlDateTimeFormat::create(*vm, globalObject->dateTimeFormatStructure());
+                    dateTimeFormat->initializeDateTimeFormat(*exec, enUS, jsUndefined());
+                    CHECK(dateTimeFormat->format(*exec, 1500000000000.0 + i).isString());
+                }
+            });
+#endif // ENABLE(INTL)
     }
 
     crashLock.lock();
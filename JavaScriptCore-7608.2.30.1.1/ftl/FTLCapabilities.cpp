@@ -37,7 +37,7 @@ static bool verboseCapabilities()
     return verboseCompilationEnabled() || Options::verboseFTLFailure();
 }
 
-inline CapabilityLevel canCompile(Node* node)
+inline CapabilityLevel canCompile(Graph& graph, Node* node)
 {
     // NOTE: If we ever have phantom arguments, we can compile them but we cannot
     // OSR enter.
@@ -378,9 +378,17 @@ inline CapabilityLevel canCompile(Node* node)
     case DataViewGetInt:
     case DataViewGetFloat:
     case DataViewSet:
+    case ProfileControlFlow:
         // These are OK.
         break;
 
+    case ProfileType:
+        // Writing every value to the log inline isn't worth it in the FTL, but in sampled mode
+        // most values never leave the fast path.
+        if (!graph.m_vm.typeProfilerLog()->isSampling())
+            return CannotCompile;
+        break;
+
     case Identity:
         // No backend handles this because it will be optimized out. But we may check
         // for capabilities before optimization. It would be a deep error to remove this
@@ -394,8 +402,6 @@ inline CapabilityLevel canCompile(Node* node)
     case CheckTierUpAtReturn:
     case FiatInt52:
     case ArithIMul:
-    case ProfileType:
-    case ProfileControlFlow:
     case LastNodeType:
         return CannotCompile;
     }
@@ -490,7 +496,7 @@ CapabilityLevel canCompile(Graph& graph)
                 }
             }
             
-            switch (canCompile(node)) {
+            switch (canCompile(graph, node)) {
             case CannotCompile: 
                 if (verboseCapabilities()) {
                     dataLog("FTL rejecting node in ", *graph.m_codeBlock, ":\n");
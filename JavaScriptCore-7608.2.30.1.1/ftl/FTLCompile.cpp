@@ -64,6 +64,11 @@ void compile(State& state, Safepoint::Result& safepointResult)
     if (shouldDumpDisassembly())
         state.proc->code().setDisassembler(std::make_unique<B3::Air::Disassembler>());
 
+    // Slow paths and OSR exits get linked into cold memory, so the code we expect to run stays dense.
+    // The disassembler and the PC to code origin map both expect one contiguous range of code.
+    if (Options::useFTLColdCode() && !shouldDumpDisassembly() && !vm.shouldBuilderPCToCodeOriginMapping())
+        state.proc->setSeparatesRareCode(true);
+
     {
         GraphSafepoint safepoint(state.graph, safepointResult);
 
@@ -150,7 +155,7 @@ void compile(State& state, Safepoint::Result& safepointResult)
     }
     
     B3::PCToOriginMap originMap = state.proc->releasePCToOriginMap();
-    if (vm.shouldBuilderPCToCodeOriginMapping())
+    if (vm.shouldBuilderPCToCodeOriginMapping() && !state.finalizer->b3CodeLinkBuffer->coldExecutableMemory())
         codeBlock->setPCToCodeOriginMap(std::make_unique<PCToCodeOriginMap>(PCToCodeOriginMapBuilder(vm, WTFMove(originMap)), *state.finalizer->b3CodeLinkBuffer));
 
     CodeLocationLabel<JSEntryPtrTag> label = state.finalizer->b3CodeLinkBuffer->locationOf<JSEntryPtrTag>(state.proc->entrypointLabel(0));
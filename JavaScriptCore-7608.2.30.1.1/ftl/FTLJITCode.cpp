@@ -51,9 +51,10 @@ JITCode::~JITCode()
     }
 }
 
-void JITCode::initializeB3Code(CodeRef<JSEntryPtrTag> b3Code)
+void JITCode::initializeB3Code(CodeRef<JSEntryPtrTag> b3Code, RefPtr<ExecutableMemoryHandle> coldCode)
 {
     m_b3Code = b3Code;
+    m_b3ColdCode = WTFMove(coldCode);
 }
 
 void JITCode::initializeB3Byproducts(std::unique_ptr<OpaqueByproducts> byproducts)
@@ -51,7 +51,7 @@ public:
     size_t size() override;
     bool contains(void*) override;
 
-    void initializeB3Code(CodeRef<JSEntryPtrTag>);
+    void initializeB3Code(CodeRef<JSEntryPtrTag>, RefPtr<ExecutableMemoryHandle> coldCode);
     void initializeB3Byproducts(std::unique_ptr<B3::OpaqueByproducts>);
     void initializeAddressForCall(CodePtr<JSEntryPtrTag>);
     void initializeArityCheckEntrypoint(CodeRef<JSEntryPtrTag>);
@@ -76,6 +76,7 @@ public:
 private:
     CodePtr<JSEntryPtrTag> m_addressForCall;
     CodeRef<JSEntryPtrTag> m_b3Code;
+    RefPtr<ExecutableMemoryHandle> m_b3ColdCode;
     std::unique_ptr<B3::OpaqueByproducts> m_b3Byproducts;
     CodeRef<JSEntryPtrTag> m_arityCheckEntrypoint;
 };
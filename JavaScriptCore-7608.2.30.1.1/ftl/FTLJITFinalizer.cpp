@@ -82,7 +82,7 @@ bool JITFinalizer::finalizeCommon()
             "FTL entrypoint thunk for %s with B3 generated code at %p", toCString(CodeBlockWithJITType(m_plan.codeBlock(), JITType::FTLJIT)).data(), function)
         : MacroAssemblerCodeRef<JSEntryPtrTag>::createSelfManagedCodeRef(b3CodeRef.code());
 
-    jitCode->initializeB3Code(b3CodeRef);
+    jitCode->initializeB3Code(b3CodeRef, b3CodeLinkBuffer->coldExecutableMemory());
     jitCode->initializeArityCheckEntrypoint(arityCheckCodeRef);
 
     m_plan.codeBlock()->setJITCode(*jitCode);
@@ -63,7 +63,7 @@ void LazySlowPath::generate(CodeBlock* codeBlock)
 
     m_generator->run(jit, params);
 
-    LinkBuffer linkBuffer(jit, codeBlock, JITCompilationMustSucceed);
+    LinkBuffer linkBuffer(jit, codeBlock, JITCompilationMustSucceed, ExecutableMemoryPlacement::Cold);
     linkBuffer.link(params.doneJumps, m_done);
     if (m_exceptionTarget)
         linkBuffer.link(exceptionJumps, m_exceptionTarget);
@@ -93,6 +93,7 @@
 #include "StructureStubInfo.h"
 #include "SuperSampler.h"
 #include "ThunkGenerators.h"
+#include "TypeProfilerLog.h"
 #include "VirtualRegister.h"
 #include "Watchdog.h"
 #include <atomic>
@@ -1466,6 +1467,12 @@ private:
         case LogShadowChickenTail:
             compileLogShadowChickenTail();
             break;
+        case ProfileType:
+            compileProfileType();
+            break;
+        case ProfileControlFlow:
+            compileProfileControlFlow();
+            break;
         case RecordRegExpCachedResult:
             compileRecordRegExpCachedResult();
             break;
@@ -6063,6 +6070,9 @@ private:
                                 return getSpreadLengthFromInlineCallFrame(inlineCallFrame, numberOfArgumentsToSkip);
                             }).iterator->value;
                             lengthCheck = m_out.speculateAdd(length, spreadLength);
+                        } else if (!use->child1()->isPhantomAllocation()) {
+                            LValue butterfly = m_out.loadPtr(lowCell(use->child1()), m_heaps.JSObject_butterfly);
+                            lengthCheck = m_out.speculateAdd(length, m_out.load32NonNegative(butterfly, m_heaps.Butterfly_publicLength));
                         }
                     } else {
                         LValue fixedArray = lowCell(use);
@@ -6099,6 +6109,84 @@ private:
                                 m_out.store64(m_out.constInt64(value), m_out.baseIndex(heap, storage, index, JSValue(), (Checked<int32_t>(sizeof(JSValue)) * i).unsafeGet()));
                             }
                             index = m_out.add(index, m_out.constIntPtr(array->length()));
+                        } else if (!use->child1()->isPhantomAllocation()) {
+                            // Arguments elimination checked that this array has an original Int32, Double or
+                            // Contiguous array structure, and that nothing wrote to it since it was spread.
+                            LValue array = lowCell(use->child1());
+                            LValue butterfly = m_out.loadPtr(array, m_heaps.JSObject_butterfly);
+                            LValue length = m_out.zeroExtPtr(m_out.load32NonNegative(butterfly, m_heaps.Butterfly_publicLength));
+                            LValue indexingShape = m_out.bitAnd(
+                                m_out.load8ZeroExt32(array, m_heaps.JSCell_indexingTypeAndMisc),
+                                m_out.constInt32(IndexingShapeMask));
+
+                            LBasicBlock loopSelection = m_out.newBlock();
+                            LBasicBlock contiguousLoopStart = m_out.newBlock();
+                            LBasicBlock doubleLoopStart = m_out.newBlock();
+                            LBasicBlock continuation = m_out.newBlock();
+
+                            ValueFromBlock arrayIndexStartForFinish = m_out.anchor(index);
+
+                            m_out.branch(
+                                m_out.isZero64(length),
+                                unsure(continuation), unsure(loopSelection));
+
+                            LBasicBlock lastNext = m_out.appendTo(loopSelection, contiguousLoopStart);
+                            ValueFromBlock loadIndexStartForContiguous = m_out.anchor(m_out.constIntPtr(0));
+                            ValueFromBlock arrayIndexStartForContiguous = m_out.anchor(index);
+                            ValueFromBlock loadIndexStartForDouble = m_out.anchor(m_out.constIntPtr(0));
+                            ValueFromBlock arrayIndexStartForDouble = m_out.anchor(index);
+                            m_out.branch(
+                                m_out.equal(indexingShape, m_out.constInt32(DoubleShape)),
+                                unsure(doubleLoopStart), unsure(contiguousLoopStart));
+
+                            ValueFromBlock arrayIndexContiguousLoopForFinish;
+                            {
+                                m_out.appendTo(contiguousLoopStart, doubleLoopStart);
+                                LValue arrayIndex = m_out.phi(pointerType(), arrayIndexStartForContiguous);
+                                LValue loadIndex = m_out.phi(pointerType(), loadIndexStartForContiguous);
+
+                                TypedPointer loadSite = m_out.baseIndex(m_heaps.root, butterfly, loadIndex, ScaleEight); // We read TOP here since we can be reading either int32 or contiguous properties.
+                                LValue item = m_out.load64(loadSite);
+                                item = m_out.select(m_out.isZero64(item), m_out.constInt64(JSValue::encode(jsUndefined())), item);
+                                m_out.store64(item, m_out.baseIndex(m_heaps.indexedContiguousProperties, storage, arrayIndex));
+
+                                LValue nextArrayIndex = m_out.add(arrayIndex, m_out.constIntPtr(1));
+                                LValue nextLoadIndex = m_out.add(loadIndex, m_out.constIntPtr(1));
+                                arrayIndexContiguousLoopForFinish = m_out.anchor(nextArrayIndex);
+
+                                m_out.addIncomingToPhi(loadIndex, m_out.anchor(nextLoadIndex));
+                                m_out.addIncomingToPhi(arrayIndex, m_out.anchor(nextArrayIndex));
+
+                                m_out.branch(
+                                    m_out.below(nextLoadIndex, length),
+                                    unsure(contiguousLoopStart), unsure(continuation));
+                            }
+
+                            ValueFromBlock arrayIndexDoubleLoopForFinish;
+                            {
+                                m_out.appendTo(doubleLoopStart, continuation);
+                                LValue arrayIndex = m_out.phi(pointerType(), arrayIndexStartForDouble);
+                                LValue loadIndex = m_out.phi(pointerType(), loadIndexStartForDouble);
+
+                                LValue value = m_out.loadDouble(m_out.baseIndex(m_heaps.indexedDoubleProperties, butterfly, loadIndex));
+                                LValue isNaN = m_out.doubleNotEqualOrUnordered(value, value);
+                                LValue item = m_out.select(isNaN, m_out.constInt64(JSValue::encode(jsUndefined())), boxDouble(value));
+                                m_out.store64(item, m_out.baseIndex(m_heaps.indexedContiguousProperties, storage, arrayIndex));
+
+                                LValue nextArrayIndex = m_out.add(arrayIndex, m_out.constIntPtr(1));
+                                LValue nextLoadIndex = m_out.add(loadIndex, m_out.constIntPtr(1));
+                                arrayIndexDoubleLoopForFinish = m_out.anchor(nextArrayIndex);
+
+                                m_out.addIncomingToPhi(loadIndex, m_out.anchor(nextLoadIndex));
+                                m_out.addIncomingToPhi(arrayIndex, m_out.anchor(nextArrayIndex));
+
+                                m_out.branch(
+                                    m_out.below(nextLoadIndex, length),
+                                    unsure(doubleLoopStart), unsure(continuation));
+                            }
+
+                            m_out.appendTo(continuation, lastNext);
+                            index = m_out.phi(pointerType(), arrayIndexStartForFinish, arrayIndexContiguousLoopForFinish, arrayIndexDoubleLoopForFinish);
                         } else {
                             RELEASE_ASSERT(use->child1()->op() == PhantomCreateRest);
                             InlineCallFrame* inlineCallFrame = use->child1()->origin.semantic.inlineCallFrame();
@@ -10915,39 +11003,61 @@ private:
 
     void compileGetDirectPname()
     {
-        LValue base = lowCell(m_graph.varArgChild(m_node, 0));
+        Edge baseEdge = m_graph.varArgChild(m_node, 0);
+        LValue base = lowCell(baseEdge);
         LValue property = lowCell(m_graph.varArgChild(m_node, 1));
         LValue index = lowInt32(m_graph.varArgChild(m_node, 2));
         LValue enumerator = lowCell(m_graph.varArgChild(m_node, 3));
 
-        LBasicBlock checkOffset = m_out.newBlock();
-        LBasicBlock inlineLoad = m_out.newBlock();
-        LBasicBlock outOfLineLoad = m_out.newBlock();
+        // Once the base's structure matches the enumerator's, the enumerator's inline capacity is
+        // that structure's, so a proven structure lets us fold the capacity and drop whichever
+        // kind of storage the structure cannot have.
+        RegisteredStructure structure = m_state.forNode(baseEdge).m_structure.onlyStructure();
+        bool mayBeInline = !structure || structure->inlineCapacity();
+        bool mayBeOutOfLine = !structure || structure->outOfLineCapacity();
+
+        if (!mayBeInline && !mayBeOutOfLine) {
+            // The structure has no property storage, so there is no slot for a fast path to read.
+            setJSValue(vmCall(Int64, m_out.operation(operationGetByVal), m_callFrame, base, property));
+            return;
+        }
+
+        LBasicBlock fastPath = m_out.newBlock();
         LBasicBlock slowCase = m_out.newBlock();
         LBasicBlock continuation = m_out.newBlock();
 
+        LValue structureID = structure ? weakStructureID(structure) : m_out.load32(base, m_heaps.JSCell_structureID);
         m_out.branch(m_out.notEqual(
-            m_out.load32(base, m_heaps.JSCell_structureID),
+            structureID,
             m_out.load32(enumerator, m_heaps.JSPropertyNameEnumerator_cachedStructureID)),
-            rarely(slowCase), usually(checkOffset));
-
-        LBasicBlock lastNext = m_out.appendTo(checkOffset, inlineLoad);
-        m_out.branch(m_out.aboveOrEqual(index, m_out.load32(enumerator, m_heaps.JSPropertyNameEnumerator_cachedInlineCapacity)),
-            unsure(outOfLineLoad), unsure(inlineLoad));
-
-        m_out.appendTo(inlineLoad, outOfLineLoad);
-        ValueFromBlock inlineResult = m_out.anchor(
-            m_out.load64(m_out.baseIndex(m_heaps.properties.atAnyNumber(), 
-                base, m_out.zeroExt(index, Int64), ScaleEight, JSObject::offsetOfInlineStorage())));
-        m_out.jump(continuation);
-
-        m_out.appendTo(outOfLineLoad, slowCase);
-        LValue storage = m_out.loadPtr(base, m_heaps.JSObject_butterfly);
-        LValue realIndex = m_out.signExt32To64(
-            m_out.neg(m_out.sub(index, m_out.load32(enumerator, m_heaps.JSPropertyNameEnumerator_cachedInlineCapacity))));
-        int32_t offsetOfFirstProperty = static_cast<int32_t>(offsetInButterfly(firstOutOfLineOffset)) * sizeof(EncodedJSValue);
-        ValueFromBlock outOfLineResult = m_out.anchor(
-            m_out.load64(m_out.baseIndex(m_heaps.properties.atAnyNumber(), storage, realIndex, ScaleEight, offsetOfFirstProperty)));
+            rarely(slowCase), usually(fastPath));
+
+        LBasicBlock lastNext = m_out.appendTo(fastPath, slowCase);
+        LValue inlineCapacity = structure
+            ? m_out.constInt32(structure->inlineCapacity())
+            : m_out.load32(enumerator, m_heaps.JSPropertyNameEnumerator_cachedInlineCapacity);
+
+        LValue inlineSlot = nullptr;
+        if (mayBeInline) {
+            inlineSlot = m_out.baseIndex(m_heaps.properties.atAnyNumber(),
+                base, m_out.zeroExt(index, Int64), ScaleEight, JSObject::offsetOfInlineStorage()).value();
+        }
+        LValue outOfLineSlot = nullptr;
+        if (mayBeOutOfLine) {
+            LValue storage = m_out.loadPtr(base, m_heaps.JSObject_butterfly);
+            LValue realIndex = m_out.signExt32To64(m_out.neg(m_out.sub(index, inlineCapacity)));
+            int32_t offsetOfFirstProperty = static_cast<int32_t>(offsetInButterfly(firstOutOfLineOffset)) * sizeof(EncodedJSValue);
+            outOfLineSlot = m_out.baseIndex(m_heaps.properties.atAnyNumber(), storage, realIndex, ScaleEight, offsetOfFirstProperty).value();
+        }
+
+        // Objects in serialization loops usually have both kinds of storage, so pick the slot
+        // with a select rather than a branch that flips partway through every iteration.
+        LValue slot;
+        if (inlineSlot && outOfLineSlot)
+            slot = m_out.select(m_out.below(index, inlineCapacity), inlineSlot, outOfLineSlot);
+        else
+            slot = inlineSlot ? inlineSlot : outOfLineSlot;
+        ValueFromBlock fastResult = m_out.anchor(m_out.load64(TypedPointer(m_heaps.properties.atAnyNumber(), slot)));
         m_out.jump(continuation);
 
         m_out.appendTo(slowCase, continuation);
@@ -10956,7 +11066,7 @@ private:
         m_out.jump(continuation);
 
         m_out.appendTo(continuation, lastNext);
-        setJSValue(m_out.phi(Int64, inlineResult, outOfLineResult, slowCaseResult));
+        setJSValue(m_out.phi(Int64, fastResult, slowCaseResult));
     }
 
     void compileGetEnumerableLength()
@@ -11415,7 +11525,7 @@ private:
 
     void compileCheckTraps()
     {
-        ASSERT(Options::usePollingTraps());
+        ASSERT(vm().traps().shouldEmitPollingTrapChecks());
         LBasicBlock needTrapHandling = m_out.newBlock();
         LBasicBlock continuation = m_out.newBlock();
         
@@ -11667,6 +11777,38 @@ private:
         m_out.store32(m_out.constInt32(callSiteIndex.bits()), packet, m_heaps.ShadowChicken_Packet_callSiteIndex);
     }
 
+    void compileProfileType()
+    {
+        // We only get here when the type profiler is sampling (see FTLCapabilities), so count
+        // down inline and only leave the fast path for the values that are recorded. Unlike the
+        // baseline and DFG code we don't bother with the predictive type check: the countdown
+        // already filters out most values.
+        LValue value = lowJSValue(m_node->child1());
+        TypeProfilerLog* typeProfilerLog = vm().typeProfilerLog();
+        ASSERT(typeProfilerLog->isSampling());
+
+        LBasicBlock recordEvent = m_out.newBlock();
+        LBasicBlock continuation = m_out.newBlock();
+
+        TypedPointer countdown = m_out.absolute(typeProfilerLog->addressOfSamplingCountdown());
+        LValue newCountdown = m_out.sub(m_out.load32(countdown), m_out.int32One);
+        m_out.store32(newCountdown, countdown);
+        m_out.branch(m_out.isZero32(newCountdown), rarely(recordEvent), usually(continuation));
+
+        LBasicBlock lastNext = m_out.appendTo(recordEvent, continuation);
+        m_out.store32(m_out.constInt32(typeProfilerLog->samplingInterval()), countdown);
+        vmCall(Void, m_out.operation(operationRecordTypeProfilerEvent), m_callFrame, m_out.constIntPtr(m_node->typeLocation()), value);
+        m_out.jump(continuation);
+
+        m_out.appendTo(continuation, lastNext);
+    }
+
+    void compileProfileControlFlow()
+    {
+        TypedPointer executionCount = m_out.absolute(m_node->basicBlockLocation()->addressOfExecutionCount());
+        m_out.store64(m_out.add(m_out.load64(executionCount), m_out.constInt64(1)), executionCount);
+    }
+
     void compileRecordRegExpCachedResult()
     {
         Edge globalObjectEdge = m_graph.varArgChild(m_node, 0);
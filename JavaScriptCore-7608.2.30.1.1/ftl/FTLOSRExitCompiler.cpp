@@ -476,7 +476,7 @@ static void compileStub(
     reifyInlinedCallFrames(jit, exit);
     adjustAndJumpToTarget(*vm, jit, exit);
     
-    LinkBuffer patchBuffer(jit, codeBlock);
+    LinkBuffer patchBuffer(jit, codeBlock, JITCompilationMustSucceed, ExecutableMemoryPlacement::Cold);
     exit.m_code = FINALIZE_CODE_IF(
         shouldDumpDisassembly() || Options::verboseOSR() || Options::verboseFTLOSRExit(),
         patchBuffer, OSRExitPtrTag,
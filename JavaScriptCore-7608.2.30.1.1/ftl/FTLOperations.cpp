@@ -453,8 +453,11 @@ extern "C" JSCell* JIT_OPERATION operationMaterializeObjectInOSR(
 
         // Note: it is sound for JSFixedArray::createFromArray to call getDirectIndex here
         // because we're guaranteed we won't be calling any getters. The reason for this is
-        // that we only support PhantomSpread over CreateRest, which is an array we create.
-        // Any attempts to put a getter on any indices on the rest array will escape the array.
+        // that we only support PhantomSpread over CreateRest, which is an array we create,
+        // and over existing arrays that were checked to have an original Int32, Double or
+        // Contiguous array structure. Any attempts to put a getter on any indices on the rest
+        // array will escape the array, and nothing writes to an existing array while its
+        // spread is live.
         JSFixedArray* fixedArray = JSFixedArray::createFromArray(exec, vm, array);
         RELEASE_ASSERT(fixedArray);
         return fixedArray;
@@ -123,7 +123,7 @@ static MacroAssemblerCodeRef<JITThunkPtrTag> genericGenerationThunkGenerator(
 #endif
     jit.ret();
     
-    LinkBuffer patchBuffer(jit, GLOBAL_THUNK_ID);
+    LinkBuffer patchBuffer(jit, GLOBAL_THUNK_ID, JITCompilationMustSucceed, ExecutableMemoryPlacement::Cold);
     patchBuffer.link(functionCall, generationFunction.retagged<OperationPtrTag>());
     return FINALIZE_CODE(patchBuffer, JITThunkPtrTag, "%s", name);
 }
@@ -229,7 +229,7 @@ MacroAssemblerCodeRef<JITThunkPtrTag> slowPathCallThunkGenerator(const SlowPathC
     
     jit.ret();
 
-    LinkBuffer patchBuffer(jit, GLOBAL_THUNK_ID);
+    LinkBuffer patchBuffer(jit, GLOBAL_THUNK_ID, JITCompilationMustSucceed, ExecutableMemoryPlacement::Cold);
     patchBuffer.link(call, key.callTarget());
     return FINALIZE_CODE(patchBuffer, JITThunkPtrTag, "FTL slow path call thunk for %s", toCString(key).data());
 }
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "AllocationSiteProfiler.h"
+
+#include "HeapCell.h"
+#include "JSCInlines.h"
+#include "StackVisitor.h"
+#include "VM.h"
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC {
+
+namespace {
+
+class CaptureAllocationSiteFunctor {
+public:
+    CaptureAllocationSiteFunctor(StringBuilder& key, Vector<std::tuple<String, String, unsigned, unsigned>>& frames, unsigned maxDepth)
+        : m_key(key)
+        , m_frames(frames)
+        , m_maxDepth(maxDepth)
+    {
+    }
+
+    StackVisitor::Status operator()(StackVisitor& visitor) const
+    {
+        if (m_frames.size() >= m_maxDepth)
+            return StackVisitor::Done;
+
+        unsigned line = 0;
+        unsigned column = 0;
+        if (visitor->hasLineAndColumnInfo())
+            visitor->computeLineAndColumn(line, column);
+        String functionName = visitor->functionName();
+        String sourceURL = visitor->sourceURL();
+
+        m_key.append(functionName);
+        m_key.append('@');
+        m_key.append(sourceURL);
+        m_key.append(':');
+        m_key.appendNumber(line);
+        m_key.append(':');
+        m_key.appendNumber(column);
+        m_key.append('\n');
+
+        m_frames.append(std::make_tuple(WTFMove(functionName), WTFMove(sourceURL), line, column));
+        return StackVisitor::Continue;
+    }
+
+private:
+    StringBuilder& m_key;
+    Vector<std::tuple<String, String, unsigned, unsigned>>& m_frames;
+    unsigned m_maxDepth;
+};
+
+} // anonymous namespace
+
+AllocationSiteProfiler::AllocationSiteProfiler(VM& vm, size_t samplingInterval)
+    : m_vm(vm)
+    , m_samplingInterval(std::max<size_t>(samplingInterval, 1))
+    , m_weakRandom()
+{
+    m_bytesUntilNextSample = nextSampleDistance();
+}
+
+AllocationSiteProfiler::~AllocationSiteProfiler()
+{
+}
+
+size_t AllocationSiteProfiler::nextSampleDistance()
+{
+    // Sampling points form a Poisson process over allocated bytes, so the distance to the next one is
+    // exponentially distributed around the sampling interval.
+    double random = m_weakRandom.get();
+    double distance = -std::log1p(-random) * static_cast<double>(m_samplingInterval);
+    return std::max<size_t>(static_cast<size_t>(distance), 1);
+}
+
+void AllocationSiteProfiler::takeSample(HeapCell* cell, size_t bytesAllocated)
+{
+    // Each sampling point we crossed stands for m_samplingInterval bytes of allocation on average.
+    size_t weight = 0;
+    while (bytesAllocated >= m_bytesUntilNextSample) {
+        bytesAllocated -= m_bytesUntilNextSample;
+        weight += m_samplingInterval;
+        m_bytesUntilNextSample = nextSampleDistance();
+    }
+    m_bytesUntilNextSample -= bytesAllocated;
+
+    if (!cell)
+        return;
+
+    auto locker = holdLock(m_lock);
+    unsigned siteIndex = siteIndexForCurrentStack();
+    Site& site = m_sites[siteIndex];
+    site.allocatedBytes += weight;
+    site.totalSamples++;
+
+    auto addResult = m_samples.add(cell, Sample { siteIndex, weight });
+    if (!addResult.isNewEntry) {
+        // The cell died and got reallocated without a collection noticing, which can only happen if
+        // it was freed by a collection that ran before we started tracking it.
+        Sample& previous = addResult.iterator->value;
+        Site& previousSite = m_sites[previous.siteIndex];
+        previousSite.liveBytes -= previous.weight;
+        previousSite.liveSamples--;
+        previous = Sample { siteIndex, weight };
+    }
+    site.liveBytes += weight;
+    site.liveSamples++;
+}
+
+unsigned AllocationSiteProfiler::siteIndexForCurrentStack()
+{
+    StringBuilder key;
+    Vector<std::tuple<String, String, unsigned, unsigned>> frames;
+    if (m_vm.topCallFrame) {
+        CaptureAllocationSiteFunctor functor(key, frames, Options::allocationSiteProfilerMaxStackDepth());
+        StackVisitor::visit(m_vm.topCallFrame, &m_vm, functor);
+    }
+
+    auto addResult = m_siteIndices.add(key.toString(), m_sites.size());
+    if (addResult.isNewEntry) {
+        Site site;
+        for (auto& frame : frames)
+            site.frames.append(Frame { WTFMove(std::get<0>(frame)), WTFMove(std::get<1>(frame)), std::get<2>(frame), std::get<3>(frame) });
+        m_sites.append(WTFMove(site));
+    }
+    return addResult.iterator->value;
+}
+
+void AllocationSiteProfiler::removeDeadSamples()
+{
+    auto locker = holdLock(m_lock);
+    m_samples.removeIf(
+        [&] (auto& entry) -> bool {
+            if (entry.key->isLive())
+                return false;
+            Site& site = m_sites[entry.value.siteIndex];
+            site.liveBytes -= entry.value.weight;
+            site.liveSamples--;
+            return true;
+        });
+}
+
+void AllocationSiteProfiler::clear()
+{
+    auto locker = holdLock(m_lock);
+    m_samples.clear();
+    m_sites.clear();
+    m_siteIndices.clear();
+}
+
+Vector<unsigned> AllocationSiteProfiler::siteIndicesByLiveBytes() const
+{
+    Vector<unsigned> result;
+    for (unsigned i = 0; i < m_sites.size(); ++i) {
+        if (m_sites[i].liveSamples)
+            result.append(i);
+    }
+    std::sort(result.begin(), result.end(),
+        [&] (unsigned a, unsigned b) {
+            return m_sites[a].liveBytes > m_sites[b].liveBytes;
+        });
+    return result;
+}
+
+void AllocationSiteProfiler::dump(PrintStream& out) const
+{
+    auto locker = holdLock(m_lock);
+    out.print("Live bytes by allocation site (sampling interval ", m_samplingInterval, " bytes):\n");
+    for (unsigned siteIndex : siteIndicesByLiveBytes()) {
+        const Site& site = m_sites[siteIndex];
+        out.print("    ", site.liveBytes, " live / ", site.allocatedBytes, " allocated bytes (", site.liveSamples, " of ", site.totalSamples, " samples live)\n");
+        if (site.frames.isEmpty())
+            out.print("        <no JS frames>\n");
+        for (const Frame& frame : site.frames)
+            out.print("        ", frame.functionName.isEmpty() ? "(anonymous)" : frame.functionName, " ", frame.sourceURL, ":", frame.line, ":", frame.column, "\n");
+    }
+}
+
+String AllocationSiteProfiler::json() const
+{
+    auto locker = holdLock(m_lock);
+
+    StringBuilder json;
+    json.appendLiteral("{\"samplingInterval\":");
+    json.appendNumber(m_samplingInterval);
+    json.appendLiteral(",\"sites\":[");
+
+    bool firstSite = true;
+    for (unsigned siteIndex : siteIndicesByLiveBytes()) {
+        const Site& site = m_sites[siteIndex];
+        if (!firstSite)
+            json.append(',');
+        firstSite = false;
+
+        json.appendLiteral("{\"liveBytes\":");
+        json.appendNumber(site.liveBytes);
+        json.appendLiteral(",\"allocatedBytes\":");
+        json.appendNumber(site.allocatedBytes);
+        json.appendLiteral(",\"liveSamples\":");
+        json.appendNumber(site.liveSamples);
+        json.appendLiteral(",\"totalSamples\":");
+        json.appendNumber(site.totalSamples);
+        json.appendLiteral(",\"frames\":[");
+        bool firstFrame = true;
+        for (const Frame& frame : site.frames) {
+            if (!firstFrame)
+                json.append(',');
+            firstFrame = false;
+            json.appendLiteral("{\"functionName\":");
+            json.appendQuotedJSONString(frame.functionName);
+            json.appendLiteral(",\"url\":");
+            json.appendQuotedJSONString(frame.sourceURL);
+            json.appendLiteral(",\"line\":");
+            json.appendNumber(frame.line);
+            json.appendLiteral(",\"column\":");
+            json.appendNumber(frame.column);
+            json.append('}');
+        }
+        json.appendLiteral("]}");
+    }
+
+    json.appendLiteral("]}");
+    return json.toString();
+}
+
+} // namespace JSC
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/Vector.h>
+#include <wtf/WeakRandom.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class HeapCell;
+class VM;
+
+// Records a Poisson-sampled subset of allocations together with the JS stack that performed them,
+// and keeps track of which of those allocations are still alive. Samples are taken from the
+// allocation slow paths, so the bytes allocated out of a free list are attributed to the allocation
+// that refilled it. Dead samples are dropped at the end of every collection, before the sweeper gets
+// a chance to hand their cells out again.
+class AllocationSiteProfiler {
+    WTF_MAKE_NONCOPYABLE(AllocationSiteProfiler);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    AllocationSiteProfiler(VM&, size_t samplingInterval);
+    ~AllocationSiteProfiler();
+
+    VM& vm() const { return m_vm; }
+    size_t samplingInterval() const { return m_samplingInterval; }
+
+    void didAllocate(HeapCell* cell, size_t bytesAllocatedSinceLastSlowPath)
+    {
+        if (LIKELY(bytesAllocatedSinceLastSlowPath < m_bytesUntilNextSample)) {
+            m_bytesUntilNextSample -= bytesAllocatedSinceLastSlowPath;
+            return;
+        }
+        takeSample(cell, bytesAllocatedSinceLastSlowPath);
+    }
+
+    // Must be called after marking and before any cell is swept.
+    void removeDeadSamples();
+
+    void clear();
+
+    JS_EXPORT_PRIVATE void dump(PrintStream&) const;
+    JS_EXPORT_PRIVATE String json() const;
+
+private:
+    struct Frame {
+        String functionName;
+        String sourceURL;
+        unsigned line { 0 };
+        unsigned column { 0 };
+    };
+
+    struct Site {
+        Vector<Frame> frames;
+        size_t liveBytes { 0 };
+        size_t allocatedBytes { 0 };
+        unsigned liveSamples { 0 };
+        unsigned totalSamples { 0 };
+    };
+
+    struct Sample {
+        unsigned siteIndex;
+        size_t weight;
+    };
+
+    void takeSample(HeapCell*, size_t bytesAllocated);
+    size_t nextSampleDistance();
+    unsigned siteIndexForCurrentStack();
+    Vector<unsigned> siteIndicesByLiveBytes() const;
+
+    VM& m_vm;
+    size_t m_samplingInterval;
+    size_t m_bytesUntilNextSample;
+    WeakRandom m_weakRandom;
+
+    mutable Lock m_lock;
+    HashMap<HeapCell*, Sample> m_samples;
+    Vector<Site> m_sites;
+    HashMap<String, unsigned> m_siteIndices;
+};
+
+} // namespace JSC
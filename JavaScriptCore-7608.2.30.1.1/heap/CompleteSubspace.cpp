@@ -27,6 +27,7 @@
 #include "Subspace.h"
 
 #include "AlignedMemoryAllocator.h"
+#include "AllocationSiteProfiler.h"
 #include "AllocatorInlines.h"
 #include "BlockDirectoryInlines.h"
 #include "JSCInlines.h"
@@ -150,6 +151,9 @@ void* CompleteSubspace::tryAllocateSlow(VM& vm, size_t size, GCDeferralContext*
     m_space.m_capacity += size;
     
     m_largeAllocations.append(allocation);
+
+    if (UNLIKELY(vm.allocationSiteProfiler()))
+        vm.allocationSiteProfiler()->didAllocate(allocation->cell(), size);
         
     return allocation->cell();
 }
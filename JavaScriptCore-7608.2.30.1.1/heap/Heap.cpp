@@ -21,12 +21,14 @@
 #include "config.h"
 #include "Heap.h"
 
+#include "AllocationSiteProfiler.h"
 #include "BlockDirectoryInlines.h"
 #include "BuiltinExecutables.h"
 #include "CodeBlock.h"
 #include "CodeBlockSetInlines.h"
 #include "CollectingScope.h"
 #include "ConservativeRoots.h"
+#include "ContextResourceLimits.h"
 #include "DFGWorklistInlines.h"
 #include "EdenGCActivityCallback.h"
 #include "Exception.h"
@@ -61,6 +63,7 @@
 #include "MarkedSpaceInlines.h"
 #include "MarkingConstraintSet.h"
 #include "PreventCollectionScope.h"
+#include "PropertyMapHashTable.h"
 #include "SamplingProfiler.h"
 #include "ShadowChicken.h"
 #include "SpaceTimeMutatorScheduler.h"
@@ -80,6 +83,8 @@
 #include "WeakMapImplInlines.h"
 #include "WeakSetInlines.h"
 #include <algorithm>
+#include <wtf/CPUTime.h>
+#include <wtf/JSValueMalloc.h>
 #include <wtf/ListDump.h>
 #include <wtf/MainThread.h>
 #include <wtf/ParallelVectorIterator.h>
@@ -359,6 +364,8 @@ Heap::~Heap()
     
     for (WeakBlock* block : m_logicallyEmptyWeakBlocks)
         WeakBlock::destroy(*this, block);
+
+    freeRetiredWeakMapBuffers();
 }
 
 bool Heap::isPagedOut(MonotonicTime deadline)
@@ -634,6 +641,15 @@ void Heap::finalizeUnconditionalFinalizers()
 #endif
 }
 
+void Heap::removeDeadWeakMapEntries()
+{
+    // The parallel markers are still around at this point, so they can all help.
+    if (vm()->m_weakSetSpace)
+        runTaskInParallel(JSWeakSet::createRemoveDeadEntriesTask(*vm()->m_weakSetSpace));
+    if (vm()->m_weakMapSpace)
+        runTaskInParallel(JSWeakMap::createRemoveDeadEntriesTask(*vm()->m_weakMapSpace));
+}
+
 void Heap::willStartIterating()
 {
     m_objectSpace.willStartIterating();
@@ -829,6 +845,23 @@ void Heap::endMarking()
     
     m_objectSpace.endMarking();
     setMutatorShouldBeFenced(Options::forceFencedBarrier());
+
+    // No SlotVisitor is scanning any weak map buffer anymore, whether or not its map survived.
+    freeRetiredWeakMapBuffers();
+}
+
+void Heap::retireWeakMapBuffer(void* buffer)
+{
+    auto locker = holdLock(m_retiredWeakMapBuffersLock);
+    m_retiredWeakMapBuffers.append(buffer);
+}
+
+void Heap::freeRetiredWeakMapBuffers()
+{
+    auto locker = holdLock(m_retiredWeakMapBuffersLock);
+    for (void* buffer : m_retiredWeakMapBuffers)
+        JSValueMalloc::free(buffer);
+    m_retiredWeakMapBuffers.clear();
 }
 
 size_t Heap::objectCount()
@@ -921,6 +954,31 @@ std::unique_ptr<TypeCountSet> Heap::objectTypeCounts()
     return result;
 }
 
+StructureMemoryStatistics Heap::structureMemoryStatistics()
+{
+    StructureMemoryStatistics result;
+    VM& vm = *m_vm;
+    HeapIterationScope iterationScope(*this);
+    vm.structureSpace.forEachLiveCell(
+        [&] (HeapCell* cell, HeapCell::Kind) {
+            Structure* structure = static_cast<Structure*>(cell);
+            result.structureCount++;
+            result.structureBytes += sizeof(Structure);
+            if (structure->isPinnedPropertyTable()) {
+                if (PropertyTable* table = structure->propertyTableOrNull()) {
+                    result.pinnedPropertyTableCount++;
+                    result.pinnedPropertyTableBytes += table->sizeInMemory();
+                }
+            }
+        });
+    vm.propertyTableSpace.forEachLiveCell(
+        [&] (HeapCell* cell, HeapCell::Kind) {
+            result.propertyTableCount++;
+            result.propertyTableBytes += static_cast<PropertyTable*>(cell)->sizeInMemory();
+        });
+    return result;
+}
+
 void Heap::deleteAllCodeBlocks(DeleteAllCodeEffort effort)
 {
     if (m_collectionScope && effort == DeleteAllCodeIfNotCollecting)
@@ -1396,6 +1454,7 @@ NEVER_INLINE bool Heap::runFixpointPhase(GCConductor conn)
         // https://bugs.webkit.org/show_bug.cgi?id=180310
         if (converged && slotVisitor.isEmpty()) {
             assertMarkStacksEmpty();
+            removeDeadWeakMapEntries();
             return changePhase(conn, CollectorPhase::End);
         }
             
@@ -1658,7 +1717,11 @@ void Heap::stopThePeriphery(GCConductor conn)
     if (auto* shadowChicken = vm()->shadowChicken())
         shadowChicken->update(*vm(), vm()->topCallFrame);
     
-    m_structureIDTable.flushOldTables();
+    m_structureIDTable.decommitFreeSegments();
+#if USE(JSVALUE64)
+    if (Options::logGC() == GCLogging::Verbose)
+        dataLog("StructureIDTable: ", m_structureIDTable.statistics(), "\n");
+#endif
     m_objectSpace.stopAllocating();
     
     m_stopTime = MonotonicTime::now();
@@ -2302,6 +2365,11 @@ void Heap::updateAllocationLimits()
         m_sizeAfterLastFullCollect = currentHeapSize;
         if (verbose)
             dataLog("Full: sizeAfterLastFullCollect = ", currentHeapSize, "\n");
+        if (!m_contextResourceLimits.isEmpty()) {
+            double survivalRate = m_sizeBeforeLastFullCollect ? std::min(1.0, static_cast<double>(currentHeapSize) / m_sizeBeforeLastFullCollect) : 1.0;
+            for (ContextResourceLimits* limits : m_contextResourceLimits)
+                limits->didFinishFullCollection(survivalRate);
+        }
         m_bytesAbandonedSinceLastFullCollect = 0;
         if (verbose)
             dataLog("Full: bytesAbandonedSinceLastFullCollect = ", 0, "\n");
@@ -2364,6 +2432,9 @@ void Heap::didFinishCollection()
         removeDeadHeapSnapshotNodes(*heapProfiler);
     }
 
+    if (AllocationSiteProfiler* allocationSiteProfiler = m_vm->allocationSiteProfiler())
+        allocationSiteProfiler->removeDeadSamples();
+
     if (UNLIKELY(m_verifier))
         m_verifier->endGC();
 
@@ -2413,9 +2484,53 @@ void Heap::didAllocate(size_t bytes)
     if (m_edenActivityCallback)
         m_edenActivityCallback->didAllocate(*this, m_bytesAllocatedThisCycle + m_bytesAbandonedSinceLastFullCollect);
     m_bytesAllocatedThisCycle += bytes;
+    if (UNLIKELY(m_currentContextResourceLimits))
+        m_currentContextResourceLimits->didAllocate(bytes);
     performIncrement(bytes);
 }
 
+void Heap::didCreateContextResourceLimits(ContextResourceLimits* limits)
+{
+    m_contextResourceLimits.add(limits);
+}
+
+void Heap::willDestroyContextResourceLimits(ContextResourceLimits* limits)
+{
+    // A global object is kept alive by any VMEntryScope that entered it, so its limits cannot be current.
+    ASSERT(m_currentContextResourceLimits != limits);
+    m_contextResourceLimits.remove(limits);
+}
+
+void Heap::setCurrentContextResourceLimits(ContextResourceLimits* limits)
+{
+    Seconds now = CPUTime::forCurrentThread();
+    if (m_currentContextResourceLimits)
+        m_currentContextResourceLimits->didUseCPUTime(now - m_currentContextResourceLimitsCPUTimeStart);
+    m_currentContextResourceLimits = limits;
+    m_currentContextResourceLimitsCPUTimeStart = now;
+
+    // A check requested while another context was running must be serviced before this one runs.
+    if (limits && limits->needsMemoryLimitCheck())
+        m_vm->notifyNeedMemoryLimitCheck();
+}
+
+bool Heap::checkContextMemoryLimits()
+{
+    ContextResourceLimits* limits = m_currentContextResourceLimits;
+    if (!limits || !limits->needsMemoryLimitCheck())
+        return false;
+
+    bool didCollect = false;
+    if (limits->isOverSoftMemoryLimit()) {
+        collectNow(Sync, CollectionScope::Full);
+        didCollect = true;
+    }
+    if (!limits->didCheckMemoryLimits(didCollect))
+        return false;
+    limits->didTerminateForMemoryLimit();
+    return true;
+}
+
 bool Heap::isValidAllocation(size_t)
 {
     if (!isValidThreadState(m_vm))
@@ -2752,6 +2867,11 @@ void Heap::addCoreConstraints()
                 slotVisitor.appendUnbarriered(m_vm->exception());
                 slotVisitor.appendUnbarriered(m_vm->lastException());
             }
+
+            {
+                SetRootMarkReasonScope rootScope(slotVisitor, SlotVisitor::RootMarkReason::StrongReferences);
+                m_vm->microtaskQueue().visitAggregate(slotVisitor);
+            }
         },
         ConstraintVolatility::GreyedByExecution);
     
@@ -2812,7 +2932,7 @@ void Heap::addCoreConstraints()
             
             add(vm.executableToCodeBlockEdgesWithConstraints);
             if (vm.m_weakMapSpace)
-                add(*vm.m_weakMapSpace);
+                slotVisitor.addParallelConstraintTask(JSWeakMap::createOutputConstraintTask(*vm.m_weakMapSpace));
         },
         ConstraintVolatility::GreyedByMarking,
         ConstraintParallelism::Parallel);
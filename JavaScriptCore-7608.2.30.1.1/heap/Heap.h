@@ -52,6 +52,7 @@ namespace JSC {
 
 class CodeBlock;
 class CodeBlockSet;
+class ContextResourceLimits;
 class CollectingScope;
 class ConservativeRoots;
 class GCDeferralContext;
@@ -105,6 +106,15 @@ constexpr bool validateDFGDoesGC = ENABLE_DFG_DOES_GC_VALIDATION;
 typedef HashCountedSet<JSCell*> ProtectCountSet;
 typedef HashCountedSet<const char*> TypeCountSet;
 
+struct StructureMemoryStatistics {
+    size_t structureCount { 0 };
+    size_t structureBytes { 0 };
+    size_t propertyTableCount { 0 };
+    size_t propertyTableBytes { 0 };
+    size_t pinnedPropertyTableCount { 0 };
+    size_t pinnedPropertyTableBytes { 0 };
+};
+
 enum HeapType { SmallHeap, LargeHeap };
 
 class HeapUtil;
@@ -239,6 +249,7 @@ public:
     JS_EXPORT_PRIVATE size_t protectedGlobalObjectCount();
     JS_EXPORT_PRIVATE std::unique_ptr<TypeCountSet> protectedObjectTypeCounts();
     JS_EXPORT_PRIVATE std::unique_ptr<TypeCountSet> objectTypeCounts();
+    JS_EXPORT_PRIVATE StructureMemoryStatistics structureMemoryStatistics();
 
     HashSet<MarkedArgumentBuffer*>& markListSet();
     
@@ -265,6 +276,15 @@ public:
 
     void didAllocate(size_t);
     bool isPagedOut(MonotonicTime deadline);
+
+    void didCreateContextResourceLimits(ContextResourceLimits*);
+    void willDestroyContextResourceLimits(ContextResourceLimits*);
+    ContextResourceLimits* currentContextResourceLimits() const { return m_currentContextResourceLimits; }
+    // Charges the CPU time since the last switch to the outgoing limits, then makes subsequent
+    // allocation count against the incoming ones.
+    void setCurrentContextResourceLimits(ContextResourceLimits*);
+    // Services the NeedMemoryLimitCheck trap for the running context. Returns true if it should be terminated.
+    bool checkContextMemoryLimits();
     
     const JITStubRoutineSet& jitStubRoutines() { return *m_jitStubRoutines; }
     
@@ -297,6 +317,12 @@ public:
     
     bool mutatorShouldBeFenced() const { return m_mutatorShouldBeFenced; }
     const bool* addressOfMutatorShouldBeFenced() const { return &m_mutatorShouldBeFenced; }
+
+    bool isMarking() const { return m_objectSpace.isMarking(); }
+
+    // Takes ownership of a JSValueMalloc'd weak map buffer that marking threads may still be
+    // scanning, and frees it once marking ends.
+    void retireWeakMapBuffer(void*);
     
     unsigned barrierThreshold() const { return m_barrierThreshold; }
     const unsigned* addressOfBarrierThreshold() const { return &m_barrierThreshold; }
@@ -524,6 +550,8 @@ private:
     void finalizeMarkedUnconditionalFinalizers(CellSet&);
 
     void finalizeUnconditionalFinalizers();
+    void removeDeadWeakMapEntries();
+    void freeRetiredWeakMapBuffers();
 
     void deleteUnmarkedCompiledCode();
     JS_EXPORT_PRIVATE void addToRememberedSet(const JSCell*);
@@ -647,7 +675,14 @@ private:
     Seconds m_lastEdenGCLength { 10_ms };
 
     Vector<WeakBlock*> m_logicallyEmptyWeakBlocks;
+
+    Lock m_retiredWeakMapBuffersLock;
+    Vector<void*> m_retiredWeakMapBuffers;
     size_t m_indexOfNextLogicallyEmptyWeakBlockToSweep { WTF::notFound };
+
+    HashSet<ContextResourceLimits*> m_contextResourceLimits;
+    ContextResourceLimits* m_currentContextResourceLimits { nullptr };
+    Seconds m_currentContextResourceLimitsCPUTimeStart;
     
     RefPtr<FullGCActivityCallback> m_fullActivityCallback;
     RefPtr<GCActivityCallback> m_edenActivityCallback;
@@ -27,6 +27,7 @@
 #include "LocalAllocator.h"
 
 #include "AllocatingScope.h"
+#include "AllocationSiteProfiler.h"
 #include "FreeListInlines.h"
 #include "GCDeferralContext.h"
 #include "JSCInlines.h"
@@ -118,7 +119,8 @@ void* LocalAllocator::allocateSlowCase(GCDeferralContext* deferralContext, Alloc
     doTestCollectionsIfNeeded(deferralContext);
 
     ASSERT(!m_directory->markedSpace().isIterating());
-    heap.didAllocate(m_freeList.originalSize());
+    size_t bytesAllocated = m_freeList.originalSize();
+    heap.didAllocate(bytesAllocated);
     
     didConsumeFreeList();
     
@@ -133,8 +135,11 @@ void* LocalAllocator::allocateSlowCase(GCDeferralContext* deferralContext, Alloc
     
     void* result = tryAllocateWithoutCollecting();
     
-    if (LIKELY(result != 0))
+    if (LIKELY(result != 0)) {
+        if (UNLIKELY(heap.vm()->allocationSiteProfiler()))
+            heap.vm()->allocationSiteProfiler()->didAllocate(static_cast<HeapCell*>(result), bytesAllocated);
         return result;
+    }
     
     MarkedBlock::Handle* block = m_directory->tryAllocateBlock();
     if (!block) {
@@ -146,6 +151,8 @@ void* LocalAllocator::allocateSlowCase(GCDeferralContext* deferralContext, Alloc
     m_directory->addBlock(block);
     result = allocateIn(block);
     ASSERT(result);
+    if (UNLIKELY(heap.vm()->allocationSiteProfiler()))
+        heap.vm()->allocationSiteProfiler()->didAllocate(static_cast<HeapCell*>(result), bytesAllocated);
     return result;
 }
 
@@ -26,6 +26,7 @@
 #include "config.h"
 #include "InspectorHeapAgent.h"
 
+#include "AllocationSiteProfiler.h"
 #include "HeapProfiler.h"
 #include "HeapSnapshot.h"
 #include "InjectedScript.h"
@@ -57,6 +58,12 @@ void InspectorHeapAgent::willDestroyFrontendAndBackend(DisconnectReason)
     // Stop tracking without taking a snapshot.
     m_tracking = false;
 
+    // Leave a profiler that the shell or an option started alone.
+    if (m_startedAllocationSampling) {
+        ErrorString ignoredSampling;
+        stopAllocationSampling(ignoredSampling);
+    }
+
     ErrorString ignored;
     disable(ignored);
 }
@@ -139,6 +146,51 @@ void InspectorHeapAgent::stopTracking(ErrorString& errorString)
     m_frontendDispatcher->trackingComplete(timestamp, snapshotData);
 }
 
+void InspectorHeapAgent::startAllocationSampling(ErrorString& errorString, const int* samplingInterval)
+{
+    VM& vm = m_environment.vm();
+    JSLockHolder lock(vm);
+
+    if (samplingInterval && *samplingInterval <= 0) {
+        errorString = "Sampling interval must be positive"_s;
+        return;
+    }
+
+    if (vm.allocationSiteProfiler()) {
+        errorString = "Already sampling allocations"_s;
+        return;
+    }
+
+    vm.ensureAllocationSiteProfiler(samplingInterval ? *samplingInterval : Options::allocationSiteProfilerSamplingInterval());
+    m_startedAllocationSampling = true;
+}
+
+void InspectorHeapAgent::stopAllocationSampling(ErrorString&)
+{
+    VM& vm = m_environment.vm();
+    JSLockHolder lock(vm);
+    vm.disableAllocationSiteProfiler();
+    m_startedAllocationSampling = false;
+}
+
+void InspectorHeapAgent::getAllocationSiteProfile(ErrorString& errorString, double* timestamp, String* profileData)
+{
+    VM& vm = m_environment.vm();
+    JSLockHolder lock(vm);
+
+    AllocationSiteProfiler* profiler = vm.allocationSiteProfiler();
+    if (!profiler) {
+        errorString = "Not sampling allocations"_s;
+        return;
+    }
+
+    sanitizeStackForVM(&vm);
+    vm.heap.collectNow(Sync, CollectionScope::Full);
+
+    *timestamp = m_environment.executionStopwatch()->elapsedTime().seconds();
+    *profileData = profiler->json();
+}
+
 Optional<HeapSnapshotNode> InspectorHeapAgent::nodeForHeapObjectIdentifier(ErrorString& errorString, unsigned heapObjectIdentifier)
 {
     HeapProfiler* heapProfiler = m_environment.vm().heapProfiler();
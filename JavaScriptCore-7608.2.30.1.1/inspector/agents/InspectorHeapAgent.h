@@ -59,6 +59,9 @@ public:
     void snapshot(ErrorString&, double* timestamp, String* snapshotData) final;
     void startTracking(ErrorString&) final;
     void stopTracking(ErrorString&) final;
+    void startAllocationSampling(ErrorString&, const int* samplingInterval) final;
+    void stopAllocationSampling(ErrorString&) final;
+    void getAllocationSiteProfile(ErrorString&, double* timestamp, String* profileData) final;
     void getPreview(ErrorString&, int heapObjectId, Optional<String>& resultString, RefPtr<Protocol::Debugger::FunctionDetails>&, RefPtr<Protocol::Runtime::ObjectPreview>&) final;
     void getRemoteObject(ErrorString&, int heapObjectId, const String* optionalObjectGroup, RefPtr<Protocol::Runtime::RemoteObject>& result) final;
 
@@ -81,6 +84,7 @@ private:
 
     bool m_enabled { false };
     bool m_tracking { false };
+    bool m_startedAllocationSampling { false };
     Seconds m_gcStartTime { Seconds::nan() };
 };
 
@@ -41,6 +41,7 @@
 #include "RegisterSet.h"
 #include "StackAlignment.h"
 #include "TagRegistersMode.h"
+#include "TypeProfilerLog.h"
 #include "TypeofType.h"
 #include "VM.h"
 
@@ -1762,6 +1763,20 @@ public:
     void makeSpaceOnStackForCCall();
     void reclaimSpaceOnStackForCCall();
 
+    // Counts down the type profiler's sampling interval. The returned jump is taken when this
+    // event should not be written to the log. On fall-through, the countdown has been rearmed.
+    Jump branchIfTypeProfilerEventNotSampled(TypeProfilerLog* log, GPRReg logGPR, GPRReg scratchGPR)
+    {
+        ASSERT(log->isSampling());
+        Address countdown(logGPR, TypeProfilerLog::samplingCountdownOffset());
+        load32(countdown, scratchGPR);
+        sub32(TrustedImm32(1), scratchGPR);
+        store32(scratchGPR, countdown);
+        Jump notSampled = branchTest32(NonZero, scratchGPR);
+        store32(TrustedImm32(log->samplingInterval()), countdown);
+        return notSampled;
+    }
+
 #if USE(JSVALUE64)
     void emitRandomThunk(JSGlobalObject*, GPRReg scratch0, GPRReg scratch1, GPRReg scratch2, FPRReg result);
     void emitRandomThunk(VM&, GPRReg scratch0, GPRReg scratch1, GPRReg scratch2, GPRReg scratch3, FPRReg result);
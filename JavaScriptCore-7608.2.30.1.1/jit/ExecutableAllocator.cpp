@@ -43,6 +43,10 @@
 #include <sys/mman.h>
 #endif
 
+#if OS(LINUX)
+#include <sys/mman.h>
+#endif
+
 #if PLATFORM(IOS_FAMILY)
 #include <wtf/cocoa/Entitlements.h>
 #endif
@@ -109,6 +113,10 @@ static const double executablePoolReservationFraction = 0.15;
 static const double executablePoolReservationFraction = 0.25;
 #endif
 
+#if OS(LINUX) && defined(MADV_HUGEPAGE)
+static const size_t jitHugePageSize = 2 * MB;
+#endif
+
 #if ENABLE(SEPARATED_WX_HEAP)
 JS_EXPORT_PRIVATE bool useFastPermisionsJITCopy { false };
 JS_EXPORT_PRIVATE JITWriteSeparateHeapsFunction jitWriteSeparateHeapsFunction;
@@ -154,15 +162,79 @@ void ExecutableAllocator::setJITEnabled(bool enabled)
 #endif
 }
 
-class FixedVMPoolExecutableAllocator : public MetaAllocator {
+// One part of the fixed pool. Every region carves its memory out of the pool's single reservation,
+// so isJITPC() and the W^X write paths only need to know about the pool's bounds.
+class ExecutableMemoryRegion : public MetaAllocator {
     WTF_MAKE_FAST_ALLOCATED;
 public:
-    FixedVMPoolExecutableAllocator()
+    ExecutableMemoryRegion(PageReservation& reservation)
         : MetaAllocator(jitAllocationGranule) // round up all allocations to 32 bytes
+        , m_reservation(reservation)
+    {
+    }
+
+    // Huge pages are split as soon as part of them is committed or decommitted on its own, so a
+    // region backed by them is committed up front and keeps its pages.
+    void setKeepsPagesCommitted() { m_keepsPagesCommitted = true; }
+
+protected:
+    FreeSpacePtr allocateNewSpace(size_t&) override
+    {
+        // We're operating in a fixed pool, so new allocation is always prohibited.
+        return nullptr;
+    }
+
+    void notifyNeedPage(void* page) override
+    {
+        if (m_keepsPagesCommitted)
+            return;
+#if USE(MADV_FREE_FOR_JIT_MEMORY)
+        UNUSED_PARAM(page);
+#else
+        m_reservation.commit(page, pageSize());
+#endif
+    }
+
+    void notifyPageIsFree(void* page) override
+    {
+        if (m_keepsPagesCommitted)
+            return;
+#if USE(MADV_FREE_FOR_JIT_MEMORY)
+        for (;;) {
+            int result = madvise(page, pageSize(), MADV_FREE);
+            if (!result)
+                return;
+            ASSERT(result == -1);
+            if (errno != EAGAIN) {
+                RELEASE_ASSERT_NOT_REACHED(); // In debug mode, this should be a hard failure.
+                break; // In release mode, we should just ignore the error - not returning memory to the OS is better than crashing, especially since we _will_ be able to reuse the memory internally anyway.
+            }
+        }
+#else
+        m_reservation.decommit(page, pageSize());
+#endif
+    }
+
+private:
+    PageReservation& m_reservation;
+    bool m_keepsPagesCommitted { false };
+};
+
+class FixedVMPoolExecutableAllocator {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    FixedVMPoolExecutableAllocator()
+        : m_hotRegion(m_reservation)
+        , m_coldRegion(m_reservation)
     {
         if (!isJITEnabled())
             return;
 
+        bool useHugePages = false;
+#if OS(LINUX) && defined(MADV_HUGEPAGE)
+        useHugePages = Options::useHugePagesForJITMemory();
+#endif
+
         size_t reservationSize;
         if (Options::jitMemoryReservationSize())
             reservationSize = Options::jitMemoryReservationSize();
@@ -170,12 +242,13 @@ public:
             reservationSize = fixedExecutableMemoryPoolSize;
         reservationSize = std::max(roundUpToMultipleOf(pageSize(), reservationSize), pageSize() * 2);
 
-        auto tryCreatePageReservation = [] (size_t reservationSize) {
+        auto tryCreatePageReservation = [&] (size_t reservationSize) {
 #if OS(LINUX)
             // If we use uncommitted reservation, mmap operation is recorded with small page size in perf command's output.
             // This makes the following JIT code logging broken and some of JIT code is not recorded correctly.
             // To avoid this problem, we use committed reservation if we need perf JITDump logging.
-            if (Options::logJITCodeForPerf())
+            // Huge pages need a committed reservation too, since committing page by page would split them.
+            if (Options::logJITCodeForPerf() || useHugePages)
                 return PageReservation::reserveAndCommitWithGuardPages(reservationSize, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true);
 #endif
             return PageReservation::reserveWithGuardPages(reservationSize, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true);
@@ -206,7 +279,7 @@ public:
             }
 #endif // not ENABLE(FAST_JIT_PERMISSIONS) or ENABLE(SEPARATED_WX_HEAP)
 
-            addFreshFreeSpace(reservationBase, reservationSize);
+            addRegions(static_cast<uint8_t*>(reservationBase), reservationSize, useHugePages);
 
             void* reservationEnd = reinterpret_cast<uint8_t*>(reservationBase) + reservationSize;
 
@@ -215,47 +288,61 @@ public:
         }
     }
 
-    virtual ~FixedVMPoolExecutableAllocator();
+    ~FixedVMPoolExecutableAllocator();
 
     void* memoryStart() { return m_memoryStart.untaggedExecutableAddress(); }
     void* memoryEnd() { return m_memoryEnd.untaggedExecutableAddress(); }
     bool isJITPC(void* pc) { return memoryStart() <= pc && pc < memoryEnd(); }
 
-protected:
-    FreeSpacePtr allocateNewSpace(size_t&) override
+    ExecutableMemoryRegion& hotRegion() { return m_hotRegion; }
+    ExecutableMemoryRegion& coldRegion() { return m_coldRegion; }
+    ExecutableMemoryRegion& region(ExecutableMemoryPlacement placement)
     {
-        // We're operating in a fixed pool, so new allocation is always prohibited.
-        return nullptr;
+        return placement == ExecutableMemoryPlacement::Cold ? m_coldRegion : m_hotRegion;
     }
 
-    void notifyNeedPage(void* page) override
+    MetaAllocator::Statistics currentStatistics()
     {
-#if USE(MADV_FREE_FOR_JIT_MEMORY)
-        UNUSED_PARAM(page);
-#else
-        m_reservation.commit(page, pageSize());
-#endif
+        MetaAllocator::Statistics result = m_hotRegion.currentStatistics();
+        MetaAllocator::Statistics coldStatistics = m_coldRegion.currentStatistics();
+        result.bytesAllocated += coldStatistics.bytesAllocated;
+        result.bytesReserved += coldStatistics.bytesReserved;
+        result.bytesCommitted += coldStatistics.bytesCommitted;
+        return result;
     }
 
-    void notifyPageIsFree(void* page) override
+private:
+    void addRegions(uint8_t* start, size_t size, bool useHugePages)
     {
-#if USE(MADV_FREE_FOR_JIT_MEMORY)
-        for (;;) {
-            int result = madvise(page, pageSize(), MADV_FREE);
-            if (!result)
-                return;
-            ASSERT(result == -1);
-            if (errno != EAGAIN) {
-                RELEASE_ASSERT_NOT_REACHED(); // In debug mode, this should be a hard failure.
-                break; // In release mode, we should just ignore the error - not returning memory to the OS is better than crashing, especially since we _will_ be able to reuse the memory internally anyway.
+        // The cold region sits at the end of the pool, away from hot code.
+        double coldFraction = std::min(std::max(Options::jitColdMemoryFraction(), 0.0), 0.5);
+        size_t coldSize = roundUpToMultipleOf(pageSize(), static_cast<size_t>(size * coldFraction));
+        if (coldSize >= size)
+            coldSize = 0;
+        uint8_t* hotStart = start;
+        uint8_t* coldStart = start + size - coldSize;
+
+#if OS(LINUX) && defined(MADV_HUGEPAGE)
+        if (useHugePages) {
+            // Transparent huge pages only back aligned 2MB ranges. Whatever comes before the
+            // first one goes to the cold region.
+            uint8_t* alignedHotStart = roundUpToMultipleOf(jitHugePageSize, hotStart);
+            if (alignedHotStart < coldStart && !madvise(alignedHotStart, coldStart - alignedHotStart, MADV_HUGEPAGE)) {
+                if (alignedHotStart != hotStart)
+                    m_coldRegion.addFreshFreeSpace(hotStart, alignedHotStart - hotStart);
+                hotStart = alignedHotStart;
+                m_hotRegion.setKeepsPagesCommitted();
             }
         }
 #else
-        m_reservation.decommit(page, pageSize());
+        UNUSED_PARAM(useHugePages);
 #endif
+
+        m_hotRegion.addFreshFreeSpace(hotStart, coldStart - hotStart);
+        if (coldSize)
+            m_coldRegion.addFreshFreeSpace(coldStart, coldSize);
     }
 
-private:
 #if OS(DARWIN) && HAVE(REMAP_JIT)
     void initializeSeparatedWXHeaps(void* stubBase, size_t stubSize, void* jitBase, size_t jitSize)
     {
@@ -404,6 +491,8 @@ private:
 
 private:
     PageReservation m_reservation;
+    ExecutableMemoryRegion m_hotRegion;
+    ExecutableMemoryRegion m_coldRegion;
     MacroAssemblerCodePtr<ExecutableMemoryPtrTag> m_memoryStart;
     MacroAssemblerCodePtr<ExecutableMemoryPtrTag> m_memoryEnd;
 };
@@ -417,14 +506,15 @@ void ExecutableAllocator::initializeUnderlyingAllocator()
 {
     ASSERT(!allocator);
     allocator = new FixedVMPoolExecutableAllocator();
-    CodeProfiling::notifyAllocator(allocator);
+    // Code profiling attributes samples to the code that owns them, which is only worth doing for hot code.
+    CodeProfiling::notifyAllocator(&allocator->hotRegion());
 }
 
 bool ExecutableAllocator::isValid() const
 {
     if (!allocator)
         return Base::isValid();
-    return !!allocator->bytesReserved();
+    return !!allocator->hotRegion().bytesReserved();
 }
 
 bool ExecutableAllocator::underMemoryPressure()
@@ -455,10 +545,10 @@ double ExecutableAllocator::memoryPressureMultiplier(size_t addedMemoryUsage)
     return result;
 }
 
-RefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort)
+RefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort, ExecutableMemoryPlacement placement)
 {
     if (!allocator)
-        return Base::allocate(sizeInBytes, ownerUID, effort);
+        return Base::allocate(sizeInBytes, ownerUID, effort, placement);
     if (Options::logExecutableAllocation()) {
         MetaAllocator::Statistics stats = allocator->currentStatistics();
         dataLog("Allocating ", sizeInBytes, " bytes of executable memory with ", stats.bytesAllocated, " bytes allocated, ", stats.bytesReserved, " bytes reserved, and ", stats.bytesCommitted, " committed.\n");
@@ -486,7 +576,11 @@ RefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(size_t sizeInBytes,
         }
     }
 
-    RefPtr<ExecutableMemoryHandle> result = allocator->allocate(sizeInBytes, ownerUID);
+    RefPtr<ExecutableMemoryHandle> result = allocator->region(placement).allocate(sizeInBytes, ownerUID);
+    if (!result) {
+        ExecutableMemoryPlacement otherPlacement = placement == ExecutableMemoryPlacement::Hot ? ExecutableMemoryPlacement::Cold : ExecutableMemoryPlacement::Hot;
+        result = allocator->region(otherPlacement).allocate(sizeInBytes, ownerUID);
+    }
     if (!result) {
         if (effort != JITCompilationCanFail) {
             dataLog("Ran out of executable memory while allocating ", sizeInBytes, " bytes.\n");
@@ -510,21 +604,45 @@ bool ExecutableAllocator::isValidExecutableMemory(const AbstractLocker& locker,
 {
     if (!allocator)
         return Base::isValidExecutableMemory(locker, address);
-    return allocator->isInAllocatedMemory(locker, address);
+    if (allocator->hotRegion().isInAllocatedMemory(locker, address))
+        return true;
+
+    // The caller holds the hot region's lock, which may be all it can safely take: the sampling
+    // profiler takes it before suspending a thread that could be inside the cold region. So don't
+    // wait for the cold region's lock. If it's busy, answer conservatively.
+    auto coldLocker = tryHoldLock(allocator->coldRegion().getLock());
+    if (!coldLocker)
+        return false;
+    return allocator->coldRegion().isInAllocatedMemory(coldLocker, address);
+}
+
+Optional<ExecutableMemoryPlacement> ExecutableAllocator::placementOf(void* address)
+{
+    if (!allocator)
+        return Base::placementOf(address);
+    {
+        auto locker = holdLock(allocator->coldRegion().getLock());
+        if (allocator->coldRegion().isInAllocatedMemory(locker, address))
+            return ExecutableMemoryPlacement::Cold;
+    }
+    auto locker = holdLock(allocator->hotRegion().getLock());
+    if (allocator->hotRegion().isInAllocatedMemory(locker, address))
+        return ExecutableMemoryPlacement::Hot;
+    return WTF::nullopt;
 }
 
 Lock& ExecutableAllocator::getLock() const
 {
     if (!allocator)
         return Base::getLock();
-    return allocator->getLock();
+    return allocator->hotRegion().getLock();
 }
 
 size_t ExecutableAllocator::committedByteCount()
 {
     if (!allocator)
         return Base::committedByteCount();
-    return allocator->bytesCommitted();
+    return allocator->hotRegion().bytesCommitted() + allocator->coldRegion().bytesCommitted();
 }
 
 #if ENABLE(META_ALLOCATOR_PROFILE)
@@ -532,10 +650,28 @@ void ExecutableAllocator::dumpProfile()
 {
     if (!allocator)
         return;
-    allocator->dumpProfile();
+    allocator->hotRegion().dumpProfile();
+    allocator->coldRegion().dumpProfile();
 }
 #endif
 
+void ExecutableAllocator::dumpStatistics()
+{
+    if (!allocator)
+        return Base::dumpStatistics();
+
+    auto dumpRegion = [] (const char* name, ExecutableMemoryRegion& region) {
+        MetaAllocator::Statistics statistics = region.currentStatistics();
+        // Committed pages that hold no code are what fragmentation costs us in memory.
+        size_t unusedCommittedBytes = statistics.bytesCommitted - std::min(statistics.bytesCommitted, statistics.bytesAllocated);
+        double fragmentation = statistics.bytesCommitted ? static_cast<double>(unusedCommittedBytes) / statistics.bytesCommitted : 0;
+        dataLog(name, " executable memory: ", statistics.bytesAllocated, " bytes allocated, ", statistics.bytesCommitted, " committed, ", statistics.bytesReserved, " reserved; ",
+            unusedCommittedBytes, " committed bytes unused (", fragmentation * 100, "%).\n");
+    };
+    dumpRegion("Hot", allocator->hotRegion());
+    dumpRegion("Cold", allocator->coldRegion());
+}
+
 void* startOfFixedExecutableMemoryPoolImpl()
 {
     if (!allocator)
@@ -34,6 +34,7 @@
 #include <wtf/Lock.h>
 #include <wtf/MetaAllocatorHandle.h>
 #include <wtf/MetaAllocator.h>
+#include <wtf/Optional.h>
 
 #if OS(IOS_FAMILY)
 #include <libkern/OSCacheControl.h>
@@ -58,6 +59,13 @@ namespace JSC {
 
 static const unsigned jitAllocationGranule = 32;
 
+// Code we expect to run rarely, like OSR exit ramps and out-of-line slow paths, is placed in a
+// separate part of the pool so that it doesn't spread hot code over more pages and iTLB entries.
+enum class ExecutableMemoryPlacement : uint8_t {
+    Hot,
+    Cold
+};
+
 typedef WTF::MetaAllocatorHandle ExecutableMemoryHandle;
 
 class ExecutableAllocatorBase {
@@ -72,12 +80,16 @@ public:
 
     static void dumpProfile() { }
 
-    RefPtr<ExecutableMemoryHandle> allocate(size_t, void*, JITCompilationEffort) { return nullptr; }
+    static void dumpStatistics() { }
+
+    RefPtr<ExecutableMemoryHandle> allocate(size_t, void*, JITCompilationEffort, ExecutableMemoryPlacement = ExecutableMemoryPlacement::Hot) { return nullptr; }
 
     static void setJITEnabled(bool) { };
     
     bool isValidExecutableMemory(const AbstractLocker&, void*) { return false; }
 
+    Optional<ExecutableMemoryPlacement> placementOf(void*) { return WTF::nullopt; }
+
     static size_t committedByteCount() { return 0; }
 
     Lock& getLock() const
@@ -165,7 +177,7 @@ class ExecutableAllocator : private ExecutableAllocatorBase {
 public:
     using Base = ExecutableAllocatorBase;
 
-    static ExecutableAllocator& singleton();
+    JS_EXPORT_PRIVATE static ExecutableAllocator& singleton();
     static void initialize();
     static void initializeUnderlyingAllocator();
 
@@ -180,16 +192,23 @@ public:
 #else
     static void dumpProfile() { }
 #endif
+
+    // Logs how much of each region is reserved, committed and allocated.
+    JS_EXPORT_PRIVATE static void dumpStatistics();
     
     JS_EXPORT_PRIVATE static void setJITEnabled(bool);
 
-    RefPtr<ExecutableMemoryHandle> allocate(size_t sizeInBytes, void* ownerUID, JITCompilationEffort);
+    // Falls back to the other region if the requested one is full.
+    JS_EXPORT_PRIVATE RefPtr<ExecutableMemoryHandle> allocate(size_t sizeInBytes, void* ownerUID, JITCompilationEffort, ExecutableMemoryPlacement = ExecutableMemoryPlacement::Hot);
+
+    JS_EXPORT_PRIVATE bool isValidExecutableMemory(const AbstractLocker&, void* address);
 
-    bool isValidExecutableMemory(const AbstractLocker&, void* address);
+    // Which region the allocation containing this address came from, if any.
+    JS_EXPORT_PRIVATE Optional<ExecutableMemoryPlacement> placementOf(void* address);
 
     static size_t committedByteCount();
 
-    Lock& getLock() const;
+    JS_EXPORT_PRIVATE Lock& getLock() const;
 
 private:
     ExecutableAllocator() = default;
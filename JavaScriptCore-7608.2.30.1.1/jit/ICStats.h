@@ -41,6 +41,8 @@ namespace JSC {
     macro(GetByIdAddAccessCase) \
     macro(GetByIdReplaceWithJump) \
     macro(GetByIdSelfPatch) \
+    macro(GetByIdUncacheableDictionary) \
+    macro(GetByIdAddDictionaryAccessCase) \
     macro(InAddAccessCase) \
     macro(InReplaceWithJump) \
     macro(InstanceOfAddAccessCase) \
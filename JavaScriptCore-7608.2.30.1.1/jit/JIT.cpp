@@ -780,6 +780,11 @@ void JIT::compileWithoutLinking(JITCompilationEffort effort)
         if (Options::reportTotalCompileTimes())
             totalBaselineCompileTime += after - before;
     }
+    if (UNLIKELY(m_compilation)) {
+        m_compilation->setBytecodeSize(m_codeBlock->instructionsSize());
+        m_compilation->setMachineCodeSize(m_linkBuffer->size());
+        m_compilation->setCompileTime(after - before);
+    }
     if (UNLIKELY(reportCompileTimes())) {
         CString codeBlockName = toCString(*m_codeBlock);
         
@@ -991,9 +996,11 @@ bool JIT::reportCompileTimes()
     return Options::reportCompileTimes() || Options::reportBaselineCompileTimes();
 }
 
-bool JIT::computeCompileTimes()
+bool JIT::computeCompileTimes() const
 {
-    return reportCompileTimes() || Options::reportTotalCompileTimes();
+    return reportCompileTimes()
+        || Options::reportTotalCompileTimes()
+        || m_vm->m_perBytecodeProfiler;
 }
 
 HashMap<CString, Seconds> JIT::compileTimeStats()
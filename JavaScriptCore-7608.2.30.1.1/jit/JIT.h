@@ -906,7 +906,7 @@ namespace JSC {
 #endif
 
         static bool reportCompileTimes();
-        static bool computeCompileTimes();
+        bool computeCompileTimes() const;
         
         // If you need to check a value from the metadata table and you need it to
         // be consistent across the fast and slow path, then you want to use this.
@@ -1301,6 +1301,8 @@ void JIT::emit_op_profile_type(const Instruction* currentInstruction)
     // Load the type profiling log into T2.
     TypeProfilerLog* cachedTypeProfilerLog = m_vm->typeProfilerLog();
     move(TrustedImmPtr(cachedTypeProfilerLog), regT2);
+    if (cachedTypeProfilerLog->isSampling())
+        jumpToEnd.append(branchIfTypeProfilerEventNotSampled(cachedTypeProfilerLog, regT2, regT1));
 
     // Load the next log entry into T1.
     loadPtr(Address(regT2, TypeProfilerLog::currentLogEntryOffset()), regT1);
@@ -65,12 +65,64 @@ void PolymorphicCallCase::dump(PrintStream& out) const
     out.print("<variant = ", m_variant, ", codeBlock = ", pointerDump(m_codeBlock), ">");
 }
 
+PolymorphicCallDispatchTable::PolymorphicCallDispatchTable(unsigned size, unsigned shift)
+    : m_size(size)
+    , m_shift(shift)
+    , m_keys(makeUniqueArray<ExecutableBase*>(size))
+    , m_entrypoints(makeUniqueArray<void*>(size))
+{
+    for (unsigned i = 0; i < size; ++i) {
+        m_keys[i] = nullptr;
+        m_entrypoints[i] = nullptr;
+    }
+}
+
+std::unique_ptr<PolymorphicCallDispatchTable> PolymorphicCallDispatchTable::tryCreate(const Vector<ExecutableBase*>& executables)
+{
+    // Executables are cells, so the low bits of their addresses carry no information. Start with
+    // twice as many slots as executables and grow a little if no shift avoids collisions.
+    static constexpr unsigned minShift = 4;
+    static constexpr unsigned maxShift = 20;
+    unsigned minSize = roundUpToPowerOfTwo(std::max<unsigned>(executables.size(), 1) * 2);
+    Vector<bool> used;
+    for (unsigned size = minSize; size <= minSize * 4; size *= 2) {
+        for (unsigned shift = minShift; shift <= maxShift; ++shift) {
+            used.fill(false, size);
+            bool collided = false;
+            for (ExecutableBase* executable : executables) {
+                unsigned slot = (bitwise_cast<uintptr_t>(executable) >> shift) & (size - 1);
+                if (used[slot]) {
+                    collided = true;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (collided)
+                continue;
+
+            std::unique_ptr<PolymorphicCallDispatchTable> table(new PolymorphicCallDispatchTable(size, shift));
+            for (ExecutableBase* executable : executables)
+                table->m_keys[table->slotFor(executable)] = executable;
+            return table;
+        }
+    }
+    return nullptr;
+}
+
+void PolymorphicCallDispatchTable::setEntrypoint(ExecutableBase* executable, MacroAssemblerCodePtr<JSEntryPtrTag> codePtr)
+{
+    unsigned slot = slotFor(executable);
+    RELEASE_ASSERT(m_keys[slot] == executable);
+    m_entrypoints[slot] = codePtr.executableAddress();
+}
+
 PolymorphicCallStubRoutine::PolymorphicCallStubRoutine(
     const MacroAssemblerCodeRef<JITStubRoutinePtrTag>& codeRef, VM& vm, const JSCell* owner, ExecState* callerFrame,
     CallLinkInfo& info, const Vector<PolymorphicCallCase>& cases,
-    UniqueArray<uint32_t>&& fastCounts)
+    UniqueArray<uint32_t>&& fastCounts, std::unique_ptr<PolymorphicCallDispatchTable>&& dispatchTable)
     : GCAwareJITStubRoutine(codeRef, vm)
     , m_fastCounts(WTFMove(fastCounts))
+    , m_dispatchTable(WTFMove(dispatchTable))
 {
     for (PolymorphicCallCase callCase : cases) {
         m_variants.append(WriteBarrier<JSCell>(vm, owner, callCase.variant().rawCalleeCell()));
@@ -112,8 +164,11 @@ CallEdgeList PolymorphicCallStubRoutine::edges() const
     RELEASE_ASSERT(m_fastCounts);
     
     CallEdgeList result;
-    for (size_t i = 0; i < m_variants.size(); ++i)
-        result.append(CallEdge(CallVariant(m_variants[i].get()), m_fastCounts[i]));
+    for (size_t i = 0; i < m_variants.size(); ++i) {
+        CallVariant variant(m_variants[i].get());
+        unsigned countIndex = m_dispatchTable ? m_dispatchTable->slotFor(variant.executable()) : i;
+        result.append(CallEdge(variant, m_fastCounts[countIndex]));
+    }
     return result;
 }
 
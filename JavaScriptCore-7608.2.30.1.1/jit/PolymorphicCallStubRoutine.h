@@ -29,7 +29,9 @@
 
 #include "CallEdge.h"
 #include "CallVariant.h"
+#include "CodeOrigin.h"
 #include "GCAwareJITStubRoutine.h"
+#include "MacroAssemblerCodeRef.h"
 #include <wtf/Noncopyable.h>
 #include <wtf/UniqueArray.h>
 #include <wtf/Vector.h>
@@ -80,12 +82,66 @@ private:
     CodeBlock* m_codeBlock;
 };
 
+// Call sites with more targets than a binary switch handles well dispatch through this table
+// instead. It maps each target executable to its own slot by shifting and masking the executable
+// pointer, so a call is one load and compare followed by an indirect call to the entrypoint.
+class PolymorphicCallDispatchTable {
+    WTF_MAKE_NONCOPYABLE(PolymorphicCallDispatchTable);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Returns null if no reasonably sized table gives every executable a slot of its own.
+    static std::unique_ptr<PolymorphicCallDispatchTable> tryCreate(const Vector<ExecutableBase*>&);
+
+    unsigned size() const { return m_size; }
+    unsigned shift() const { return m_shift; }
+    unsigned mask() const { return m_size - 1; }
+    unsigned slotFor(ExecutableBase* executable) const { return (bitwise_cast<uintptr_t>(executable) >> m_shift) & mask(); }
+
+    void setEntrypoint(ExecutableBase*, MacroAssemblerCodePtr<JSEntryPtrTag>);
+
+    ExecutableBase* const* keys() const { return m_keys.get(); }
+    void* const* entrypoints() const { return m_entrypoints.get(); }
+
+    // Every tier counts hits and misses, unlike the per-slot fast counts. A call site that misses is
+    // relinked with a new table, which carries the counts of the table it replaces.
+    uint32_t* addressOfHitCount() { return &m_hitCount; }
+    uint32_t* addressOfMissCount() { return &m_missCount; }
+    uint64_t hitCount() const { return m_previousHitCount + m_hitCount; }
+    uint64_t missCount() const { return m_previousMissCount + m_missCount; }
+    void inheritCounts(const PolymorphicCallDispatchTable& previous)
+    {
+        m_previousHitCount = previous.hitCount();
+        m_previousMissCount = previous.missCount();
+    }
+
+private:
+    PolymorphicCallDispatchTable(unsigned size, unsigned shift);
+
+    unsigned m_size;
+    unsigned m_shift;
+    uint32_t m_hitCount { 0 };
+    uint32_t m_missCount { 0 };
+    uint64_t m_previousHitCount { 0 };
+    uint64_t m_previousMissCount { 0 };
+    UniqueArray<ExecutableBase*> m_keys;
+    UniqueArray<void*> m_entrypoints;
+};
+
+// What a call site linked through a dispatch table has seen so far. See CodeBlock::callDispatchTableStatistics().
+struct PolymorphicCallDispatchTableStatistics {
+    CodeOrigin codeOrigin;
+    unsigned size;
+    uint64_t hits;
+    uint64_t misses;
+    Vector<ExecutableBase*> targets;
+};
+
 class PolymorphicCallStubRoutine : public GCAwareJITStubRoutine {
 public:
     PolymorphicCallStubRoutine(
         const MacroAssemblerCodeRef<JITStubRoutinePtrTag>&, VM&, const JSCell* owner,
         ExecState* callerFrame, CallLinkInfo&, const Vector<PolymorphicCallCase>&,
-        UniqueArray<uint32_t>&& fastCounts);
+        UniqueArray<uint32_t>&& fastCounts, std::unique_ptr<PolymorphicCallDispatchTable>&& = nullptr);
     
     virtual ~PolymorphicCallStubRoutine();
     
@@ -93,6 +149,11 @@ public:
     bool hasEdges() const;
     CallEdgeList edges() const;
 
+    // When there is a dispatch table, the variants are executables and the fast counts are
+    // indexed by table slot rather than by variant.
+    bool hasDispatchTable() const { return !!m_dispatchTable; }
+    const PolymorphicCallDispatchTable* dispatchTable() const { return m_dispatchTable.get(); }
+
     void clearCallNodesFor(CallLinkInfo*);
     
     bool visitWeak(VM&) override;
@@ -103,6 +164,7 @@ protected:
 private:
     Vector<WriteBarrier<JSCell>, 2> m_variants;
     UniqueArray<uint32_t> m_fastCounts;
+    std::unique_ptr<PolymorphicCallDispatchTable> m_dispatchTable;
     Bag<PolymorphicCallNode> m_callNodes;
 };
 
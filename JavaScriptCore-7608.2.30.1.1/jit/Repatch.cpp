@@ -34,6 +34,7 @@
 #include "DFGOperations.h"
 #include "DFGSpeculativeJIT.h"
 #include "DOMJITGetterSetter.h"
+#include "DictionaryAccessCase.h"
 #include "DirectArguments.h"
 #include "ExecutableBaseInlines.h"
 #include "FTLThunks.h"
@@ -238,6 +239,18 @@ static InlineCacheAction tryCacheGetByID(ExecState* exec, JSValue baseValue, con
                 newCase = ModuleNamespaceAccessCase::create(vm, codeBlock, jsCast<JSModuleNamespaceObject*>(baseCell), moduleNamespaceSlot->environment, ScopeOffset(moduleNamespaceSlot->scopeOffset));
         }
         
+        if (!newCase && baseCell->structure(vm)->isUncacheableDictionary()) {
+            LOG_IC((ICEvent::GetByIdUncacheableDictionary, baseValue.classInfoOrNull(vm), propertyName, slot.slotBase() == baseValue));
+
+            // Flattening once is cheap and lets us use the ordinary cases. If the object went back to
+            // being an uncacheable dictionary, stop flattening it and probe its table instead.
+            Structure* structure = baseCell->structure(vm);
+            if (structure->hasBeenFlattenedBefore() && DictionaryAccessCase::canBeUsedFor(vm, baseCell, slot)) {
+                LOG_IC((ICEvent::GetByIdAddDictionaryAccessCase, baseValue.classInfoOrNull(vm), propertyName, true));
+                newCase = DictionaryAccessCase::create(vm, codeBlock, structure);
+            }
+        }
+
         if (!newCase) {
             if (!slot.isCacheable() && !slot.isUnset())
                 return GiveUpOnCache;
@@ -952,6 +965,141 @@ struct CallToCodePtr {
 };
 } // annonymous namespace
 
+// Megamorphic call sites, like framework dispatch code, see more callees than a binary switch
+// handles well. Rather than going virtual, key a dispatch table on the callee's executable. The
+// optimizing tiers can still inline the hottest targets based on this stub's counts, and their
+// own generic calls will link to a dispatch table as well.
+static bool linkPolymorphicCallThroughDispatchTable(
+    ExecState* exec, CallLinkInfo& callLinkInfo, const CallVariantList& variants)
+{
+    // Tail calls would need a frame shuffle per entrypoint, and varargs calls can't be checked
+    // for arity up front.
+    if (callLinkInfo.isTailCall() || callLinkInfo.isVarargs())
+        return false;
+
+    CallVariantList list = despecifiedVariantList(variants);
+    if (list.size() > Options::maxPolymorphicCallDispatchTableSize())
+        return false;
+
+    CallFrame* callerFrame = exec->callerFrame();
+    VM& vm = callerFrame->vm();
+    CodeBlock* callerCodeBlock = callerFrame->codeBlock();
+
+    Vector<PolymorphicCallCase> callCases;
+    Vector<ExecutableBase*> executables;
+    for (CallVariant variant : list) {
+        // InternalFunctions have no executable to key on.
+        ExecutableBase* executable = variant.executable();
+        if (!executable)
+            return false;
+        CodeBlock* codeBlock = nullptr;
+        if (!executable->isHostFunction()) {
+            codeBlock = jsCast<FunctionExecutable*>(executable)->codeBlockForCall();
+            if (!codeBlock || exec->argumentCountIncludingThis() < static_cast<size_t>(codeBlock->numParameters()))
+                return false;
+        }
+        callCases.append(PolymorphicCallCase(variant, codeBlock));
+        executables.append(executable);
+    }
+
+    std::unique_ptr<PolymorphicCallDispatchTable> dispatchTable = PolymorphicCallDispatchTable::tryCreate(executables);
+    if (!dispatchTable)
+        return false;
+    if (PolymorphicCallStubRoutine* oldStub = callLinkInfo.stub()) {
+        if (const PolymorphicCallDispatchTable* oldTable = oldStub->dispatchTable())
+            dispatchTable->inheritCounts(*oldTable);
+    }
+    for (ExecutableBase* executable : executables) {
+        ASSERT(executable->hasJITCodeForCall());
+        dispatchTable->setEntrypoint(executable, executable->generatedJITCodeForCall()->addressForCall(ArityCheckNotRequired));
+    }
+
+    UniqueArray<uint32_t> fastCounts;
+    if (callerCodeBlock->jitType() != JITCode::topTierJIT()) {
+        fastCounts = makeUniqueArray<uint32_t>(dispatchTable->size());
+        for (unsigned i = 0; i < dispatchTable->size(); ++i)
+            fastCounts[i] = 0;
+    }
+
+    GPRReg calleeGPR = callLinkInfo.calleeGPR();
+    GPRReg executableGPR = AssemblyHelpers::selectScratchGPR(calleeGPR);
+    GPRReg slotGPR = AssemblyHelpers::selectScratchGPR(calleeGPR, executableGPR);
+    GPRReg scratchGPR = AssemblyHelpers::selectScratchGPR(calleeGPR, executableGPR, slotGPR);
+
+    CCallHelpers stubJit(callerCodeBlock);
+
+    CCallHelpers::JumpList slowPath;
+#if USE(JSVALUE64)
+    slowPath.append(stubJit.branchIfNotCell(calleeGPR));
+#else
+    // We would have already checked that the callee is a cell.
+#endif
+    slowPath.append(stubJit.branchIfNotFunction(calleeGPR));
+    stubJit.loadPtr(CCallHelpers::Address(calleeGPR, JSFunction::offsetOfExecutable()), executableGPR);
+
+    stubJit.move(executableGPR, slotGPR);
+    stubJit.urshiftPtr(CCallHelpers::Imm32(dispatchTable->shift()), slotGPR);
+    stubJit.andPtr(CCallHelpers::TrustedImm32(dispatchTable->mask()), slotGPR);
+    stubJit.move(CCallHelpers::TrustedImmPtr(dispatchTable->keys()), scratchGPR);
+    stubJit.loadPtr(CCallHelpers::BaseIndex(scratchGPR, slotGPR, CCallHelpers::timesPtr()), scratchGPR);
+    slowPath.append(stubJit.branchPtr(CCallHelpers::NotEqual, scratchGPR, executableGPR));
+
+    stubJit.add32(CCallHelpers::TrustedImm32(1), CCallHelpers::AbsoluteAddress(dispatchTable->addressOfHitCount()));
+    if (fastCounts) {
+        stubJit.move(CCallHelpers::TrustedImmPtr(fastCounts.get()), scratchGPR);
+        stubJit.add32(CCallHelpers::TrustedImm32(1), CCallHelpers::BaseIndex(scratchGPR, slotGPR, CCallHelpers::TimesFour));
+    }
+    stubJit.move(CCallHelpers::TrustedImmPtr(dispatchTable->entrypoints()), scratchGPR);
+    stubJit.loadPtr(CCallHelpers::BaseIndex(scratchGPR, slotGPR, CCallHelpers::timesPtr()), scratchGPR);
+    stubJit.call(scratchGPR, JSEntryPtrTag);
+    CCallHelpers::Jump done = stubJit.jump();
+
+    slowPath.link(&stubJit);
+    stubJit.add32(CCallHelpers::TrustedImm32(1), CCallHelpers::AbsoluteAddress(dispatchTable->addressOfMissCount()));
+    stubJit.move(calleeGPR, GPRInfo::regT0);
+#if USE(JSVALUE32_64)
+    stubJit.move(CCallHelpers::TrustedImm32(JSValue::CellTag), GPRInfo::regT1);
+#endif
+    stubJit.move(CCallHelpers::TrustedImmPtr(&callLinkInfo), GPRInfo::regT2);
+    stubJit.move(CCallHelpers::TrustedImmPtr(callLinkInfo.callReturnLocation().untaggedExecutableAddress()), GPRInfo::regT4);
+    stubJit.restoreReturnAddressBeforeReturn(GPRInfo::regT4);
+    AssemblyHelpers::Jump slow = stubJit.jump();
+
+    LinkBuffer patchBuffer(stubJit, callerCodeBlock, JITCompilationCanFail);
+    if (patchBuffer.didFailToAllocate())
+        return false;
+
+    if (JITCode::isOptimizingJIT(callerCodeBlock->jitType()))
+        patchBuffer.link(done, callLinkInfo.callReturnLocation().labelAtOffset(0));
+    else
+        patchBuffer.link(done, callLinkInfo.hotPathOther().labelAtOffset(0));
+    patchBuffer.link(slow, CodeLocationLabel<JITThunkPtrTag>(vm.getCTIStub(linkPolymorphicCallThunkGenerator).code()));
+
+    if (Options::verboseCallLink())
+        dataLog("Linking dispatch table call at ", callLinkInfo.codeOrigin(), " in ", *callerCodeBlock, ": ", callCases.size(), " targets in ", dispatchTable->size(), " slots\n");
+
+    unsigned tableSize = dispatchTable->size();
+    auto stubRoutine = adoptRef(*new PolymorphicCallStubRoutine(
+        FINALIZE_CODE_FOR(
+            callerCodeBlock, patchBuffer, JITStubRoutinePtrTag,
+            "Polymorphic call dispatch table stub for %s, return point %p, %u targets in %u slots",
+                toCString(*callerCodeBlock).data(), callLinkInfo.callReturnLocation().labelAtOffset(0).executableAddress(),
+                static_cast<unsigned>(callCases.size()), tableSize),
+        vm, callerCodeBlock, callerFrame, callLinkInfo, callCases,
+        WTFMove(fastCounts), WTFMove(dispatchTable)));
+
+    MacroAssembler::replaceWithJump(
+        MacroAssembler::startOfBranchPtrWithPatchOnRegister(callLinkInfo.hotPathBegin()),
+        CodeLocationLabel<JITStubRoutinePtrTag>(stubRoutine->code().code()));
+    linkSlowFor(&vm, callLinkInfo);
+
+    callLinkInfo.setHasSeenClosure();
+    callLinkInfo.setStub(WTFMove(stubRoutine));
+    if (callLinkInfo.isOnList())
+        callLinkInfo.remove();
+    return true;
+}
+
 void linkPolymorphicCall(
     ExecState* exec, CallLinkInfo& callLinkInfo, CallVariant newVariant)
 {
@@ -1032,6 +1180,8 @@ void linkPolymorphicCall(
         maxPolymorphicCallVariantListSize = Options::maxPolymorphicCallVariantListSize();
 
     if (list.size() > maxPolymorphicCallVariantListSize) {
+        if (!isWebAssembly && linkPolymorphicCallThroughDispatchTable(exec, callLinkInfo, list))
+            return;
         linkVirtualFor(exec, callLinkInfo);
         return;
     }
@@ -22,6 +22,7 @@
 
 #include "config.h"
 
+#include "AllocationSiteProfiler.h"
 #include "ArrayBuffer.h"
 #include "ArrayPrototype.h"
 #include "BuiltinNames.h"
@@ -335,6 +336,9 @@ static EncodedJSValue JSC_HOST_CALL functionCheckModuleSyntax(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionPlatformSupportsSamplingProfiler(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionGenerateHeapSnapshot(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionGenerateHeapSnapshotForGCDebugging(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionStartAllocationSiteProfiler(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionAllocationSiteProfile(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionStructureMemoryStatistics(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionResetSuperSamplerState(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionEnsureArrayStorage(ExecState*);
 #if ENABLE(SAMPLING_PROFILER)
@@ -572,6 +576,9 @@ protected:
         addFunction(vm, "platformSupportsSamplingProfiler", functionPlatformSupportsSamplingProfiler, 0);
         addFunction(vm, "generateHeapSnapshot", functionGenerateHeapSnapshot, 0);
         addFunction(vm, "generateHeapSnapshotForGCDebugging", functionGenerateHeapSnapshotForGCDebugging, 0);
+        addFunction(vm, "startAllocationSiteProfiler", functionStartAllocationSiteProfiler, 1);
+        addFunction(vm, "allocationSiteProfile", functionAllocationSiteProfile, 0);
+        addFunction(vm, "structureMemoryStatistics", functionStructureMemoryStatistics, 0);
         addFunction(vm, "resetSuperSamplerState", functionResetSuperSamplerState, 0);
         addFunction(vm, "ensureArrayStorage", functionEnsureArrayStorage, 0);
 #if ENABLE(SAMPLING_PROFILER)
@@ -2296,6 +2303,60 @@ EncodedJSValue JSC_HOST_CALL functionGenerateHeapSnapshotForGCDebugging(ExecStat
     return JSValue::encode(jsString(&vm, jsonString));
 }
 
+EncodedJSValue JSC_HOST_CALL functionStartAllocationSiteProfiler(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    size_t samplingInterval = Options::allocationSiteProfilerSamplingInterval();
+    if (exec->argumentCount() >= 1) {
+        double interval = exec->argument(0).toNumber(exec);
+        RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        if (!(interval >= 1))
+            return throwVMRangeError(exec, scope, "Sampling interval must be at least one byte"_s);
+        samplingInterval = static_cast<size_t>(std::min<double>(interval, std::numeric_limits<unsigned>::max()));
+    }
+
+    vm.ensureAllocationSiteProfiler(samplingInterval);
+    return JSValue::encode(jsUndefined());
+}
+
+EncodedJSValue JSC_HOST_CALL functionAllocationSiteProfile(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    AllocationSiteProfiler* profiler = vm.allocationSiteProfiler();
+    if (!profiler)
+        return JSValue::encode(throwException(exec, scope, createError(exec, "Allocation site profiler was never started"_s)));
+
+    // Make sure the report only contains samples that survived a full collection.
+    vm.heap.collectNow(Sync, CollectionScope::Full);
+
+    String jsonString = profiler->json();
+    EncodedJSValue result = JSValue::encode(JSONParse(exec, jsonString));
+    scope.releaseAssertNoException();
+    return result;
+}
+
+EncodedJSValue JSC_HOST_CALL functionStructureMemoryStatistics(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+
+    StructureMemoryStatistics statistics = vm.heap.structureMemoryStatistics();
+
+    JSObject* result = constructEmptyObject(exec);
+    result->putDirect(vm, Identifier::fromString(exec, "structureCount"), jsNumber(statistics.structureCount));
+    result->putDirect(vm, Identifier::fromString(exec, "structureBytes"), jsNumber(statistics.structureBytes));
+    result->putDirect(vm, Identifier::fromString(exec, "propertyTableCount"), jsNumber(statistics.propertyTableCount));
+    result->putDirect(vm, Identifier::fromString(exec, "propertyTableBytes"), jsNumber(statistics.propertyTableBytes));
+    result->putDirect(vm, Identifier::fromString(exec, "pinnedPropertyTableCount"), jsNumber(statistics.pinnedPropertyTableCount));
+    result->putDirect(vm, Identifier::fromString(exec, "pinnedPropertyTableBytes"), jsNumber(statistics.pinnedPropertyTableBytes));
+    return JSValue::encode(result);
+}
+
 EncodedJSValue JSC_HOST_CALL functionResetSuperSamplerState(ExecState*)
 {
     resetSuperSamplerState();
@@ -3019,6 +3080,9 @@ int runJSC(const CommandLine& options, bool isWorker, const Func& func)
         std::sort(compileTimeKeys.begin(), compileTimeKeys.end());
         for (const CString& key : compileTimeKeys)
             printf("%40s: %.3lf ms\n", key.data(), compileTimeStats.get(key).milliseconds());
+
+        if (Options::dumpExecutableAllocatorStatistics())
+            ExecutableAllocator::dumpStatistics();
     }
 #endif
 
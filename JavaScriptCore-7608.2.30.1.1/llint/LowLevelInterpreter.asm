@@ -1494,14 +1494,12 @@ slowPathOp(enumerator_generic_pname)
 slowPathOp(enumerator_structure_pname)
 slowPathOp(get_by_id_with_this)
 slowPathOp(get_by_val_with_this)
-slowPathOp(get_direct_pname)
 slowPathOp(get_enumerable_length)
 slowPathOp(get_property_enumerator)
 slowPathOp(greater)
 slowPathOp(greatereq)
 slowPathOp(has_generic_property)
 slowPathOp(has_indexed_property)
-slowPathOp(has_structure_property)
 slowPathOp(in_by_id)
 slowPathOp(in_by_val)
 slowPathOp(is_function)
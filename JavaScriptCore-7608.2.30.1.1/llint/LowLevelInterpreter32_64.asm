@@ -1339,6 +1339,45 @@ end
 # convert opcode into a get_by_id_proto_load/get_by_id_unset, respectively, after an
 # execution counter hits zero.
 
+# for-in loops over an object whose structure still matches the enumerator's cached structure
+# can read each property straight out of its slot. Enumerator indices count inline slots first,
+# then out-of-line slots, so they map onto PropertyOffsets with a single adjustment.
+llintOpWithReturn(op_has_structure_property, OpHasStructureProperty, macro (size, get, dispatch, return)
+    get(m_base, t0)
+    loadConstantOrVariablePayload(size, t0, CellTag, t3, .opHasStructurePropertySlow)
+    loadVariable(get, m_enumerator, t0, t1, t2)
+    loadi JSPropertyNameEnumerator::m_cachedStructureID[t2], t1
+    bineq JSCell::m_structureID[t3], t1, .opHasStructurePropertySlow
+    return(BooleanTag, 1)
+
+.opHasStructurePropertySlow:
+    callSlowPath(_slow_path_has_structure_property)
+    dispatch()
+end)
+
+
+llintOpWithProfile(op_get_direct_pname, OpGetDirectPname, macro (size, get, dispatch, return)
+    get(m_base, t0)
+    loadConstantOrVariablePayload(size, t0, CellTag, t3, .opGetDirectPnameSlow)
+    loadVariable(get, m_enumerator, t0, t1, t2)
+    loadi JSPropertyNameEnumerator::m_cachedStructureID[t2], t1
+    bineq JSCell::m_structureID[t3], t1, .opGetDirectPnameSlow
+    get(m_index, t0)
+    loadConstantOrVariablePayload(size, t0, Int32Tag, t1, .opGetDirectPnameSlow)
+    loadi JSPropertyNameEnumerator::m_cachedInlineCapacity[t2], t0
+    bilt t1, t0, .opGetDirectPnameLoad
+    subi t0, t1
+    addi firstOutOfLineOffset, t1
+.opGetDirectPnameLoad:
+    loadPropertyAtVariableOffset(t1, t3, t0, t2)
+    return(t0, t2)
+
+.opGetDirectPnameSlow:
+    callSlowPath(_slow_path_get_direct_pname)
+    dispatch()
+end)
+
+
 llintOpWithMetadata(op_get_by_id_direct, OpGetByIdDirect, macro (size, get, dispatch, metadata, return)
     metadata(t5, t0)
     get(m_base, t0)
@@ -2452,6 +2491,15 @@ llintOpWithMetadata(op_profile_type, OpProfileType, macro (size, get, dispatch,
 
     bieq t5, EmptyValueTag, .opProfileTypeDone
 
+    # Only one in every m_samplingInterval values is recorded. The countdown is rearmed
+    # to the interval whenever it reaches zero, so an interval of 1 records everything.
+    loadi TypeProfilerLog::m_samplingCountdown[t1], t3
+    subi 1, t3
+    storei t3, TypeProfilerLog::m_samplingCountdown[t1]
+    btinz t3, .opProfileTypeDone
+    loadi TypeProfilerLog::m_samplingInterval[t1], t3
+    storei t3, TypeProfilerLog::m_samplingCountdown[t1]
+
     metadata(t3, t2)
     # t2 is holding the pointer to the current log entry.
     loadp TypeProfilerLog::m_currentLogEntryPtr[t1], t2
@@ -1301,6 +1301,48 @@ macro storePropertyAtVariableOffset(propertyOffsetAsInt, objectAndStorage, value
 end
 
 
+# for-in loops over an object whose structure still matches the enumerator's cached structure
+# can read each property straight out of its slot. Enumerator indices count inline slots first,
+# then out-of-line slots, so they map onto PropertyOffsets with a single adjustment.
+llintOpWithReturn(op_has_structure_property, OpHasStructureProperty, macro (size, get, dispatch, return)
+    get(m_base, t0)
+    loadConstantOrVariableCell(size, t0, t1, .opHasStructurePropertySlow)
+    loadVariable(get, m_enumerator, t2)
+    loadi JSCell::m_structureID[t1], t0
+    loadi JSPropertyNameEnumerator::m_cachedStructureID[t2], t1
+    bineq t0, t1, .opHasStructurePropertySlow
+    return(ValueTrue)
+
+.opHasStructurePropertySlow:
+    callSlowPath(_slow_path_has_structure_property)
+    dispatch()
+end)
+
+
+llintOpWithProfile(op_get_direct_pname, OpGetDirectPname, macro (size, get, dispatch, return)
+    get(m_base, t0)
+    loadConstantOrVariableCell(size, t0, t1, .opGetDirectPnameSlow)
+    loadVariable(get, m_enumerator, t2)
+    loadi JSCell::m_structureID[t1], t0
+    loadi JSPropertyNameEnumerator::m_cachedStructureID[t2], t3
+    bineq t0, t3, .opGetDirectPnameSlow
+    get(m_index, t0)
+    loadConstantOrVariableInt32(size, t0, t3, .opGetDirectPnameSlow)
+    sxi2q t3, t3
+    loadi JSPropertyNameEnumerator::m_cachedInlineCapacity[t2], t0
+    bilt t3, t0, .opGetDirectPnameLoad
+    subi t0, t3
+    addi firstOutOfLineOffset, t3
+.opGetDirectPnameLoad:
+    loadPropertyAtVariableOffset(t3, t1, t0)
+    return(t0)
+
+.opGetDirectPnameSlow:
+    callSlowPath(_slow_path_get_direct_pname)
+    dispatch()
+end)
+
+
 llintOpWithMetadata(op_get_by_id_direct, OpGetByIdDirect, macro (size, get, dispatch, metadata, return)
     metadata(t2, t0)
     get(m_base, t0)
@@ -2511,6 +2553,16 @@ llintOpWithMetadata(op_profile_type, OpProfileType, macro (size, get, dispatch,
     loadConstantOrVariable(size, t3, t0)
 
     bqeq t0, ValueEmpty, .opProfileTypeDone
+
+    # Only one in every m_samplingInterval values is recorded. The countdown is rearmed
+    # to the interval whenever it reaches zero, so an interval of 1 records everything.
+    loadi TypeProfilerLog::m_samplingCountdown[t1], t3
+    subi 1, t3
+    storei t3, TypeProfilerLog::m_samplingCountdown[t1]
+    btinz t3, .opProfileTypeDone
+    loadi TypeProfilerLog::m_samplingInterval[t1], t3
+    storei t3, TypeProfilerLog::m_samplingCountdown[t1]
+
     # Store the JSValue onto the log entry.
     storeq t0, TypeProfilerLog::LogEntry::value[t2]
     
@@ -107,19 +107,72 @@ void Compilation::setJettisonReason(JettisonReason jettisonReason, const FireDet
         m_additionalJettisonReason = CString();
 }
 
+void Compilation::addPhaseTime(const char* compilerName, const char* phaseName, Seconds duration)
+{
+    // Phase names are static strings, and a compilation runs a few dozen distinct phases at most.
+    for (PhaseTime& phaseTime : m_phaseTimes) {
+        if (phaseTime.compilerName == compilerName && phaseTime.phaseName == phaseName) {
+            phaseTime.count++;
+            phaseTime.duration += duration;
+            return;
+        }
+    }
+    m_phaseTimes.append(PhaseTime { compilerName, phaseName, 1, duration });
+}
+
 void Compilation::dump(PrintStream& out) const
 {
     out.print("Comp", m_uid);
 }
 
-JSValue Compilation::toJS(ExecState* exec) const
+JSValue Compilation::recordToJS(ExecState* exec) const
 {
     VM& vm = exec->vm();
     auto scope = DECLARE_THROW_SCOPE(vm);
     JSObject* result = constructEmptyObject(exec);
     RETURN_IF_EXCEPTION(scope, { });
+    result->putDirect(vm, vm.propertyNames->uid, m_uid.toJS(exec));
     result->putDirect(vm, vm.propertyNames->bytecodesID, jsNumber(m_bytecodes->id()));
     result->putDirect(vm, vm.propertyNames->compilationKind, jsString(exec, String::fromUTF8(toCString(m_kind))));
+    result->putDirect(vm, vm.propertyNames->bytecodeSize, jsNumber(m_bytecodeSize));
+    result->putDirect(vm, vm.propertyNames->inlinedBytecodeSize, jsNumber(m_inlinedBytecodeSize));
+    result->putDirect(vm, vm.propertyNames->machineCodeSize, jsNumber(m_machineCodeSize));
+    result->putDirect(vm, vm.propertyNames->compileTime, jsNumber(m_compileTime.milliseconds()));
+    
+    JSArray* phaseTimes = constructEmptyArray(exec, 0);
+    RETURN_IF_EXCEPTION(scope, { });
+    for (unsigned i = 0; i < m_phaseTimes.size(); ++i) {
+        JSObject* phaseTime = constructEmptyObject(exec);
+        RETURN_IF_EXCEPTION(scope, { });
+        phaseTime->putDirect(vm, vm.propertyNames->compiler, jsString(exec, String::fromUTF8(m_phaseTimes[i].compilerName)));
+        phaseTime->putDirect(vm, vm.propertyNames->phase, jsString(exec, String::fromUTF8(m_phaseTimes[i].phaseName)));
+        phaseTime->putDirect(vm, vm.propertyNames->count, jsNumber(m_phaseTimes[i].count));
+        phaseTime->putDirect(vm, vm.propertyNames->time, jsNumber(m_phaseTimes[i].duration.milliseconds()));
+        phaseTimes->putDirectIndex(exec, i, phaseTime);
+        RETURN_IF_EXCEPTION(scope, { });
+    }
+    result->putDirect(vm, vm.propertyNames->phaseTimes, phaseTimes);
+    
+    uint64_t osrExitCount = 0;
+    for (unsigned i = 0; i < m_osrExits.size(); ++i)
+        osrExitCount += m_osrExits[i].count();
+    result->putDirect(vm, vm.propertyNames->osrExitCount, jsNumber(osrExitCount));
+    
+    result->putDirect(vm, vm.propertyNames->numInlinedCalls, jsNumber(m_numInlinedCalls));
+    result->putDirect(vm, vm.propertyNames->jettisonReason, jsString(exec, String::fromUTF8(toCString(m_jettisonReason))));
+    if (!m_additionalJettisonReason.isNull())
+        result->putDirect(vm, vm.propertyNames->additionalJettisonReason, jsString(exec, String::fromUTF8(m_additionalJettisonReason)));
+    
+    return result;
+}
+
+JSValue Compilation::toJS(ExecState* exec) const
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    JSValue record = recordToJS(exec);
+    RETURN_IF_EXCEPTION(scope, { });
+    JSObject* result = asObject(record);
     
     JSArray* profiledBytecodes = constructEmptyArray(exec, 0);
     RETURN_IF_EXCEPTION(scope, { });
@@ -175,12 +228,6 @@ JSValue Compilation::toJS(ExecState* exec) const
     
     result->putDirect(vm, vm.propertyNames->numInlinedGetByIds, jsNumber(m_numInlinedGetByIds));
     result->putDirect(vm, vm.propertyNames->numInlinedPutByIds, jsNumber(m_numInlinedPutByIds));
-    result->putDirect(vm, vm.propertyNames->numInlinedCalls, jsNumber(m_numInlinedCalls));
-    result->putDirect(vm, vm.propertyNames->jettisonReason, jsString(exec, String::fromUTF8(toCString(m_jettisonReason))));
-    if (!m_additionalJettisonReason.isNull())
-        result->putDirect(vm, vm.propertyNames->additionalJettisonReason, jsString(exec, String::fromUTF8(m_additionalJettisonReason)));
-    
-    result->putDirect(vm, vm.propertyNames->uid, m_uid.toJS(exec));
     
     return result;
 }
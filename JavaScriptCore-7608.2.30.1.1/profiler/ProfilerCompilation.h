@@ -37,6 +37,7 @@
 #include "ProfilerProfiledBytecodes.h"
 #include "ProfilerUID.h"
 #include <wtf/RefCounted.h>
+#include <wtf/Seconds.h>
 #include <wtf/SegmentedVector.h>
 
 namespace JSC {
@@ -75,12 +76,32 @@ public:
     
     void setJettisonReason(JettisonReason, const FireDetail*);
     
+    void setBytecodeSize(unsigned bytecodeSize) { m_bytecodeSize = bytecodeSize; }
+    void setInlinedBytecodeSize(unsigned inlinedBytecodeSize) { m_inlinedBytecodeSize = inlinedBytecodeSize; }
+    void setMachineCodeSize(size_t machineCodeSize) { m_machineCodeSize = machineCodeSize; }
+    void setCompileTime(Seconds compileTime) { m_compileTime = compileTime; }
+    
+    // Called by CompilerTimingScope on the compiler thread. Phases that run more than once are
+    // summed into a single entry.
+    void addPhaseTime(const char* compilerName, const char* phaseName, Seconds);
+    
     UID uid() const { return m_uid; }
     
     void dump(PrintStream&) const;
     JSValue toJS(ExecState*) const;
     
+    // Just the sizes, timings and outcome of the compilation, without the per-bytecode
+    // descriptions and counters that toJS() includes.
+    JSValue recordToJS(ExecState*) const;
+    
 private:
+    struct PhaseTime {
+        const char* compilerName;
+        const char* phaseName;
+        unsigned count;
+        Seconds duration;
+    };
+    
     CompilationKind m_kind;
     Bytecodes* m_bytecodes;
     Vector<ProfiledBytecodes> m_profiledBytecodes;
@@ -91,6 +112,11 @@ private:
     unsigned m_numInlinedGetByIds;
     unsigned m_numInlinedPutByIds;
     unsigned m_numInlinedCalls;
+    unsigned m_bytecodeSize { 0 };
+    unsigned m_inlinedBytecodeSize { 0 };
+    size_t m_machineCodeSize { 0 };
+    Seconds m_compileTime;
+    Vector<PhaseTime> m_phaseTimes;
     JettisonReason m_jettisonReason;
     CString m_additionalJettisonReason;
     UID m_uid;
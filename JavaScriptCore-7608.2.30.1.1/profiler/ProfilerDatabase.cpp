@@ -146,6 +146,32 @@ String Database::toJSON() const
     RELEASE_AND_RETURN(scope, JSONStringify(globalObject->globalExec(), value, 0));
 }
 
+JSValue Database::compilationRecordsToJS(ExecState* exec) const
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    JSArray* result = constructEmptyArray(exec, 0);
+    RETURN_IF_EXCEPTION(scope, { });
+    for (unsigned i = 0; i < m_compilations.size(); ++i) {
+        auto value = m_compilations[i]->recordToJS(exec);
+        RETURN_IF_EXCEPTION(scope, { });
+        result->putDirectIndex(exec, i, value);
+        RETURN_IF_EXCEPTION(scope, { });
+    }
+    return result;
+}
+
+String Database::compilationRecordsToJSON() const
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+    JSGlobalObject* globalObject = JSGlobalObject::create(
+        m_vm, JSGlobalObject::createStructure(m_vm, jsNull()));
+
+    auto value = compilationRecordsToJS(globalObject->globalExec());
+    RETURN_IF_EXCEPTION(scope, String());
+    RELEASE_AND_RETURN(scope, JSONStringify(globalObject->globalExec(), value, 0));
+}
+
 bool Database::save(const char* filename) const
 {
     auto scope = DECLARE_CATCH_SCOPE(m_vm);
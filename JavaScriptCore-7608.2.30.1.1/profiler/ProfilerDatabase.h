@@ -61,6 +61,11 @@ public:
     // and then returns the JSON representation of that object.
     JS_EXPORT_PRIVATE String toJSON() const;
     
+    // Like toJS() and toJSON(), but only includes a compact record of each compilation: its tier,
+    // bytecode and machine code sizes, per-phase compile times and how many OSR exits it took.
+    JS_EXPORT_PRIVATE JSValue compilationRecordsToJS(ExecState*) const;
+    JS_EXPORT_PRIVATE String compilationRecordsToJSON() const;
+    
     // Saves the JSON representation (from toJSON()) to the given file. Returns false if the
     // save failed.
     JS_EXPORT_PRIVATE bool save(const char* filename) const;
@@ -359,9 +359,7 @@ bool ArrayBuffer::transferTo(VM& vm, ArrayBufferContents& result)
         return true;
     }
 
-    bool isNeuterable = !m_pinCount && !m_locked;
-
-    if (!isNeuterable) {
+    if (!isNeuterable()) {
         m_contents.copyTo(result);
         if (!result.m_data)
             return false;
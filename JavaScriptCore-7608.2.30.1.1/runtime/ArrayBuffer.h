@@ -139,6 +139,7 @@ public:
     inline void unpin();
     inline void pinAndLock();
     inline bool isLocked();
+    inline bool isNeuterable();
 
     void makeWasmMemory();
     inline bool isWasmMemory();
@@ -221,6 +222,11 @@ bool ArrayBuffer::isLocked()
     return m_locked;
 }
 
+bool ArrayBuffer::isNeuterable()
+{
+    return !m_pinCount && !m_locked;
+}
+
 bool ArrayBuffer::isWasmMemory()
 {
     return m_isWasmMemory;
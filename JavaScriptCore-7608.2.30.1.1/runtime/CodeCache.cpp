@@ -27,6 +27,8 @@
 #include "CodeCache.h"
 
 #include "IndirectEvalExecutable.h"
+#include "JSTemplateObjectDescriptor.h"
+#include "WeakGCMapInlines.h"
 #include <wtf/text/StringConcatenateNumbers.h>
 
 namespace JSC {
@@ -52,6 +54,44 @@ void CodeCacheMap::pruneSlowCase()
     }
 }
 
+// UnlinkedSourceCode::hash() hashes the whole provider, but equal functions usually come from different providers.
+static unsigned hashSourceText(const SourceCode& source)
+{
+    StringView text = source.view();
+    if (text.is8Bit())
+        return StringHasher::computeHashAndMaskTop8Bits(text.characters8(), text.length());
+    return StringHasher::computeHashAndMaskTop8Bits(text.characters16(), text.length());
+}
+
+UnlinkedFunctionCodeBlockKey::UnlinkedFunctionCodeBlockKey(const UnlinkedFunctionExecutable& executable, const SourceCode& source, CodeSpecializationKind kind, SourceParseMode parseMode, OptionSet<CodeGenerationMode> codeGenerationMode, Optional<unsigned> startOffset)
+    : m_sourceCode(source)
+    , m_name(executable.name().string())
+    , m_parentScopeTDZVariables(executable.parentScopeTDZVariablesHandle())
+    , m_startOffset(startOffset ? static_cast<int64_t>(*startOffset) : -1)
+    , m_flags(
+        (static_cast<unsigned>(codeGenerationMode.toRaw()) << 10) |
+        (static_cast<unsigned>(executable.functionMode()) << 8) |
+        (static_cast<unsigned>(executable.derivedContextType()) << 6) |
+        (static_cast<unsigned>(executable.constructorKind()) << 4) |
+        (static_cast<unsigned>(executable.superBinding()) << 3) |
+        (static_cast<unsigned>(executable.scriptMode()) << 2) |
+        (static_cast<unsigned>(executable.isInStrictContext()) << 1) |
+        (static_cast<unsigned>(kind))
+    )
+    , m_parseMode(parseMode)
+    , m_hash(hashSourceText(source) ^ m_flags ^ (static_cast<unsigned>(parseMode) << 16))
+{
+}
+
+CodeCache::CodeCache(VM& vm)
+    : m_sharedFunctionCodeBlocks(vm)
+{
+}
+
+CodeCache::~CodeCache()
+{
+}
+
 template <class UnlinkedCodeBlockType, class ExecutableType>
 UnlinkedCodeBlockType* CodeCache::getUnlinkedGlobalCodeBlock(VM& vm, ExecutableType* executable, const SourceCode& source, JSParserStrictMode strictMode, JSParserScriptMode scriptMode, OptionSet<CodeGenerationMode> codeGenerationMode, ParserError& error, EvalContextType evalContextType)
 {
@@ -168,6 +208,50 @@ void CodeCache::updateCache(const UnlinkedFunctionExecutable* executable, const
     parentSource.provider()->updateCache(executable, parentSource, kind, codeBlock);
 }
 
+static bool canShareFunctionCodeBlock(const UnlinkedFunctionExecutable& executable, OptionSet<CodeGenerationMode> codeGenerationMode)
+{
+    if (!Options::useCodeCache() || !Options::useUnlinkedFunctionCodeBlockSharing())
+        return false;
+    if (executable.isBuiltinFunction())
+        return false;
+    // The profilers' hooks record absolute source offsets.
+    return !codeGenerationMode.contains(CodeGenerationMode::TypeProfiler) && !codeGenerationMode.contains(CodeGenerationMode::ControlFlowProfiler);
+}
+
+// Nested functions remember where they start in their provider, and template objects are keyed by where
+// their literal ends, so a code block holding either is only valid for functions at the same offset.
+static bool isPositionIndependent(VM& vm, UnlinkedFunctionCodeBlock* codeBlock)
+{
+    if (codeBlock->numberOfFunctionDecls() || codeBlock->numberOfFunctionExprs())
+        return false;
+    for (auto& constant : codeBlock->constantRegisters()) {
+        if (jsDynamicCast<JSTemplateObjectDescriptor*>(vm, constant.get()))
+            return false;
+    }
+    return true;
+}
+
+UnlinkedFunctionCodeBlock* CodeCache::findSharedFunctionCodeBlock(const UnlinkedFunctionExecutable& executable, const SourceCode& source, CodeSpecializationKind kind, SourceParseMode parseMode, OptionSet<CodeGenerationMode> codeGenerationMode)
+{
+    if (!canShareFunctionCodeBlock(executable, codeGenerationMode))
+        return nullptr;
+
+    if (UnlinkedFunctionCodeBlock* codeBlock = m_sharedFunctionCodeBlocks.get(UnlinkedFunctionCodeBlockKey(executable, source, kind, parseMode, codeGenerationMode, WTF::nullopt)))
+        return codeBlock;
+    return m_sharedFunctionCodeBlocks.get(UnlinkedFunctionCodeBlockKey(executable, source, kind, parseMode, codeGenerationMode, static_cast<unsigned>(source.startOffset())));
+}
+
+void CodeCache::addSharedFunctionCodeBlock(VM& vm, const UnlinkedFunctionExecutable& executable, const SourceCode& source, CodeSpecializationKind kind, SourceParseMode parseMode, OptionSet<CodeGenerationMode> codeGenerationMode, UnlinkedFunctionCodeBlock* codeBlock)
+{
+    if (!canShareFunctionCodeBlock(executable, codeGenerationMode))
+        return;
+
+    Optional<unsigned> startOffset;
+    if (!isPositionIndependent(vm, codeBlock))
+        startOffset = static_cast<unsigned>(source.startOffset());
+    m_sharedFunctionCodeBlocks.set(UnlinkedFunctionCodeBlockKey(executable, source, kind, parseMode, codeGenerationMode, startOffset), Weak<UnlinkedFunctionCodeBlock>(codeBlock));
+}
+
 void CodeCache::write(VM& vm)
 {
     for (auto& it : m_sourceCode)
@@ -39,6 +39,7 @@
 #include "UnlinkedFunctionCodeBlock.h"
 #include "UnlinkedModuleProgramCodeBlock.h"
 #include "UnlinkedProgramCodeBlock.h"
+#include "WeakGCMap.h"
 
 namespace JSC {
 
@@ -218,10 +219,79 @@ private:
     int64_t m_age;
 };
 
+// Identifies the bytecode a function body generates. Functions with the same text that are compiled
+// in the same context generate identical UnlinkedFunctionCodeBlocks, wherever their text came from.
+class UnlinkedFunctionCodeBlockKey {
+public:
+    UnlinkedFunctionCodeBlockKey()
+    {
+    }
+
+    // A null startOffset means the code block does not depend on where the function sits in its provider.
+    UnlinkedFunctionCodeBlockKey(const UnlinkedFunctionExecutable&, const SourceCode&, CodeSpecializationKind, SourceParseMode, OptionSet<CodeGenerationMode>, Optional<unsigned> startOffset);
+
+    UnlinkedFunctionCodeBlockKey(WTF::HashTableDeletedValueType)
+        : m_sourceCode(WTF::HashTableDeletedValue)
+    {
+    }
+
+    bool isHashTableDeletedValue() const { return m_sourceCode.isHashTableDeletedValue(); }
+
+    unsigned hash() const { return m_hash; }
+
+    size_t length() const { return m_sourceCode.length(); }
+
+    bool isNull() const { return m_sourceCode.isNull(); }
+
+    bool operator==(const UnlinkedFunctionCodeBlockKey& other) const
+    {
+        return m_hash == other.m_hash
+            && length() == other.length()
+            && m_flags == other.m_flags
+            && m_parseMode == other.m_parseMode
+            && m_startOffset == other.m_startOffset
+            && parentScopeTDZVariables() == other.parentScopeTDZVariables()
+            && m_name == other.m_name
+            && m_sourceCode.provider().url().host() == other.m_sourceCode.provider().url().host()
+            && m_sourceCode.view() == other.m_sourceCode.view();
+    }
+
+    struct Hash {
+        static unsigned hash(const UnlinkedFunctionCodeBlockKey& key) { return key.hash(); }
+        static bool equal(const UnlinkedFunctionCodeBlockKey& a, const UnlinkedFunctionCodeBlockKey& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = false;
+    };
+
+    struct HashTraits : SimpleClassHashTraits<UnlinkedFunctionCodeBlockKey> {
+        static const bool hasIsEmptyValueFunction = true;
+        static bool isEmptyValue(const UnlinkedFunctionCodeBlockKey& key) { return key.isNull(); }
+    };
+
+private:
+    // CompactVariableMap uniques environments, so equal TDZ sets share one environment.
+    const CompactVariableEnvironment* parentScopeTDZVariables() const
+    {
+        return m_parentScopeTDZVariables ? &m_parentScopeTDZVariables.environment() : nullptr;
+    }
+
+    UnlinkedSourceCode m_sourceCode;
+    String m_name;
+    CompactVariableMap::Handle m_parentScopeTDZVariables;
+    int64_t m_startOffset { -1 };
+    unsigned m_flags { 0 };
+    SourceParseMode m_parseMode { SourceParseMode::NormalFunctionMode };
+    unsigned m_hash { 0 };
+};
+
 // Caches top-level code such as <script>, window.eval(), new Function, and JSEvaluateScript().
+// It also lets functions with identical bodies share one UnlinkedFunctionCodeBlock, which saves
+// both the memory and the bytecode generation for helpers that bundles repeat in many places.
 class CodeCache {
     WTF_MAKE_FAST_ALLOCATED;
 public:
+    CodeCache(VM&);
+    ~CodeCache();
+
     UnlinkedProgramCodeBlock* getUnlinkedProgramCodeBlock(VM&, ProgramExecutable*, const SourceCode&, JSParserStrictMode, OptionSet<CodeGenerationMode>, ParserError&);
     UnlinkedEvalCodeBlock* getUnlinkedEvalCodeBlock(VM&, IndirectEvalExecutable*, const SourceCode&, JSParserStrictMode, OptionSet<CodeGenerationMode>, ParserError&, EvalContextType);
     UnlinkedModuleProgramCodeBlock* getUnlinkedModuleProgramCodeBlock(VM&, ModuleProgramExecutable*, const SourceCode&, OptionSet<CodeGenerationMode>, ParserError&);
@@ -229,7 +299,14 @@ public:
 
     void updateCache(const UnlinkedFunctionExecutable*, const SourceCode&, CodeSpecializationKind, const UnlinkedFunctionCodeBlock*);
 
-    void clear() { m_sourceCode.clear(); }
+    UnlinkedFunctionCodeBlock* findSharedFunctionCodeBlock(const UnlinkedFunctionExecutable&, const SourceCode&, CodeSpecializationKind, SourceParseMode, OptionSet<CodeGenerationMode>);
+    void addSharedFunctionCodeBlock(VM&, const UnlinkedFunctionExecutable&, const SourceCode&, CodeSpecializationKind, SourceParseMode, OptionSet<CodeGenerationMode>, UnlinkedFunctionCodeBlock*);
+
+    void clear()
+    {
+        m_sourceCode.clear();
+        m_sharedFunctionCodeBlocks.clear();
+    }
     JS_EXPORT_PRIVATE void write(VM&);
 
 private:
@@ -237,6 +314,7 @@ private:
     UnlinkedCodeBlockType* getUnlinkedGlobalCodeBlock(VM&, ExecutableType*, const SourceCode&, JSParserStrictMode, JSParserScriptMode, OptionSet<CodeGenerationMode>, ParserError&, EvalContextType);
 
     CodeCacheMap m_sourceCode;
+    WeakGCMap<UnlinkedFunctionCodeBlockKey, UnlinkedFunctionCodeBlock, UnlinkedFunctionCodeBlockKey::Hash, UnlinkedFunctionCodeBlockKey::HashTraits> m_sharedFunctionCodeBlocks;
 };
 
 template <typename T> struct CacheTypes { };
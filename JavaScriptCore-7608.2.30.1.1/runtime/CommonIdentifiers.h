@@ -70,6 +70,7 @@
     macro(byteOffset) \
     macro(bytecode) \
     macro(bytecodeIndex) \
+    macro(bytecodeSize) \
     macro(bytecodes) \
     macro(bytecodesID) \
     macro(calendar) \
@@ -83,6 +84,8 @@
     macro(compilationUID) \
     macro(compilations) \
     macro(compile) \
+    macro(compileTime) \
+    macro(compiler) \
     macro(configurable) \
     macro(constructor) \
     macro(count) \
@@ -126,6 +129,7 @@
     macro(ignorePunctuation) \
     macro(index) \
     macro(inferredName) \
+    macro(inlinedBytecodeSize) \
     macro(input) \
     macro(instructionCount) \
     macro(isArray) \
@@ -140,6 +144,7 @@
     macro(line) \
     macro(locale) \
     macro(localeMatcher) \
+    macro(machineCodeSize) \
     macro(message) \
     macro(minute) \
     macro(month) \
@@ -155,11 +160,14 @@
     macro(of) \
     macro(opcode) \
     macro(origin) \
+    macro(osrExitCount) \
     macro(osrExitSites) \
     macro(osrExits) \
     macro(parse) \
     macro(parseInt) \
     macro(parseFloat) \
+    macro(phase) \
+    macro(phaseTimes) \
     macro(profiledBytecodes) \
     macro(propertyIsEnumerable) \
     macro(prototype) \
@@ -963,7 +963,7 @@ SLOW_PATH_DECL(slow_path_get_direct_pname)
     JSString* string = asString(property);
     auto propertyName = string->toIdentifier(exec);
     CHECK_EXCEPTION();
-    RETURN(baseValue.get(exec, propertyName));
+    RETURN_PROFILED(baseValue.get(exec, propertyName));
 }
 
 SLOW_PATH_DECL(slow_path_get_property_enumerator)
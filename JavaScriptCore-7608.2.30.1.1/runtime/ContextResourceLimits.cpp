@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "ContextResourceLimits.h"
+
+#include "VM.h"
+
+namespace JSC {
+
+// Once a context is past all of its limits, keep checking only after it grows by this fraction of
+// its smallest limit, so that a terminated context that is still referenced does not trap on every
+// free list refill.
+static constexpr size_t memoryLimitCheckSlackDivisor = 4;
+
+ContextResourceLimits::ContextResourceLimits(VM& vm)
+    : m_vm(vm)
+{
+    m_vm.heap.didCreateContextResourceLimits(this);
+}
+
+ContextResourceLimits::~ContextResourceLimits()
+{
+    m_vm.heap.willDestroyContextResourceLimits(this);
+}
+
+void ContextResourceLimits::setMemoryLimits(size_t softLimit, size_t hardLimit)
+{
+    if (softLimit && hardLimit && softLimit > hardLimit)
+        softLimit = hardLimit;
+    m_softMemoryLimit = softLimit;
+    m_hardMemoryLimit = hardLimit;
+
+    // Memory limit checks are requested by the mutator from inside allocation, so they can only be
+    // serviced by polling. Optimized code compiled before any limit existed relies on signals instead,
+    // so throw it away. Code that is already on the stack keeps running until it returns.
+    VMTraps& traps = m_vm.traps();
+    if ((softLimit || hardLimit) && !traps.shouldEmitPollingTrapChecks()) {
+        traps.requirePollingTrapChecks();
+        if (!m_vm.entryScope)
+            m_vm.deleteAllCode(PreventCollectionAndDeleteAllCode);
+    }
+
+    updateNextMemoryLimitCheck();
+    if (m_estimatedLiveBytes >= m_nextMemoryLimitCheck)
+        requestMemoryLimitCheck();
+}
+
+void ContextResourceLimits::didFinishFullCollection(double survivalRate)
+{
+    ASSERT(survivalRate >= 0 && survivalRate <= 1);
+    m_estimatedLiveBytes = static_cast<size_t>(m_estimatedLiveBytes * survivalRate);
+    if (!m_needsMemoryLimitCheck)
+        updateNextMemoryLimitCheck();
+}
+
+bool ContextResourceLimits::isOverSoftMemoryLimit() const
+{
+    size_t limit = m_softMemoryLimit ? m_softMemoryLimit : m_hardMemoryLimit;
+    return limit && m_estimatedLiveBytes >= limit;
+}
+
+bool ContextResourceLimits::didCheckMemoryLimits(bool didCollect)
+{
+    ASSERT(m_needsMemoryLimitCheck);
+    m_needsMemoryLimitCheck = false;
+    if (didCollect && m_softMemoryLimit)
+        m_softMemoryLimitCollectionCount++;
+    updateNextMemoryLimitCheck();
+    return m_hardMemoryLimit && m_estimatedLiveBytes >= m_hardMemoryLimit;
+}
+
+void ContextResourceLimits::requestMemoryLimitCheck()
+{
+    if (m_needsMemoryLimitCheck)
+        return;
+    m_needsMemoryLimitCheck = true;
+    m_nextMemoryLimitCheck = std::numeric_limits<size_t>::max();
+    m_vm.notifyNeedMemoryLimitCheck();
+}
+
+void ContextResourceLimits::updateNextMemoryLimitCheck()
+{
+    size_t smallestLimit = m_softMemoryLimit ? m_softMemoryLimit : m_hardMemoryLimit;
+    if (!smallestLimit) {
+        m_nextMemoryLimitCheck = std::numeric_limits<size_t>::max();
+        return;
+    }
+    if (m_estimatedLiveBytes < smallestLimit) {
+        m_nextMemoryLimitCheck = smallestLimit;
+        return;
+    }
+    if (m_hardMemoryLimit && m_estimatedLiveBytes < m_hardMemoryLimit) {
+        m_nextMemoryLimitCheck = m_hardMemoryLimit;
+        return;
+    }
+    m_nextMemoryLimitCheck = m_estimatedLiveBytes + std::max<size_t>(smallestLimit / memoryLimitCheckSlackDivisor, 1);
+}
+
+} // namespace JSC
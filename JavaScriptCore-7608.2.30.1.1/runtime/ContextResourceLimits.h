@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include <wtf/Seconds.h>
+
+namespace JSC {
+
+class VM;
+
+// Per-JSGlobalObject accounting for heap allocation and CPU time, plus the soft and hard heap
+// limits an embedder placed on the global object. The Heap charges allocation to whichever global
+// object the VM most recently entered through a VMEntryScope, at the granularity at which
+// Heap::didAllocate() hears about it (free list refills, large allocations and extra memory).
+// Since the collector does not know which context owns a surviving cell, the live size is an
+// estimate: every full collection scales it by the survival rate of the whole heap.
+class ContextResourceLimits {
+    WTF_MAKE_NONCOPYABLE(ContextResourceLimits);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    ContextResourceLimits(VM&);
+    ~ContextResourceLimits();
+
+    // A limit of zero means no limit. Crossing the soft limit triggers a full collection; still
+    // being above the hard limit after that collection terminates the running script.
+    void setMemoryLimits(size_t softLimit, size_t hardLimit);
+    size_t softMemoryLimit() const { return m_softMemoryLimit; }
+    size_t hardMemoryLimit() const { return m_hardMemoryLimit; }
+
+    void didAllocate(size_t bytes)
+    {
+        m_totalAllocatedBytes += bytes;
+        m_estimatedLiveBytes += bytes;
+        if (UNLIKELY(m_estimatedLiveBytes >= m_nextMemoryLimitCheck))
+            requestMemoryLimitCheck();
+    }
+
+    void didFinishFullCollection(double survivalRate);
+    void didUseCPUTime(Seconds time) { m_cpuTime += time; }
+
+    bool needsMemoryLimitCheck() const { return m_needsMemoryLimitCheck; }
+    bool isOverSoftMemoryLimit() const;
+    // Returns true if the context is above its hard limit and should be terminated.
+    bool didCheckMemoryLimits(bool didCollect);
+    void didTerminateForMemoryLimit() { m_hardMemoryLimitTerminationCount++; }
+
+    size_t totalAllocatedBytes() const { return m_totalAllocatedBytes; }
+    size_t estimatedLiveBytes() const { return m_estimatedLiveBytes; }
+    Seconds cpuTime() const { return m_cpuTime; }
+    unsigned softMemoryLimitCollectionCount() const { return m_softMemoryLimitCollectionCount; }
+    unsigned hardMemoryLimitTerminationCount() const { return m_hardMemoryLimitTerminationCount; }
+
+private:
+    void requestMemoryLimitCheck();
+    void updateNextMemoryLimitCheck();
+
+    VM& m_vm;
+    size_t m_softMemoryLimit { 0 };
+    size_t m_hardMemoryLimit { 0 };
+    size_t m_nextMemoryLimitCheck { std::numeric_limits<size_t>::max() };
+    size_t m_totalAllocatedBytes { 0 };
+    size_t m_estimatedLiveBytes { 0 };
+    Seconds m_cpuTime;
+    unsigned m_softMemoryLimitCollectionCount { 0 };
+    unsigned m_hardMemoryLimitTerminationCount { 0 };
+    bool m_needsMemoryLimitCheck { false };
+};
+
+} // namespace JSC
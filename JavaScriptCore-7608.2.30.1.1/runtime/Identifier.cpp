@@ -42,6 +42,11 @@ Ref<StringImpl> Identifier::add(VM* vm, const char* c)
     if (!c[1])
         return vm->smallStrings.singleCharacterStringRep(c[0]);
 
+    if (UNLIKELY(Options::useSharedAtomStringTable())) {
+        if (auto atom = SharedAtomStringTable::singleton().add(reinterpret_cast<const LChar*>(c), strlen(c)))
+            return atom.releaseNonNull();
+    }
+
     return *AtomStringImpl::add(c);
 }
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include "PrivateName.h"
+#include "SharedAtomStringTable.h"
 #include "VM.h"
 #include <wtf/Optional.h>
 #include <wtf/text/CString.h>
@@ -225,6 +226,11 @@ Ref<StringImpl> Identifier::add(VM* vm, const T* s, int length)
     if (!length)
         return *StringImpl::empty();
 
+    if (UNLIKELY(Options::useSharedAtomStringTable())) {
+        if (auto atom = SharedAtomStringTable::singleton().add(s, length))
+            return atom.releaseNonNull();
+    }
+
     return *AtomStringImpl::add(s, length);
 }
 
@@ -621,6 +621,32 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
     intlStringOption(exec, options, vm.propertyNames->formatMatcher, { "basic", "best fit" }, "formatMatcher must be either \"basic\" or \"best fit\"", "best fit");
     RETURN_IF_EXCEPTION(scope, void());
 
+    String skeleton = skeletonBuilder.toString();
+
+    // Formatters with the same locale, time zone, skeleton and hour cycle are identical, so reuse
+    // one from an earlier DateTimeFormat and skip the pattern generator entirely.
+    StringBuilder cacheKeyBuilder;
+    cacheKeyBuilder.append(m_locale);
+    cacheKeyBuilder.append('|');
+    cacheKeyBuilder.append(dataLocale);
+    cacheKeyBuilder.append('|');
+    cacheKeyBuilder.append(m_timeZone);
+    cacheKeyBuilder.append('|');
+    cacheKeyBuilder.append(skeleton);
+    cacheKeyBuilder.append('|');
+    cacheKeyBuilder.append(m_hourCycle);
+    String cacheKey = cacheKeyBuilder.toString();
+
+    IntlFormatterCache& formatterCache = vm.intlFormatterCache();
+    if (auto dateFormat = formatterCache.dateFormat(cacheKey)) {
+        if (!dateFormat->patternHasHour())
+            m_hourCycle = String();
+        setFormatsFromPattern(dateFormat->pattern());
+        m_dateFormat = WTFMove(dateFormat);
+        m_initializedDateTimeFormat = true;
+        return;
+    }
+
     // Always use ICU date format generator, rather than our own pattern list and matcher.
     UErrorCode status = U_ZERO_ERROR;
     UDateTimePatternGenerator* generator = udatpg_open(dataLocale.utf8().data(), &status);
@@ -629,7 +655,6 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
         return;
     }
 
-    String skeleton = skeletonBuilder.toString();
     StringView skeletonView(skeleton);
     Vector<UChar, 32> patternBuffer(32);
     status = U_ZERO_ERROR;
@@ -646,6 +671,7 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
     }
 
     // Enforce our hourCycle, replacing hour characters in pattern.
+    bool patternHasHour = true;
     if (!m_hourCycle.isNull()) {
         UChar hour = 'H';
         if (m_hourCycle == "h11")
@@ -666,8 +692,10 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
                 hasHour = true;
             }
         }
-        if (!hasHour)
+        if (!hasHour) {
             m_hourCycle = String();
+            patternHasHour = false;
+        }
     }
 
     StringView pattern(patternBuffer.data(), patternLength);
@@ -675,7 +703,7 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
 
     status = U_ZERO_ERROR;
     StringView timeZoneView(m_timeZone);
-    m_dateFormat = std::unique_ptr<UDateFormat, UDateFormatDeleter>(udat_open(UDAT_PATTERN, UDAT_PATTERN, m_locale.utf8().data(), timeZoneView.upconvertedCharacters(), timeZoneView.length(), pattern.upconvertedCharacters(), pattern.length(), &status));
+    auto dateFormat = std::unique_ptr<UDateFormat, UDateFormatDeleter>(udat_open(UDAT_PATTERN, UDAT_PATTERN, m_locale.utf8().data(), timeZoneView.upconvertedCharacters(), timeZoneView.length(), pattern.upconvertedCharacters(), pattern.length(), &status));
     if (U_FAILURE(status)) {
         throwTypeError(&exec, scope, "failed to initialize DateTimeFormat"_s);
         return;
@@ -683,9 +711,13 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
 
     // Gregorian calendar should be used from the beginning of ECMAScript time.
     // Failure here means unsupported calendar, and can safely be ignored.
-    UCalendar* cal = const_cast<UCalendar*>(udat_getCalendar(m_dateFormat.get()));
+    UCalendar* cal = const_cast<UCalendar*>(udat_getCalendar(dateFormat.get()));
     ucal_setGregorianChange(cal, minECMAScriptTime, &status);
 
+    auto sharedDateFormat = IntlSharedDateFormat::create(dateFormat.release(), pattern.toString(), patternHasHour);
+    m_dateFormat = sharedDateFormat.copyRef();
+    formatterCache.addDateFormat(cacheKey, WTFMove(sharedDateFormat));
+
     m_initializedDateTimeFormat = true;
 }
 
@@ -906,11 +938,11 @@ JSValue IntlDateTimeFormat::format(ExecState& exec, double value)
     // Delegate remaining steps to ICU.
     UErrorCode status = U_ZERO_ERROR;
     Vector<UChar, 32> result(32);
-    auto resultLength = udat_format(m_dateFormat.get(), value, result.data(), result.size(), nullptr, &status);
+    auto resultLength = udat_format(m_dateFormat->get(), value, result.data(), result.size(), nullptr, &status);
     if (status == U_BUFFER_OVERFLOW_ERROR) {
         status = U_ZERO_ERROR;
         result.grow(resultLength);
-        udat_format(m_dateFormat.get(), value, result.data(), resultLength, nullptr, &status);
+        udat_format(m_dateFormat->get(), value, result.data(), resultLength, nullptr, &status);
     }
     if (U_FAILURE(status))
         return throwTypeError(&exec, scope, "failed to format date value"_s);
@@ -1003,11 +1035,11 @@ JSValue IntlDateTimeFormat::formatToParts(ExecState& exec, double value)
 
     status = U_ZERO_ERROR;
     Vector<UChar, 32> result(32);
-    auto resultLength = udat_formatForFields(m_dateFormat.get(), value, result.data(), result.size(), fields.get(), &status);
+    auto resultLength = udat_formatForFields(m_dateFormat->get(), value, result.data(), result.size(), fields.get(), &status);
     if (status == U_BUFFER_OVERFLOW_ERROR) {
         status = U_ZERO_ERROR;
         result.grow(resultLength);
-        udat_formatForFields(m_dateFormat.get(), value, result.data(), resultLength, fields.get(), &status);
+        udat_formatForFields(m_dateFormat->get(), value, result.data(), resultLength, fields.get(), &status);
     }
     if (U_FAILURE(status))
         return throwTypeError(&exec, scope, "failed to format date value"_s);
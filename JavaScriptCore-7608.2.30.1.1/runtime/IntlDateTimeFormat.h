@@ -27,6 +27,7 @@
 
 #if ENABLE(INTL)
 
+#include "IntlFormatterCache.h"
 #include "JSDestructibleObject.h"
 #include <unicode/udat.h>
 #include <unicode/uvernum.h>
@@ -90,7 +91,7 @@ private:
     static ASCIILiteral timeZoneNameString(TimeZoneName);
 
     WriteBarrier<JSBoundFunction> m_boundFormat;
-    std::unique_ptr<UDateFormat, UDateFormatDeleter> m_dateFormat;
+    RefPtr<IntlSharedDateFormat> m_dateFormat;
 
     String m_locale;
     String m_calendar;
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "IntlFormatterCache.h"
+
+#if ENABLE(INTL)
+
+#include "Options.h"
+
+namespace JSC {
+
+template<typename Format>
+RefPtr<Format> IntlFormatterCache::LRUList<Format>::get(const String& key)
+{
+    for (size_t i = m_entries.size(); i--;) {
+        if (m_entries[i].first != key)
+            continue;
+        m_hitCount++;
+        RefPtr<Format> result = m_entries[i].second.ptr();
+        if (i != m_entries.size() - 1) {
+            auto entry = WTFMove(m_entries[i]);
+            m_entries.remove(i);
+            m_entries.append(WTFMove(entry));
+        }
+        return result;
+    }
+    m_missCount++;
+    return nullptr;
+}
+
+template<typename Format>
+void IntlFormatterCache::LRUList<Format>::add(const String& key, Ref<Format>&& format)
+{
+    unsigned capacity = Options::intlFormatterCacheSize();
+    if (!capacity)
+        return;
+    if (m_entries.size() >= capacity)
+        m_entries.remove(0, m_entries.size() - capacity + 1);
+    m_entries.append({ key, WTFMove(format) });
+}
+
+template class IntlFormatterCache::LRUList<IntlSharedNumberFormat>;
+template class IntlFormatterCache::LRUList<IntlSharedDateFormat>;
+
+void IntlFormatterCache::clear()
+{
+    m_numberFormats.clear();
+    m_dateFormats.clear();
+}
+
+} // namespace JSC
+
+#endif // ENABLE(INTL)
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#if ENABLE(INTL)
+
+#include <unicode/udat.h>
+#include <unicode/unum.h>
+#include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+// An ICU number formatter that several IntlNumberFormat instances may share. The formatter is
+// fully configured before it is shared, and formatting does not mutate it.
+class IntlSharedNumberFormat : public RefCounted<IntlSharedNumberFormat> {
+public:
+    static Ref<IntlSharedNumberFormat> create(UNumberFormat* numberFormat)
+    {
+        return adoptRef(*new IntlSharedNumberFormat(numberFormat));
+    }
+
+    ~IntlSharedNumberFormat()
+    {
+        unum_close(m_numberFormat);
+    }
+
+    UNumberFormat* get() const { return m_numberFormat; }
+
+private:
+    explicit IntlSharedNumberFormat(UNumberFormat* numberFormat)
+        : m_numberFormat(numberFormat)
+    {
+    }
+
+    UNumberFormat* m_numberFormat;
+};
+
+// An ICU date formatter together with the pattern it was opened with, which IntlDateTimeFormat
+// needs to recover its resolved options without running the pattern generator again.
+class IntlSharedDateFormat : public RefCounted<IntlSharedDateFormat> {
+public:
+    static Ref<IntlSharedDateFormat> create(UDateFormat* dateFormat, const String& pattern, bool patternHasHour)
+    {
+        return adoptRef(*new IntlSharedDateFormat(dateFormat, pattern, patternHasHour));
+    }
+
+    ~IntlSharedDateFormat()
+    {
+        udat_close(m_dateFormat);
+    }
+
+    UDateFormat* get() const { return m_dateFormat; }
+    const String& pattern() const { return m_pattern; }
+    bool patternHasHour() const { return m_patternHasHour; }
+
+private:
+    IntlSharedDateFormat(UDateFormat* dateFormat, const String& pattern, bool patternHasHour)
+        : m_dateFormat(dateFormat)
+        , m_pattern(pattern)
+        , m_patternHasHour(patternHasHour)
+    {
+    }
+
+    UDateFormat* m_dateFormat;
+    String m_pattern;
+    bool m_patternHasHour;
+};
+
+// Per-VM cache of ICU formatters, keyed by the options they were resolved from. Opening an ICU
+// formatter loads locale data and, for dates, runs the pattern generator, which dominates the
+// cost of Number.prototype.toLocaleString and Date.prototype.toLocale*String. Each kind of
+// formatter is kept in a small least-recently-used list of Options::intlFormatterCacheSize entries.
+class IntlFormatterCache {
+    WTF_MAKE_NONCOPYABLE(IntlFormatterCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    IntlFormatterCache() = default;
+
+    RefPtr<IntlSharedNumberFormat> numberFormat(const String& key) { return m_numberFormats.get(key); }
+    void addNumberFormat(const String& key, Ref<IntlSharedNumberFormat>&& format) { m_numberFormats.add(key, WTFMove(format)); }
+
+    RefPtr<IntlSharedDateFormat> dateFormat(const String& key) { return m_dateFormats.get(key); }
+    void addDateFormat(const String& key, Ref<IntlSharedDateFormat>&& format) { m_dateFormats.add(key, WTFMove(format)); }
+
+    void clear();
+
+    unsigned hitCount() const { return m_numberFormats.hitCount() + m_dateFormats.hitCount(); }
+    unsigned missCount() const { return m_numberFormats.missCount() + m_dateFormats.missCount(); }
+
+private:
+    template<typename Format>
+    class LRUList {
+    public:
+        RefPtr<Format> get(const String& key);
+        void add(const String& key, Ref<Format>&&);
+        void clear() { m_entries.clear(); }
+
+        unsigned hitCount() const { return m_hitCount; }
+        unsigned missCount() const { return m_missCount; }
+
+    private:
+        // Ordered from least to most recently used. The lists are short, so a linear scan beats hashing the key.
+        Vector<std::pair<String, Ref<Format>>> m_entries;
+        unsigned m_hitCount { 0 };
+        unsigned m_missCount { 0 };
+    };
+
+    LRUList<IntlSharedNumberFormat> m_numberFormats;
+    LRUList<IntlSharedDateFormat> m_dateFormats;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(INTL)
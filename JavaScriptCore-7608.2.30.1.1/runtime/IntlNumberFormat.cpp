@@ -37,6 +37,8 @@
 #include "JSBoundFunction.h"
 #include "JSCInlines.h"
 #include "ObjectConstructor.h"
+#include <wtf/dtoa.h>
+#include <wtf/text/StringBuilder.h>
 
 #if HAVE(ICU_FORMAT_DOUBLE_FOR_FIELDS)
 #include <unicode/ufieldpositer.h>
@@ -283,6 +285,15 @@ void IntlNumberFormat::initializeNumberFormat(ExecState& state, JSValue locales,
         useGrouping = true;
     RETURN_IF_EXCEPTION(scope, void());
     m_useGrouping = useGrouping;
+    m_useASCIIFastPath = canUseASCIIFastPath();
+
+    IntlFormatterCache& formatterCache = vm.intlFormatterCache();
+    String cacheKey = formatterCacheKey();
+    if (auto numberFormat = formatterCache.numberFormat(cacheKey)) {
+        m_numberFormat = WTFMove(numberFormat);
+        m_initializedNumberFormat = true;
+        return;
+    }
 
     UNumberFormatStyle style = UNUM_DEFAULT;
     switch (m_style) {
@@ -312,34 +323,123 @@ void IntlNumberFormat::initializeNumberFormat(ExecState& state, JSValue locales,
     }
 
     UErrorCode status = U_ZERO_ERROR;
-    m_numberFormat = std::unique_ptr<UNumberFormat, UNumberFormatDeleter>(unum_open(style, nullptr, 0, m_locale.utf8().data(), nullptr, &status));
+    auto numberFormat = std::unique_ptr<UNumberFormat, UNumberFormatDeleter>(unum_open(style, nullptr, 0, m_locale.utf8().data(), nullptr, &status));
     if (U_FAILURE(status)) {
         throwTypeError(&state, scope, "failed to initialize NumberFormat"_s);
         return;
     }
 
     if (m_style == Style::Currency) {
-        unum_setTextAttribute(m_numberFormat.get(), UNUM_CURRENCY_CODE, StringView(m_currency).upconvertedCharacters(), m_currency.length(), &status);
+        unum_setTextAttribute(numberFormat.get(), UNUM_CURRENCY_CODE, StringView(m_currency).upconvertedCharacters(), m_currency.length(), &status);
         if (U_FAILURE(status)) {
             throwTypeError(&state, scope, "failed to initialize NumberFormat"_s);
             return;
         }
     }
     if (!m_minimumSignificantDigits) {
-        unum_setAttribute(m_numberFormat.get(), UNUM_MIN_INTEGER_DIGITS, m_minimumIntegerDigits);
-        unum_setAttribute(m_numberFormat.get(), UNUM_MIN_FRACTION_DIGITS, m_minimumFractionDigits);
-        unum_setAttribute(m_numberFormat.get(), UNUM_MAX_FRACTION_DIGITS, m_maximumFractionDigits);
+        unum_setAttribute(numberFormat.get(), UNUM_MIN_INTEGER_DIGITS, m_minimumIntegerDigits);
+        unum_setAttribute(numberFormat.get(), UNUM_MIN_FRACTION_DIGITS, m_minimumFractionDigits);
+        unum_setAttribute(numberFormat.get(), UNUM_MAX_FRACTION_DIGITS, m_maximumFractionDigits);
     } else {
-        unum_setAttribute(m_numberFormat.get(), UNUM_SIGNIFICANT_DIGITS_USED, true);
-        unum_setAttribute(m_numberFormat.get(), UNUM_MIN_SIGNIFICANT_DIGITS, m_minimumSignificantDigits);
-        unum_setAttribute(m_numberFormat.get(), UNUM_MAX_SIGNIFICANT_DIGITS, m_maximumSignificantDigits);
+        unum_setAttribute(numberFormat.get(), UNUM_SIGNIFICANT_DIGITS_USED, true);
+        unum_setAttribute(numberFormat.get(), UNUM_MIN_SIGNIFICANT_DIGITS, m_minimumSignificantDigits);
+        unum_setAttribute(numberFormat.get(), UNUM_MAX_SIGNIFICANT_DIGITS, m_maximumSignificantDigits);
     }
-    unum_setAttribute(m_numberFormat.get(), UNUM_GROUPING_USED, m_useGrouping);
-    unum_setAttribute(m_numberFormat.get(), UNUM_ROUNDING_MODE, UNUM_ROUND_HALFUP);
+    unum_setAttribute(numberFormat.get(), UNUM_GROUPING_USED, m_useGrouping);
+    unum_setAttribute(numberFormat.get(), UNUM_ROUNDING_MODE, UNUM_ROUND_HALFUP);
+
+    auto sharedNumberFormat = IntlSharedNumberFormat::create(numberFormat.release());
+    m_numberFormat = sharedNumberFormat.copyRef();
+    formatterCache.addNumberFormat(cacheKey, WTFMove(sharedNumberFormat));
 
     m_initializedNumberFormat = true;
 }
 
+String IntlNumberFormat::formatterCacheKey() const
+{
+    // Everything that initializeNumberFormat() passes to ICU.
+    StringBuilder key;
+    key.append(m_locale);
+    key.append('|');
+    key.append(styleString(m_style));
+    if (m_style == Style::Currency) {
+        key.append('|');
+        key.append(m_currency);
+        key.append('|');
+        key.append(currencyDisplayString(m_currencyDisplay));
+    }
+    for (unsigned digits : { m_minimumIntegerDigits, m_minimumFractionDigits, m_maximumFractionDigits, m_minimumSignificantDigits, m_maximumSignificantDigits }) {
+        key.append('|');
+        key.appendNumber(digits);
+    }
+    key.append(m_useGrouping ? "|g" : "|");
+    return key.toString();
+}
+
+bool IntlNumberFormat::canUseASCIIFastPath() const
+{
+    // These locales format decimals in Latin digits with "-", "," and "." and group every three
+    // integer digits, so their output can be produced without ICU when no rounding is needed.
+    if (m_style != Style::Decimal || m_minimumSignificantDigits || m_numberingSystem != "latn")
+        return false;
+    for (const char* locale : { "en", "en-US", "en-GB", "en-AU", "en-CA" }) {
+        if (m_locale == locale)
+            return true;
+    }
+    return false;
+}
+
+String IntlNumberFormat::formatNumberWithASCIIFastPath(double number) const
+{
+    ASSERT(m_useASCIIFastPath);
+
+    // ICU formats the shortest decimal representation of a double, so when that representation
+    // already fits in maximumFractionDigits, ICU would not round and the digits can be copied.
+    // Anything else, including exponents and non-finite values, returns null and goes to ICU.
+    if (!std::isfinite(number))
+        return String();
+
+    NumberToStringBuffer buffer;
+    const char* digits = WTF::numberToString(number, buffer);
+    bool isNegative = *digits == '-';
+    if (isNegative)
+        ++digits;
+
+    size_t integerLength = 0;
+    while (isASCIIDigit(digits[integerLength]))
+        ++integerLength;
+    const char* fraction = digits + integerLength;
+    size_t fractionLength = 0;
+    if (*fraction == '.') {
+        ++fraction;
+        while (isASCIIDigit(fraction[fractionLength]))
+            ++fractionLength;
+    }
+    if (fraction[fractionLength] || fractionLength > m_maximumFractionDigits)
+        return String();
+
+    StringBuilder result;
+    if (isNegative)
+        result.append('-');
+
+    size_t paddedIntegerLength = std::max<size_t>(integerLength, m_minimumIntegerDigits);
+    size_t leadingZeros = paddedIntegerLength - integerLength;
+    for (size_t i = 0; i < paddedIntegerLength; ++i) {
+        if (m_useGrouping && i && !((paddedIntegerLength - i) % 3))
+            result.append(',');
+        result.append(i < leadingZeros ? '0' : digits[i - leadingZeros]);
+    }
+
+    size_t paddedFractionLength = std::max<size_t>(fractionLength, m_minimumFractionDigits);
+    if (paddedFractionLength) {
+        result.append('.');
+        result.append(fraction, fractionLength);
+        for (size_t i = fractionLength; i < paddedFractionLength; ++i)
+            result.append('0');
+    }
+    return result.toString();
+}
+
 JSValue IntlNumberFormat::formatNumber(ExecState& state, double number)
 {
     VM& vm = state.vm();
@@ -353,13 +453,19 @@ JSValue IntlNumberFormat::formatNumber(ExecState& state, double number)
     if (!number)
         number = 0.0;
 
+    if (m_useASCIIFastPath) {
+        String result = formatNumberWithASCIIFastPath(number);
+        if (!result.isNull())
+            return jsString(&state, result);
+    }
+
     UErrorCode status = U_ZERO_ERROR;
     Vector<UChar, 32> buffer(32);
-    auto length = unum_formatDouble(m_numberFormat.get(), number, buffer.data(), buffer.size(), nullptr, &status);
+    auto length = unum_formatDouble(m_numberFormat->get(), number, buffer.data(), buffer.size(), nullptr, &status);
     if (status == U_BUFFER_OVERFLOW_ERROR) {
         buffer.grow(length);
         status = U_ZERO_ERROR;
-        unum_formatDouble(m_numberFormat.get(), number, buffer.data(), length, nullptr, &status);
+        unum_formatDouble(m_numberFormat->get(), number, buffer.data(), length, nullptr, &status);
     }
     if (U_FAILURE(status))
         return throwException(&state, scope, createError(&state, "Failed to format a number."_s));
@@ -502,11 +608,11 @@ JSValue IntlNumberFormat::formatToParts(ExecState& exec, double value)
 
     status = U_ZERO_ERROR;
     Vector<UChar, 32> result(32);
-    auto resultLength = unum_formatDoubleForFields(m_numberFormat.get(), value, result.data(), result.size(), fieldItr.get(), &status);
+    auto resultLength = unum_formatDoubleForFields(m_numberFormat->get(), value, result.data(), result.size(), fieldItr.get(), &status);
     if (status == U_BUFFER_OVERFLOW_ERROR) {
         status = U_ZERO_ERROR;
         result.grow(resultLength);
-        unum_formatDoubleForFields(m_numberFormat.get(), value, result.data(), resultLength, fieldItr.get(), &status);
+        unum_formatDoubleForFields(m_numberFormat->get(), value, result.data(), resultLength, fieldItr.get(), &status);
     }
     if (U_FAILURE(status))
         return throwTypeError(&exec, scope, "failed to format a number."_s);
@@ -27,6 +27,7 @@
 
 #if ENABLE(INTL)
 
+#include "IntlFormatterCache.h"
 #include "JSDestructibleObject.h"
 #include <unicode/unum.h>
 #include <unicode/uvernum.h>
@@ -74,10 +75,14 @@ private:
     static ASCIILiteral styleString(Style);
     static ASCIILiteral currencyDisplayString(CurrencyDisplay);
 
+    String formatterCacheKey() const;
+    bool canUseASCIIFastPath() const;
+    String formatNumberWithASCIIFastPath(double) const;
+
     String m_locale;
     String m_numberingSystem;
     String m_currency;
-    std::unique_ptr<UNumberFormat, UNumberFormatDeleter> m_numberFormat;
+    RefPtr<IntlSharedNumberFormat> m_numberFormat;
     WriteBarrier<JSBoundFunction> m_boundFormat;
     unsigned m_minimumIntegerDigits { 1 };
     unsigned m_minimumFractionDigits { 0 };
@@ -87,6 +92,7 @@ private:
     Style m_style { Style::Decimal };
     CurrencyDisplay m_currencyDisplay;
     bool m_useGrouping { true };
+    bool m_useASCIIFastPath { false };
     bool m_initializedNumberFormat { false };
 
 #if HAVE(ICU_FORMAT_DOUBLE_FOR_FIELDS)
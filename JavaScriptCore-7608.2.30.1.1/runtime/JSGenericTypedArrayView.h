@@ -28,6 +28,7 @@
 #include "JSArrayBufferView.h"
 #include "ThrowScope.h"
 #include "ToNativeFromValue.h"
+#include "TypedArrayBulkOperations.h"
 
 namespace JSC {
 
@@ -201,12 +202,10 @@ public:
         case TypeFloat64:
             sortFloat<int64_t>();
             break;
-        default: {
-            ElementType* array = typedVector();
-            std::sort(array, array + m_length);
+        default:
+            sortIntegers(std::is_integral<ElementType>());
             break;
         }
-        }
     }
 
     bool canAccessRangeQuickly(unsigned offset, unsigned length)
@@ -295,6 +294,10 @@ private:
         ExecState*, unsigned offset, JSGenericTypedArrayView<OtherAdaptor>*,
         unsigned objectOffset, unsigned length, CopyType);
 
+    // The switch in sort() is on a runtime value, so this is instantiated for float views too.
+    void sortIntegers(std::true_type) { typedArraySortIntegers(typedVector(), m_length); }
+    void sortIntegers(std::false_type) { RELEASE_ASSERT_NOT_REACHED(); }
+
     // The ECMA 6 spec states that floating point Typed Arrays should have the following ordering:
     //
     // -Inifinity < negative finite numbers < -0.0 < 0.0 < positive finite numbers < Infinity < NaN
@@ -339,13 +342,7 @@ private:
         // We could use a union but ASAN seems to frown upon that.
         purifyArray();
 
-        IntegralType* array = reinterpret_cast_ptr<IntegralType*>(typedVector());
-        std::sort(array, array + m_length, [] (IntegralType a, IntegralType b) {
-            if (a >= 0 || b >= 0)
-                return a < b;
-            return a > b;
-        });
-
+        typedArraySortFloatBits(reinterpret_cast_ptr<IntegralType*>(typedVector()), m_length);
     }
 
 };
@@ -35,6 +35,7 @@
 #include "JSStringJoiner.h"
 #include "StructureInlines.h"
 #include "TypedArrayAdaptors.h"
+#include "TypedArrayBulkOperations.h"
 #include "TypedArrayController.h"
 #include <wtf/StdLibExtras.h>
 
@@ -180,6 +181,34 @@ EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncCopyWithin(VM& vm, Ex
     return JSValue::encode(exec->thisValue());
 }
 
+template<typename ViewClass>
+EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncFill(VM& vm, ExecState* exec)
+{
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    // 22.2.3.8
+    ViewClass* thisObject = jsCast<ViewClass*>(exec->thisValue());
+    if (thisObject->isNeutered())
+        return throwVMTypeError(exec, scope, typedArrayBufferHasBeenDetachedErrorMessage);
+
+    unsigned length = thisObject->length();
+
+    typename ViewClass::ElementType value = ViewClass::toAdaptorNativeFromValue(exec, exec->argument(0));
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    unsigned start = argumentClampedIndexFromStartOrEnd(exec, 1, length);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    unsigned end = argumentClampedIndexFromStartOrEnd(exec, 2, length, length);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+
+    if (thisObject->isNeutered())
+        return throwVMTypeError(exec, scope, typedArrayBufferHasBeenDetachedErrorMessage);
+
+    if (start < end)
+        typedArrayFill(thisObject->typedVector() + start, value, end - start);
+
+    return JSValue::encode(thisObject);
+}
+
 template<typename ViewClass>
 EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncIncludes(VM& vm, ExecState* exec)
 {
@@ -210,19 +239,10 @@ EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncIncludes(VM& vm, Exec
     scope.assertNoException();
     RELEASE_ASSERT(!thisObject->isNeutered());
 
-    if (std::isnan(static_cast<double>(*targetOption))) {
-        for (; index < length; ++index) {
-            if (std::isnan(static_cast<double>(array[index])))
-                return JSValue::encode(jsBoolean(true));
-        }
-    } else {
-        for (; index < length; ++index) {
-            if (array[index] == targetOption)
-                return JSValue::encode(jsBoolean(true));
-        }
-    }
+    if (std::isnan(static_cast<double>(*targetOption)))
+        return JSValue::encode(jsBoolean(typedArrayFindNaN(array, index, length) != notFound));
 
-    return JSValue::encode(jsBoolean(false));
+    return JSValue::encode(jsBoolean(typedArrayFind(array, *targetOption, index, length) != notFound));
 }
 
 template<typename ViewClass>
@@ -254,12 +274,10 @@ EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncIndexOf(VM& vm, ExecS
     scope.assertNoException();
     RELEASE_ASSERT(!thisObject->isNeutered());
 
-    for (; index < length; ++index) {
-        if (array[index] == targetOption)
-            return JSValue::encode(jsNumber(index));
-    }
-
-    return JSValue::encode(jsNumber(-1));
+    size_t result = typedArrayFind(array, *targetOption, index, length);
+    if (result == notFound)
+        return JSValue::encode(jsNumber(-1));
+    return JSValue::encode(jsNumber(static_cast<unsigned>(result)));
 }
 
 template<typename ViewClass>
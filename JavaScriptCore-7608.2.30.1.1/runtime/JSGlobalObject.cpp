@@ -376,14 +376,19 @@ const GlobalObjectMethodTable JSGlobalObject::s_globalObjectMethodTable = {
 
 static EncodedJSValue JSC_HOST_CALL enqueueJob(ExecState* exec)
 {
-    VM& vm = exec->vm();
     JSGlobalObject* globalObject = exec->lexicalGlobalObject();
 
-    JSValue job = exec->argument(0);
-    JSValue arguments = exec->argument(1);
-    ASSERT(arguments.inherits<JSArray>(vm));
+    // Builtins pass the job's arguments directly, so that scheduling a promise reaction does not
+    // have to allocate an array to carry them.
+    ASSERT(exec->argumentCount() >= 1);
+    JSValue job = exec->uncheckedArgument(0);
+    unsigned argumentCount = exec->argumentCount() - 1;
+    ASSERT(argumentCount <= MicrotaskQueue::maximumArgumentCount);
+    std::array<JSValue, MicrotaskQueue::maximumArgumentCount> arguments;
+    for (unsigned i = 0; i < argumentCount; ++i)
+        arguments[i] = exec->uncheckedArgument(i + 1);
 
-    globalObject->queueMicrotask(createJSMicrotask(vm, job, jsCast<JSArray*>(arguments)));
+    globalObject->queueMicrotask(exec, job, arguments.data(), argumentCount);
 
     return JSValue::encode(jsUndefined());
 }
@@ -1615,6 +1620,15 @@ void JSGlobalObject::haveABadTime(VM& vm)
     }
 }
 
+ContextResourceLimits& JSGlobalObject::ensureResourceLimits(VM& vm)
+{
+    createRareDataIfNeeded();
+    // Accounting starts with the next VMEntryScope that enters this global object.
+    if (!m_rareData->resourceLimits)
+        m_rareData->resourceLimits = std::make_unique<ContextResourceLimits>(vm);
+    return *m_rareData->resourceLimits;
+}
+
 void JSGlobalObject::fixupPrototypeChainWithObjectPrototype(VM& vm)
 {
     JSObject* oldLastInPrototypeChain = lastInPrototypeChain(vm, this);
@@ -2062,6 +2076,18 @@ void JSGlobalObject::queueMicrotask(Ref<Microtask>&& task)
     vm().queueMicrotask(*this, WTFMove(task));
 }
 
+void JSGlobalObject::queueMicrotask(ExecState* exec, JSValue job, const JSValue* arguments, unsigned argumentCount)
+{
+    if (globalObjectMethodTable()->queueTaskToEventLoop) {
+        JSArray* argumentsArray = constructArray(exec, nullptr, this, arguments, argumentCount);
+        RELEASE_ASSERT(argumentsArray);
+        globalObjectMethodTable()->queueTaskToEventLoop(*this, createJSMicrotask(vm(), job, argumentsArray));
+        return;
+    }
+
+    vm().queueMicrotask(*this, job, arguments, argumentCount);
+}
+
 void JSGlobalObject::setDebugger(Debugger* debugger)
 {
     m_debugger = debugger;
@@ -25,6 +25,7 @@
 #include "ArrayBufferSharingMode.h"
 #include "BigIntPrototype.h"
 #include "BooleanPrototype.h"
+#include "ContextResourceLimits.h"
 #include "ErrorType.h"
 #include "ExceptionHelpers.h"
 #include "InternalFunction.h"
@@ -247,6 +248,7 @@ private:
 
         WeakMapSet weakMaps;
         unsigned profileGroup;
+        std::unique_ptr<ContextResourceLimits> resourceLimits;
         
         OpaqueJSClassDataMap opaqueJSClassData;
     };
@@ -928,6 +930,14 @@ public:
         return m_rareData->profileGroup;
     }
 
+    ContextResourceLimits* resourceLimits() const
+    {
+        if (!m_rareData)
+            return nullptr;
+        return m_rareData->resourceLimits.get();
+    }
+    JS_EXPORT_PRIVATE ContextResourceLimits& ensureResourceLimits(VM&);
+
     Debugger* debugger() const { return m_debugger; }
     void setDebugger(Debugger*);
 
@@ -942,6 +952,7 @@ public:
     static RuntimeFlags javaScriptRuntimeFlags(const JSGlobalObject*) { return RuntimeFlags(); }
 
     JS_EXPORT_PRIVATE void queueMicrotask(Ref<Microtask>&&);
+    void queueMicrotask(ExecState*, JSValue job, const JSValue* arguments, unsigned argumentCount);
 
     bool evalEnabled() const { return m_evalEnabled; }
     bool webAssemblyEnabled() const { return m_webAssemblyEnabled; }
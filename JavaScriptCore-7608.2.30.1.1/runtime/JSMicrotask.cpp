@@ -90,4 +90,21 @@ void JSMicrotask::run(ExecState* exec)
     scope.clearException();
 }
 
+void runJSMicrotask(ExecState* exec, JSValue job, const JSValue* arguments, unsigned argumentCount)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    CallData handlerCallData;
+    CallType handlerCallType = getCallData(vm, job, handlerCallData);
+    ASSERT(handlerCallType != CallType::None);
+
+    MarkedArgumentBuffer handlerArguments;
+    for (unsigned index = 0; index < argumentCount; ++index)
+        handlerArguments.append(arguments[index]);
+    ASSERT(!handlerArguments.hasOverflowed());
+    profiledCall(exec, ProfilingReason::Microtask, job, handlerCallType, handlerCallData, jsUndefined(), handlerArguments);
+    scope.clearException();
+}
+
 } // namespace JSC
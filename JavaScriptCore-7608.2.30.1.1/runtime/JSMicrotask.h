@@ -30,10 +30,14 @@
 
 namespace JSC {
 
+class ExecState;
 class Microtask;
 class JSArray;
 
 JS_EXPORT_PRIVATE Ref<Microtask> createJSMicrotask(VM&, JSValue job);
 JS_EXPORT_PRIVATE Ref<Microtask> createJSMicrotask(VM&, JSValue job, JSArray* arguments);
 
+// Runs a job the way a JSMicrotask would, for callers that keep the job and its arguments elsewhere.
+void runJSMicrotask(ExecState*, JSValue job, const JSValue* arguments, unsigned argumentCount);
+
 } // namespace JSC
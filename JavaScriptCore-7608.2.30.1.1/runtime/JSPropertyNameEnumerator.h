@@ -33,6 +33,7 @@
 namespace JSC {
 
 class JSPropertyNameEnumerator final : public JSCell {
+    friend class LLIntOffsetsExtractor;
 public:
     typedef JSCell Base;
     static const unsigned StructureFlags = Base::StructureFlags | StructureIsImmortal;
@@ -31,6 +31,12 @@
 #include "StringPrototype.h"
 #include "StrongInlines.h"
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 namespace JSC {
     
 const ClassInfo JSString::s_info = { "string", nullptr, nullptr, nullptr, CREATE_METHOD_TABLE(JSString) };
@@ -149,6 +155,28 @@ void JSString::visitChildren(JSCell* cell, SlotVisitor& visitor)
 
 static const unsigned maxLengthForOnStackResolve = 2048;
 
+// Same-width fiber copies already go through memcpy. Widening 8-bit fibers into a 16-bit rope is the
+// case the compiler does not vectorize for us, so do it 16 characters at a time.
+static ALWAYS_INLINE void copyCharactersWidening(UChar* destination, const LChar* source, unsigned length)
+{
+    unsigned i = 0;
+#if CPU(X86_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpackhi_epi8(chunk, zero));
+    }
+#elif HAVE(ARM_NEON_INTRINSICS)
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t chunk = vld1q_u8(source + i);
+        vst1q_u16(reinterpret_cast<uint16_t*>(destination + i), vmovl_u8(vget_low_u8(chunk)));
+        vst1q_u16(reinterpret_cast<uint16_t*>(destination + i + 8), vmovl_u8(vget_high_u8(chunk)));
+    }
+#endif
+    StringImpl::copyCharacters(destination + i, source + i, length - i);
+}
+
 void JSRopeString::resolveRopeInternal8(LChar* buffer) const
 {
     if (isSubstring()) {
@@ -203,7 +231,7 @@ void JSRopeString::resolveRopeInternal16NoSubstring(UChar* buffer) const
         const StringImpl& fiberString = *fiber(i)->valueInternal().impl();
         unsigned length = fiberString.length();
         if (fiberString.is8Bit())
-            StringImpl::copyCharacters(position, fiberString.characters8(), length);
+            copyCharactersWidening(position, fiberString.characters8(), length);
         else
             StringImpl::copyCharacters(position, fiberString.characters16(), length);
         position += length;
@@ -402,7 +430,7 @@ void JSRopeString::resolveRopeSlowCase(UChar* buffer) const
                 unsigned length = currentFiberAsRope->length();
                 position -= length;
                 if (string->is8Bit())
-                    StringImpl::copyCharacters(position, string->characters8() + offset, length);
+                    copyCharactersWidening(position, string->characters8() + offset, length);
                 else
                     StringImpl::copyCharacters(position, string->characters16() + offset, length);
                 continue;
@@ -416,7 +444,7 @@ void JSRopeString::resolveRopeSlowCase(UChar* buffer) const
         unsigned length = string->length();
         position -= length;
         if (string->is8Bit())
-            StringImpl::copyCharacters(position, string->characters8(), length);
+            copyCharactersWidening(position, string->characters8(), length);
         else
             StringImpl::copyCharacters(position, string->characters16(), length);
     }
@@ -424,6 +452,155 @@ void JSRopeString::resolveRopeSlowCase(UChar* buffer) const
     ASSERT(buffer == position);
 }
 
+template<typename Functor>
+bool JSRopeString::forEachFiberSegment(unsigned start, const Functor& functor) const
+{
+    ASSERT(isRope());
+    ASSERT(!isSubstring());
+
+    struct Item {
+        JSString* fiber;
+        unsigned offset;
+        unsigned depth;
+    };
+
+    // These strings are kept alive by the parent rope, and there are no GC points in this method.
+    Vector<Item, 32, UnsafeVectorOverflow> workQueue;
+    auto appendFibers = [&] (const JSRopeString* rope, unsigned offset, unsigned depth) {
+        unsigned offsets[s_maxInternalRopeLength];
+        for (size_t i = 0; i < s_maxInternalRopeLength; ++i) {
+            offsets[i] = offset;
+            if (JSString* fiber = rope->fiber(i))
+                offset += fiber->length();
+        }
+        // Whole subtrees that end before start are skipped by length.
+        for (size_t i = s_maxInternalRopeLength; i--;) {
+            JSString* fiber = rope->fiber(i);
+            if (fiber && offsets[i] + fiber->length() > start)
+                workQueue.append(Item { fiber, offsets[i], depth });
+        }
+    };
+    appendFibers(this, 0, 1);
+
+    unsigned segmentCount = 0;
+    while (!workQueue.isEmpty()) {
+        Item item = workQueue.takeLast();
+        JSString* currentFiber = item.fiber;
+
+        StringView segment;
+        if (currentFiber->isRope()) {
+            JSRopeString* currentFiberAsRope = static_cast<JSRopeString*>(currentFiber);
+            if (!currentFiberAsRope->isSubstring()) {
+                if (item.depth >= maxDepthToAccessWithoutResolving)
+                    return false;
+                appendFibers(currentFiberAsRope, item.offset, item.depth + 1);
+                continue;
+            }
+            ASSERT(!currentFiberAsRope->substringBase()->isRope());
+            segment = StringView(currentFiberAsRope->substringBase()->valueInternal()).substring(currentFiberAsRope->substringOffset(), currentFiberAsRope->length());
+        } else
+            segment = StringView(currentFiber->valueInternal());
+
+        if (++segmentCount > maxFibersToAccessWithoutResolving)
+            return false;
+        if (functor(segment, item.offset) == IterationStatus::Done)
+            return true;
+    }
+    return true;
+}
+
+Optional<UChar> JSRopeString::characterAtWithoutResolving(unsigned index) const
+{
+    ASSERT(index < length());
+
+    const JSString* current = this;
+    for (unsigned depth = 0; depth < maxDepthToAccessWithoutResolving; ++depth) {
+        if (!current->isRope())
+            return current->valueInternal()[index];
+
+        const JSRopeString* currentAsRope = static_cast<const JSRopeString*>(current);
+        if (currentAsRope->isSubstring())
+            return currentAsRope->substringBase()->valueInternal()[currentAsRope->substringOffset() + index];
+
+        for (size_t i = 0; i < s_maxInternalRopeLength; ++i) {
+            JSString* fiber = currentAsRope->fiber(i);
+            ASSERT(fiber);
+            unsigned fiberLength = fiber->length();
+            if (index < fiberLength) {
+                current = fiber;
+                break;
+            }
+            index -= fiberLength;
+        }
+    }
+
+    // Deep ropes are usually built by repeated appends. Walking them on every access would be
+    // quadratic for a loop over the string, so let the caller resolve instead.
+    return WTF::nullopt;
+}
+
+Optional<size_t> JSRopeString::findWithoutResolving(StringView pattern, unsigned start) const
+{
+    ASSERT(start <= length());
+
+    unsigned patternLength = pattern.length();
+    if (!patternLength)
+        return static_cast<size_t>(start);
+
+    // Matches that straddle fibers are found in a small buffer holding the characters around each
+    // fiber boundary. Every match starting before boundaryStart has already been ruled out.
+    unsigned overlap = patternLength - 1;
+    Vector<UChar, 64> boundary;
+    unsigned boundaryStart = 0;
+    size_t result = notFound;
+
+    bool searched = forEachFiberSegment(start, [&] (StringView segment, unsigned offset) -> IterationStatus {
+        unsigned segmentLength = segment.length();
+        if (!boundary.isEmpty()) {
+            unsigned prefixLength = std::min(overlap, segmentLength);
+            for (unsigned i = 0; i < prefixLength; ++i)
+                boundary.append(segment[i]);
+
+            unsigned from = start > boundaryStart ? start - boundaryStart : 0;
+            size_t match = StringView(boundary.data(), boundary.size()).find(pattern, from);
+            if (match != notFound) {
+                result = boundaryStart + match;
+                return IterationStatus::Done;
+            }
+
+            if (segmentLength < overlap) {
+                // The whole segment fit in the boundary buffer. Keep the tail that may still start a match.
+                if (boundary.size() > overlap) {
+                    unsigned dropped = boundary.size() - overlap;
+                    boundary.remove(0, dropped);
+                    boundaryStart += dropped;
+                }
+                return IterationStatus::Continue;
+            }
+        }
+
+        unsigned from = start > offset ? start - offset : 0;
+        size_t match = segment.find(pattern, from);
+        if (match != notFound) {
+            result = offset + match;
+            return IterationStatus::Done;
+        }
+
+        unsigned tailLength = std::min(overlap, segmentLength);
+        boundary.shrink(0);
+        for (unsigned i = segmentLength - tailLength; i < segmentLength; ++i)
+            boundary.append(segment[i]);
+        boundaryStart = offset + segmentLength - tailLength;
+        return IterationStatus::Continue;
+    });
+
+    // Deep or fragmented ropes are usually built by repeated appends, and a loop of searches over one
+    // would walk every fiber each time. Let the caller resolve instead.
+    if (!searched)
+        return WTF::nullopt;
+    return result;
+}
+
 void JSRopeString::outOfMemory(ExecState* nullOrExecForOOM) const
 {
     ASSERT(isRope());
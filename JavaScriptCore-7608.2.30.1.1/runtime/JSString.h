@@ -526,6 +526,17 @@ public:
 
     static constexpr unsigned s_maxInternalRopeLength = 3;
 
+    // Searching or indexing a large rope does not flatten it. Flattening would copy every fiber and
+    // keep both the fibers and the flat copy alive for a single lookup.
+    static constexpr unsigned minLengthToAccessWithoutResolving = 64 * KB;
+    static constexpr unsigned maxDepthToAccessWithoutResolving = 32;
+    static constexpr unsigned maxFibersToAccessWithoutResolving = 256;
+
+    bool canAccessWithoutResolving() const { return !isSubstring() && length() >= minLengthToAccessWithoutResolving; }
+    JS_EXPORT_PRIVATE Optional<UChar> characterAtWithoutResolving(unsigned) const;
+    // Returns WTF::nullopt if the rope is too deep or has too many fibers, and should be resolved instead.
+    JS_EXPORT_PRIVATE Optional<size_t> findWithoutResolving(StringView, unsigned start) const;
+
     // This JSRopeString is only used to simulate half-baked JSRopeString in DFG and FTL MakeRope. If OSR exit happens in
     // the middle of MakeRope due to string length overflow, we have half-baked JSRopeString which is the same to the result
     // of this function. This half-baked JSRopeString will not be exposed to users, but still collectors can see it due to
@@ -585,6 +596,7 @@ private:
     void resolveRopeInternal8NoSubstring(LChar*) const;
     void resolveRopeInternal16(UChar*) const;
     void resolveRopeInternal16NoSubstring(UChar*) const;
+    template<typename Functor> bool forEachFiberSegment(unsigned start, const Functor&) const;
     StringView unsafeView(ExecState*) const;
     StringViewWithUnderlyingString viewWithUnderlyingString(ExecState*) const;
 
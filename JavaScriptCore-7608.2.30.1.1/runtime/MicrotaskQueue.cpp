@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "MicrotaskQueue.h"
+
+#include "JSCInlines.h"
+#include "JSGlobalObject.h"
+#include "JSMicrotask.h"
+#include "SlotVisitorInlines.h"
+
+namespace JSC {
+
+void MicrotaskQueue::enqueue(JSGlobalObject& globalObject, JSValue job, const JSValue* arguments, unsigned argumentCount)
+{
+    RELEASE_ASSERT(argumentCount <= maximumArgumentCount);
+    Task task { &globalObject, job, { }, argumentCount, nullptr };
+    for (unsigned i = 0; i < argumentCount; ++i)
+        task.arguments[i] = arguments[i];
+    m_queue.append(WTFMove(task));
+    m_statistics.enqueuedJSJobs++;
+    didEnqueue();
+}
+
+void MicrotaskQueue::enqueue(JSGlobalObject& globalObject, Ref<Microtask>&& microtask)
+{
+    m_queue.append(Task { &globalObject, JSValue(), { }, 0, WTFMove(microtask) });
+    m_statistics.enqueuedNativeTasks++;
+    didEnqueue();
+}
+
+void MicrotaskQueue::drain(VM& vm, const WTF::Function<void(VM&)>& onEachTick)
+{
+    m_statistics.drains++;
+    while (!m_queue.isEmpty()) {
+        // Once the task is off the queue, the conservative scan of this frame keeps its values alive.
+        Task task = m_queue.takeFirst();
+        ExecState* exec = task.globalObject->globalExec();
+        if (task.microtask)
+            task.microtask->run(exec);
+        else
+            runJSMicrotask(exec, task.job, task.arguments.data(), task.argumentCount);
+        m_statistics.ranTasks++;
+        if (onEachTick)
+            onEachTick(vm);
+    }
+}
+
+void MicrotaskQueue::visitAggregate(SlotVisitor& visitor)
+{
+    for (Task& task : m_queue) {
+        visitor.appendUnbarriered(task.globalObject);
+        visitor.appendUnbarriered(task.job);
+        for (unsigned i = 0; i < task.argumentCount; ++i)
+            visitor.appendUnbarriered(task.arguments[i]);
+    }
+}
+
+} // namespace JSC
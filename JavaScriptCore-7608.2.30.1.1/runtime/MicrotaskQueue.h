@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include "JSCJSValue.h"
+#include "Microtask.h"
+#include <array>
+#include <wtf/Deque.h>
+
+namespace JSC {
+
+class JSGlobalObject;
+class SlotVisitor;
+class VM;
+
+// The VM's queue of pending microtasks. Jobs enqueued from JavaScript, which is how every promise
+// reaction is scheduled, are stored inline: the job function, its arguments and the global object
+// to run it in sit directly in the entry, and the GC visits them as roots. Since Deque is a ring
+// buffer that keeps its capacity while it drains, a steady stream of promise jobs does not allocate
+// once the buffer has grown to the working size. Native Microtasks (for example from the
+// inspector or the embedder) still use the ref-counted Microtask interface.
+class MicrotaskQueue {
+    WTF_MAKE_NONCOPYABLE(MicrotaskQueue);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static constexpr unsigned maximumArgumentCount = 4;
+
+    struct Statistics {
+        uint64_t enqueuedJSJobs { 0 };
+        uint64_t enqueuedNativeTasks { 0 };
+        uint64_t ranTasks { 0 };
+        uint64_t drains { 0 };
+        size_t peakLength { 0 };
+    };
+
+    MicrotaskQueue() = default;
+
+    bool isEmpty() const { return m_queue.isEmpty(); }
+    size_t size() const { return m_queue.size(); }
+
+    void enqueue(JSGlobalObject&, JSValue job, const JSValue* arguments, unsigned argumentCount);
+    void enqueue(JSGlobalObject&, Ref<Microtask>&&);
+
+    // Runs every task, including tasks that running tasks enqueue, calling onEachTick after each one.
+    void drain(VM&, const WTF::Function<void(VM&)>& onEachTick);
+
+    void visitAggregate(SlotVisitor&);
+
+    const Statistics& statistics() const { return m_statistics; }
+
+private:
+    struct Task {
+        JSGlobalObject* globalObject;
+        JSValue job;
+        std::array<JSValue, maximumArgumentCount> arguments;
+        unsigned argumentCount;
+        RefPtr<Microtask> microtask;
+    };
+
+    void didEnqueue()
+    {
+        m_statistics.peakLength = std::max(m_statistics.peakLength, m_queue.size());
+    }
+
+    Deque<Task> m_queue;
+    Statistics m_statistics;
+};
+
+} // namespace JSC
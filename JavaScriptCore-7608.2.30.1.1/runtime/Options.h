@@ -133,9 +133,14 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(bool, crashIfCantAllocateJITMemory, false, Normal, nullptr) \
     v(unsigned, jitMemoryReservationSize, 0, Normal, "Set this number to change the executable allocation size in ExecutableAllocatorFixedVMPool. (In bytes.)") \
     v(bool, useSeparatedWXHeap, false, Normal, nullptr) \
+    v(double, jitColdMemoryFraction, 0.125, Normal, "Fraction of the executable memory pool set aside for rarely run code like OSR exit ramps and lazy slow paths. 0 puts all code in one region.") \
+    v(bool, useHugePagesForJITMemory, false, Normal, "On Linux, commit the executable memory pool up front and back its hot region with transparent huge pages.") \
+    v(bool, dumpExecutableAllocatorStatistics, false, Normal, "Log how much of each executable memory region is used when the jsc shell exits.") \
+    v(bool, useFTLColdCode, true, Normal, "Link the blocks that FTL code rarely takes, and its OSR exit and slow paths, into the cold executable memory region.") \
     \
     v(bool, forceCodeBlockLiveness, false, Normal, nullptr) \
     v(bool, forceICFailure, false, Normal, nullptr) \
+    v(bool, useDictionaryAccessInlineCaches, true, Normal, "Allows get_by_id inline caches to probe the property table of uncacheable dictionaries instead of giving up") \
     \
     v(unsigned, repatchCountForCoolDown, 8, Normal, nullptr) \
     v(unsigned, initialCoolDownCount, 20, Normal, nullptr) \
@@ -265,8 +270,10 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, maxPolymorphicCallVariantListSizeForTopTier, 5, Normal, nullptr) \
     v(unsigned, maxPolymorphicCallVariantListSizeForWebAssemblyToJS, 5, Normal, nullptr) \
     v(unsigned, maxPolymorphicCallVariantsForInlining, 5, Normal, nullptr) \
+    v(unsigned, maxPolymorphicCallDispatchTableSize, 64, Normal, "Call sites with more targets than a polymorphic call stub allows dispatch through a table keyed by executable, up to this many targets; 0 disables the table") \
     v(unsigned, frequentCallThreshold, 2, Normal, nullptr) \
     v(double, minimumCallToKnownRate, 0.51, Normal, nullptr) \
+    v(double, minimumCallToKnownRateForDispatchTable, 0.2, Normal, "Like minimumCallToKnownRate, for call sites whose remaining targets still go through a dispatch table") \
     v(bool, createPreHeaders, true, Normal, nullptr) \
     v(bool, useMovHintRemoval, true, Normal, nullptr) \
     v(bool, usePutStackSinking, true, Normal, nullptr) \
@@ -333,6 +340,7 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     \
     v(int32, evalThresholdMultiplier, 10, Normal, nullptr) \
     v(unsigned, maximumEvalCacheableSourceLength, 256, Normal, nullptr) \
+    v(unsigned, intlFormatterCacheSize, 32, Normal, "Number of ICU formatters of each kind the VM keeps for reuse; 0 disables the cache") \
     \
     v(bool, randomizeExecutionCountsBetweenCheckpoints, false, Normal, nullptr) \
     v(int32, maximumExecutionCountsBetweenCheckpointsForBaseline, 1000, Normal, nullptr) \
@@ -388,8 +396,13 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(bool, forceCodeBlockToJettisonDueToOldAge, false, Normal, "If true, this means that anytime we can jettison a CodeBlock due to old age, we do.") \
     v(bool, useEagerCodeBlockJettisonTiming, false, Normal, "If true, the time slices for jettisoning a CodeBlock due to old age are shrunk significantly.") \
     \
+    v(bool, useSharedAtomStringTable, false, Normal, "If true, identifiers are atomized against a process-wide table so that VMs on different threads share their characters.") \
+    v(unsigned, sharedAtomStringTableCapacity, 1 << 16, Normal, "Number of buckets in the process-wide atom table. It holds at most half as many strings.") \
+    \
     v(bool, useTypeProfiler, false, Normal, nullptr) \
     v(bool, useControlFlowProfiler, false, Normal, nullptr) \
+    v(unsigned, typeProfilerSamplingInterval, 1, Normal, "when greater than 1, the type profiler records only one in every N observed values, which keeps it cheap enough to run with the FTL enabled") \
+    v(unsigned, typeProfilerLogSize, 50000, Normal, "number of entries the type profiler buffers before they are folded into the type sets") \
     \
     v(bool, useSamplingProfiler, false, Normal, nullptr) \
     v(unsigned, sampleInterval, 1000, Normal, "Time between stack traces in microseconds.") \
@@ -399,6 +412,10 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(optionString, samplingProfilerPath, nullptr, Normal, "The path to the directory to write sampiling profiler output to. This probably will not work with WK2 unless the path is in the whitelist.") \
     v(bool, sampleCCode, false, Normal, "Causes the sampling profiler to record profiling data for C frames.") \
     \
+    v(bool, useAllocationSiteProfiler, false, Normal, "Samples allocations and attributes live bytes to the JS stack that allocated them.") \
+    v(unsigned, allocationSiteProfilerSamplingInterval, 512 * KB, Normal, "Average number of allocated bytes between two allocation site samples.") \
+    v(unsigned, allocationSiteProfilerMaxStackDepth, 8, Normal, "Number of JS frames recorded for each allocation site sample.") \
+    \
     v(bool, alwaysGeneratePCToCodeOriginMap, false, Normal, "This will make sure we always generate a PCToCodeOriginMap for JITed code.") \
     \
     v(bool, verifyHeap, false, Normal, nullptr) \
@@ -438,9 +455,15 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, airRandomizeRegsSeed, 0, Normal, nullptr) \
     v(bool, coalesceSpillSlots, true, Normal, nullptr) \
     v(bool, logAirRegisterPressure, false, Normal, nullptr) \
+    v(bool, logAirRegisterAllocation, false, Normal, "logs the allocator, compile time and spill statistics of every Air register allocation") \
+    v(unsigned, maximumTmpsForGraphColoring, 60000, Normal, "functions with more Air tmps than this use linear scan register allocation even at optLevel 2") \
+    v(bool, logB3Remarks, false, Normal, "log the decisions B3 phases record as remarks, like why a loop was or was not unrolled") \
     v(bool, useB3TailDup, true, Normal, nullptr) \
     v(unsigned, maxB3TailDupBlockSize, 3, Normal, nullptr) \
     v(unsigned, maxB3TailDupBlockSuccessors, 3, Normal, nullptr) \
+    v(bool, useB3LoopUnrolling, false, Normal, "unroll counted unit stride loops in B3; off until it has shown a win on benchmarks") \
+    v(unsigned, b3LoopUnrollFactor, 4, Normal, "number of iterations of a counted unit stride loop that B3 executes per back edge") \
+    v(unsigned, maxB3LoopUnrollBlockSize, 40, Normal, nullptr) \
     \
     v(bool, useDollarVM, false, Restricted, "installs the $vm debugging tool in global objects") \
     v(optionString, functionOverrides, nullptr, Restricted, "file with debugging overrides for function bodies") \
@@ -456,6 +479,9 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, prototypeHitCountForLLIntCaching, 2, Normal, "Number of prototype property hits before caching a prototype in the LLInt. A count of 0 means never cache.") \
     \
     v(bool, dumpCompiledRegExpPatterns, false, Normal, nullptr) \
+    v(unsigned, regExpCacheCapacity, 32, Normal, "Number of compiled regular expressions each VM keeps alive, evicting the least recently used.") \
+    v(unsigned, sharedRegExpCodeCacheCapacity, 128, Normal, "Number of regular expressions whose JIT code is kept in a process-wide cache shared by all VMs. 0 disables the cache.") \
+    v(bool, dumpRegExpCacheStatistics, false, Normal, "Dumps regular expression cache hit rates when a VM is destroyed.") \
     \
     v(bool, dumpModuleRecord, false, Normal, nullptr) \
     v(bool, dumpModuleLoadingState, false, Normal, nullptr) \
@@ -465,6 +491,7 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     \
     v(bool, useSourceProviderCache, true, Normal, "If false, the parser will not use the source provider cache. It's good to verify everything works when this is false. Because the cache is so successful, it can mask bugs.") \
     v(bool, useCodeCache, true, Normal, "If false, the unlinked byte code cache will not be used.") \
+    v(bool, useUnlinkedFunctionCodeBlockSharing, true, Normal, "If true, functions with identical source text and compilation context share one unlinked code block.") \
     \
     v(bool, useWebAssembly, true, Normal, "Expose the WebAssembly global object.") \
     \
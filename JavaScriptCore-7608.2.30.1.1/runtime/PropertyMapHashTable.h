@@ -193,8 +193,9 @@ public:
     // Copy this PropertyTable, ensuring the copy has at least the capacity provided.
     PropertyTable* copy(VM&, unsigned newCapacity);
 
-#ifndef NDEBUG
     size_t sizeInMemory();
+
+#ifndef NDEBUG
     void checkConsistency();
 #endif
     
@@ -471,7 +472,6 @@ inline PropertyTable* PropertyTable::copy(VM& vm, unsigned newCapacity)
     return PropertyTable::clone(vm, newCapacity, *this);
 }
 
-#ifndef NDEBUG
 inline size_t PropertyTable::sizeInMemory()
 {
     size_t result = sizeof(PropertyTable) + dataSize();
@@ -479,7 +479,6 @@ inline size_t PropertyTable::sizeInMemory()
         result += (m_deletedOffsets->capacity() * sizeof(PropertyOffset));
     return result;
 }
-#endif
 
 inline void PropertyTable::reinsert(const ValueType& entry)
 {
@@ -222,6 +222,19 @@ static std::unique_ptr<Yarr::BytecodePattern> byteCodeCompilePattern(VM* vm, Yar
     return Yarr::byteCompile(pattern, &vm->m_regExpAllocator, errorCode, &vm->m_regExpAllocatorLock);
 }
 
+#if ENABLE(YARR_JIT)
+static void jitCompileWithSharedCode(VM* vm, Yarr::YarrPattern& pattern, const RegExpKey& key, String& patternString, Yarr::YarrCharSize charSize, Yarr::YarrCodeBlock& jitCode, Yarr::YarrJITCompileMode mode)
+{
+    SharedRegExpCodeCache& sharedCode = SharedRegExpCodeCache::singleton();
+    if (sharedCode.copyCode(key, charSize, mode, jitCode))
+        return;
+
+    Yarr::jitCompile(pattern, patternString, charSize, vm, jitCode, mode);
+    if (!jitCode.failureReason())
+        sharedCode.addCode(key, charSize, mode, jitCode);
+}
+#endif
+
 void RegExp::byteCodeCompileIfNecessary(VM* vm)
 {
     if (m_regExpBytecode)
@@ -268,7 +281,7 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 #endif
         ) {
         auto& jitCode = ensureRegExpJITCode();
-        Yarr::jitCompile(pattern, m_patternString, charSize, vm, jitCode);
+        jitCompileWithSharedCode(vm, pattern, key(), m_patternString, charSize, jitCode, Yarr::IncludeSubpatterns);
         if (!jitCode.failureReason()) {
             m_state = JITCode;
             return;
@@ -330,7 +343,7 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
 #endif
         ) {
         auto& jitCode = ensureRegExpJITCode();
-        Yarr::jitCompile(pattern, m_patternString, charSize, vm, jitCode, Yarr::MatchOnly);
+        jitCompileWithSharedCode(vm, pattern, key(), m_patternString, charSize, jitCode, Yarr::MatchOnly);
         if (!jitCode.failureReason()) {
             m_state = JITCode;
             return;
@@ -83,6 +83,14 @@ public:
     template<typename VectorType>
     int matchInline(VM&, const String&, unsigned startOffset, VectorType& ovector);
     MatchResult matchInline(VM&, const String&, unsigned startOffset);
+
+    // Finds successive matches the way a global replace or split walks them: each search starts
+    // where the previous match ended, or at fixEnd(end) if that match was empty. JIT code is
+    // entered once for the whole batch rather than once per match. Appends the offset vectors of
+    // up to maxMatches matches to ovectors and returns how many it found. startOffset is left
+    // where the next batch should start. Callers must check for an exception afterwards.
+    template<typename VectorType, typename FixEndFunc>
+    unsigned collectMatchOffsets(VM&, const String&, unsigned& startOffset, unsigned maxMatches, VectorType& ovectors, const FixEndFunc&);
     
     unsigned numSubpatterns() const { return m_numSubpatterns; }
 
@@ -32,14 +32,20 @@
 #include "JSCInlines.h"
 #include "RegExpObject.h"
 #include "StrongInlines.h"
+#include <mutex>
 
 namespace JSC {
 
 RegExp* RegExpCache::lookupOrCreate(const String& patternString, OptionSet<Yarr::Flags> flags)
 {
     RegExpKey key(flags, patternString);
-    if (RegExp* regExp = m_weakCache.get(key))
+    if (RegExp* regExp = m_weakCache.get(key)) {
+        m_statistics.hits++;
+        if (m_strongCacheUseOrder.contains(regExp))
+            m_strongCacheUseOrder.appendOrMoveToLast(regExp);
         return regExp;
+    }
+    m_statistics.misses++;
 
     RegExp* regExp = RegExp::createWithoutCaching(*m_vm, patternString, flags);
 #if ENABLE(REGEXP_TRACING)
@@ -51,11 +57,20 @@ RegExp* RegExpCache::lookupOrCreate(const String& patternString, OptionSet<Yarr:
 }
 
 RegExpCache::RegExpCache(VM* vm)
-    : m_nextEntryInStrongCache(0)
-    , m_vm(vm)
+    : m_vm(vm)
 {
 }
 
+RegExpCache::~RegExpCache()
+{
+    if (Options::dumpRegExpCacheStatistics()) {
+        dataLogLn("RegExpCache: ", m_statistics);
+#if ENABLE(YARR_JIT)
+        SharedRegExpCodeCache::singleton().dumpStatistics(WTF::dataFile());
+#endif
+    }
+}
+
 RegExp* RegExpCache::ensureEmptyRegExpSlow(VM& vm)
 {
     RegExp* regExp = RegExp::create(vm, "", { });
@@ -74,17 +89,24 @@ void RegExpCache::addToStrongCache(RegExp* regExp)
     String pattern = regExp->pattern();
     if (pattern.length() > maxStrongCacheablePatternLength)
         return;
-    m_strongCache[m_nextEntryInStrongCache].set(*m_vm, regExp);
-    m_nextEntryInStrongCache++;
-    if (m_nextEntryInStrongCache == maxStrongCacheableEntries)
-        m_nextEntryInStrongCache = 0;
+    unsigned capacity = Options::regExpCacheCapacity();
+    if (!capacity)
+        return;
+    if (!m_strongCacheUseOrder.appendOrMoveToLast(regExp).isNewEntry)
+        return;
+    m_strongCache.add(regExp, Strong<RegExp>(*m_vm, regExp));
+
+    if (m_strongCacheUseOrder.size() > capacity) {
+        RegExp* leastRecentlyUsed = m_strongCacheUseOrder.takeFirst();
+        m_strongCache.remove(leastRecentlyUsed);
+        m_statistics.evictions++;
+    }
 }
 
 void RegExpCache::deleteAllCode()
 {
-    for (int i = 0; i < maxStrongCacheableEntries; i++)
-        m_strongCache[i].clear();
-    m_nextEntryInStrongCache = 0;
+    m_strongCacheUseOrder.clear();
+    m_strongCache.clear();
 
     RegExpCacheMap::iterator end = m_weakCache.end();
     for (RegExpCacheMap::iterator it = m_weakCache.begin(); it != end; ++it) {
@@ -95,4 +117,76 @@ void RegExpCache::deleteAllCode()
     }
 }
 
+void RegExpCache::Statistics::dump(PrintStream& out) const
+{
+    out.print(hits, " hits, ", misses, " misses, ", evictions, " evictions");
+}
+
+#if ENABLE(YARR_JIT)
+SharedRegExpCodeCache& SharedRegExpCodeCache::singleton()
+{
+    static SharedRegExpCodeCache* cache;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        cache = new SharedRegExpCodeCache;
+    });
+    return *cache;
+}
+
+bool SharedRegExpCodeCache::copyCode(const RegExpKey& key, Yarr::YarrCharSize charSize, Yarr::YarrJITCompileMode mode, Yarr::YarrCodeBlock& jitCode)
+{
+    if (!Options::sharedRegExpCodeCacheCapacity())
+        return false;
+
+    auto locker = holdLock(m_lock);
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end() || !iter->value.codeBlock.hasCodeFor(charSize, mode)) {
+        m_misses++;
+        return false;
+    }
+
+    m_hits++;
+    iter->value.lastUse = ++m_useCount;
+    jitCode.copyCodeFrom(iter->value.codeBlock, charSize, mode);
+    return true;
+}
+
+void SharedRegExpCodeCache::addCode(const RegExpKey& key, Yarr::YarrCharSize charSize, Yarr::YarrJITCompileMode mode, const Yarr::YarrCodeBlock& jitCode)
+{
+    unsigned capacity = Options::sharedRegExpCodeCacheCapacity();
+    if (!capacity)
+        return;
+
+    auto locker = holdLock(m_lock);
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end()) {
+        if (m_entries.size() >= capacity)
+            evictLeastRecentlyUsed(locker);
+        // The key outlives the VM that compiled the code, and is used from other threads.
+        RefPtr<StringImpl> isolatedPattern = key.pattern->isolatedCopy();
+        iter = m_entries.add(RegExpKey(key.flagsValue, WTFMove(isolatedPattern)), Entry()).iterator;
+    }
+
+    iter->value.codeBlock.copyCodeFrom(jitCode, charSize, mode);
+    iter->value.lastUse = ++m_useCount;
+}
+
+void SharedRegExpCodeCache::evictLeastRecentlyUsed(const AbstractLocker&)
+{
+    auto leastRecentlyUsed = m_entries.end();
+    for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+        if (leastRecentlyUsed == m_entries.end() || iter->value.lastUse < leastRecentlyUsed->value.lastUse)
+            leastRecentlyUsed = iter;
+    }
+    if (leastRecentlyUsed != m_entries.end())
+        m_entries.remove(leastRecentlyUsed);
+}
+
+void SharedRegExpCodeCache::dumpStatistics(PrintStream& out)
+{
+    auto locker = holdLock(m_lock);
+    out.print("SharedRegExpCodeCache: ", m_entries.size(), " entries, ", m_hits, " hits, ", m_misses, " misses\n");
+}
+#endif // ENABLE(YARR_JIT)
+
 }
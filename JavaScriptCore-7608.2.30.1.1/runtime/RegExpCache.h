@@ -31,8 +31,10 @@
 #include "RegExpKey.h"
 #include "Strong.h"
 #include "Weak.h"
-#include <array>
+#include "YarrJIT.h"
 #include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Lock.h>
 
 namespace JSC {
 
@@ -48,6 +50,7 @@ class RegExpCache : private WeakHandleOwner {
 
 public:
     RegExpCache(VM* vm);
+    ~RegExpCache();
     void deleteAllCode();
 
     RegExp* ensureEmptyRegExp(VM& vm)
@@ -57,12 +60,20 @@ public:
         return ensureEmptyRegExpSlow(vm);
     }
 
+    struct Statistics {
+        uint64_t hits { 0 };
+        uint64_t misses { 0 };
+        uint64_t evictions { 0 };
+
+        void dump(PrintStream&) const;
+    };
+
+    const Statistics& statistics() const { return m_statistics; }
+
 private:
     
     static const unsigned maxStrongCacheablePatternLength = 256;
 
-    static const int maxStrongCacheableEntries = 32;
-
     void finalize(Handle<Unknown>, void* context) override;
 
     RegExp* ensureEmptyRegExpSlow(VM&);
@@ -70,10 +81,49 @@ private:
     RegExp* lookupOrCreate(const WTF::String& patternString, OptionSet<Yarr::Flags>);
     void addToStrongCache(RegExp*);
     RegExpCacheMap m_weakCache; // Holds all regular expressions currently live.
-    int m_nextEntryInStrongCache;
-    std::array<Strong<RegExp>, maxStrongCacheableEntries> m_strongCache; // Holds a select few regular expressions that have compiled and executed
+    // Keeps the Options::regExpCacheCapacity() most recently used regular expressions that have
+    // compiled alive, so that they survive GC. Least recently used first.
+    ListHashSet<RegExp*> m_strongCacheUseOrder;
+    HashMap<RegExp*, Strong<RegExp>> m_strongCache;
     Strong<RegExp> m_emptyRegExp;
+    Statistics m_statistics;
     VM* m_vm;
 };
 
+#if ENABLE(YARR_JIT)
+// JIT code for regular expressions, shared by every VM in the process. YarrJIT code only refers
+// to process-wide data, so code compiled on behalf of one VM can be run by any other, and a
+// pattern used by many VMs is only compiled once. Each entry holds the code compiled so far for
+// one pattern and set of flags. The least recently used entry is evicted once there are
+// Options::sharedRegExpCodeCacheCapacity() of them.
+class SharedRegExpCodeCache {
+    WTF_MAKE_NONCOPYABLE(SharedRegExpCodeCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static SharedRegExpCodeCache& singleton();
+
+    // Returns true if jitCode now has code for the given character size and mode.
+    bool copyCode(const RegExpKey&, Yarr::YarrCharSize, Yarr::YarrJITCompileMode, Yarr::YarrCodeBlock& jitCode);
+    void addCode(const RegExpKey&, Yarr::YarrCharSize, Yarr::YarrJITCompileMode, const Yarr::YarrCodeBlock& jitCode);
+
+    void dumpStatistics(PrintStream&);
+
+private:
+    SharedRegExpCodeCache() = default;
+
+    struct Entry {
+        Yarr::YarrCodeBlock codeBlock;
+        uint64_t lastUse { 0 };
+    };
+
+    void evictLeastRecentlyUsed(const AbstractLocker&);
+
+    Lock m_lock;
+    HashMap<RegExpKey, Entry> m_entries;
+    uint64_t m_useCount { 0 };
+    uint64_t m_hits { 0 };
+    uint64_t m_misses { 0 };
+};
+#endif // ENABLE(YARR_JIT)
+
 } // namespace JSC
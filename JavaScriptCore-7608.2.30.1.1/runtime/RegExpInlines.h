@@ -118,6 +118,26 @@ private:
     void* m_buffer { nullptr };
 };
 
+// Tells the sampling profiler that we're running regular expression JIT code. The code itself
+// can't do this because it may be shared with other VMs (see SharedRegExpCodeCache).
+class RegExpJITExecutionScope {
+    WTF_FORBID_HEAP_ALLOCATION;
+public:
+    RegExpJITExecutionScope(VM& vm)
+        : m_vm(vm)
+    {
+        m_vm.isExecutingInRegExpJIT = true;
+    }
+
+    ~RegExpJITExecutionScope()
+    {
+        m_vm.isExecutingInRegExpJIT = false;
+    }
+
+private:
+    VM& m_vm;
+};
+
 ALWAYS_INLINE void RegExp::compileIfNecessary(VM& vm, Yarr::YarrCharSize charSize)
 {
     if (hasCodeFor(charSize))
@@ -161,6 +181,7 @@ ALWAYS_INLINE int RegExp::matchInline(VM& vm, const String& s, unsigned startOff
         {
             ASSERT(m_regExpJITCode);
             PatternContextBufferHolder patternContextBufferHolder(vm, m_regExpJITCode->usesPatternContextBuffer());
+            RegExpJITExecutionScope executionScope(vm);
 
             if (s.is8Bit())
                 result = m_regExpJITCode->execute(s.characters8(), startOffset, s.length(), offsetVector, patternContextBufferHolder.buffer(), patternContextBufferHolder.size()).start;
@@ -227,6 +248,66 @@ ALWAYS_INLINE int RegExp::matchInline(VM& vm, const String& s, unsigned startOff
     return result;
 }
 
+template<typename VectorType, typename FixEndFunc>
+ALWAYS_INLINE unsigned RegExp::collectMatchOffsets(VM& vm, const String& s, unsigned& startOffset, unsigned maxMatches, VectorType& ovectors, const FixEndFunc& fixEnd)
+{
+    unsigned length = s.length();
+    unsigned offsetVectorSize = (m_numSubpatterns + 1) * 2;
+    unsigned matchCount = 0;
+
+    auto advance = [&] (const int* offsetVector) {
+        unsigned end = offsetVector[1];
+        if (offsetVector[0] == offsetVector[1])
+            end = fixEnd(end);
+        startOffset = end;
+    };
+
+    compileIfNecessary(vm, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
+
+#if ENABLE(YARR_JIT)
+    // The JIT code doesn't report matches whose offsets overflow an int, so longer strings take
+    // the path below, which checks for that.
+    if (m_state == JITCode && length <= INT_MAX) {
+        ASSERT(m_regExpJITCode);
+        PatternContextBufferHolder patternContextBufferHolder(vm, m_regExpJITCode->usesPatternContextBuffer());
+        RegExpJITExecutionScope executionScope(vm);
+
+        while (matchCount < maxMatches && startOffset <= length) {
+            size_t offsetVectorStart = ovectors.size();
+            ovectors.grow(offsetVectorStart + offsetVectorSize);
+            int* offsetVector = ovectors.data() + offsetVectorStart;
+
+            int result;
+            if (s.is8Bit())
+                result = m_regExpJITCode->execute(s.characters8(), startOffset, length, offsetVector, patternContextBufferHolder.buffer(), patternContextBufferHolder.size()).start;
+            else
+                result = m_regExpJITCode->execute(s.characters16(), startOffset, length, offsetVector, patternContextBufferHolder.buffer(), patternContextBufferHolder.size()).start;
+
+            if (result < 0) {
+                ovectors.shrink(offsetVectorStart);
+                if (result != Yarr::JSRegExpJITCodeFailure)
+                    return matchCount;
+                // Let matchInline() punt this search to the interpreter.
+                break;
+            }
+
+            matchCount++;
+            advance(offsetVector);
+        }
+    }
+#endif
+
+    Vector<int, 32> ovector;
+    while (matchCount < maxMatches && startOffset <= length) {
+        if (matchInline(vm, s, startOffset, ovector) < 0)
+            break;
+        ovectors.append(ovector.data(), offsetVectorSize);
+        matchCount++;
+        advance(ovector.data());
+    }
+    return matchCount;
+}
+
 ALWAYS_INLINE bool RegExp::hasMatchOnlyCodeFor(Yarr::YarrCharSize charSize)
 {
     if (hasCode()) {
@@ -286,6 +367,7 @@ ALWAYS_INLINE MatchResult RegExp::matchInline(VM& vm, const String& s, unsigned
         {
             ASSERT(m_regExpJITCode);
             PatternContextBufferHolder patternContextBufferHolder(vm, m_regExpJITCode->usesPatternContextBuffer());
+            RegExpJITExecutionScope executionScope(vm);
             if (s.is8Bit())
                 result = m_regExpJITCode->execute(s.characters8(), startOffset, s.length(), patternContextBufferHolder.buffer(), patternContextBufferHolder.size());
             else
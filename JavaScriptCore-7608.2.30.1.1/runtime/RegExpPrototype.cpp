@@ -33,6 +33,7 @@
 #include "Lexer.h"
 #include "ObjectPrototype.h"
 #include "RegExpCache.h"
+#include "RegExpInlines.h"
 #include "RegExpObject.h"
 #include "RegExpObjectInlines.h"
 #include "StringObject.h"
@@ -501,12 +502,94 @@ enum SplitControl {
     AbortSplit
 };
 
+// Without the sticky flag, the matches genericSplit() visits are mostly the successive matches of a
+// global search, so they can be found in batches. A batch searches again after an empty match at
+// AdvanceStringIndex(S, e), which is where the spec's loop goes next unless it just split at that
+// match. Then the spec searches again at e first, so we do that search on its own and carry on with
+// the batch once the loop is back where the batch's next search started.
+template<typename ControlFunc, typename PushFunc>
+void genericSplitWithCollectedMatches(
+    VM& vm, RegExp* regexp, const String& input, unsigned inputSize, unsigned& position,
+    unsigned& matchPosition, bool regExpIsUnicode, const ControlFunc& control, const PushFunc& push)
+{
+    static const unsigned matchesPerBatch = 64;
+    unsigned offsetVectorSize = (regexp->numSubpatterns() + 1) * 2;
+    unsigned numberOfCaptures = regexp->numSubpatterns();
+    auto fixEnd = [&] (unsigned end) -> unsigned {
+        return advanceStringIndex(input, inputSize, end, regExpIsUnicode);
+    };
+
+    Vector<int, 64> ovectors;
+    unsigned matchCount = 0;
+    unsigned matchIndex = 0;
+    bool batchFoundEveryMatch = false;
+    // Where the search that found the batch's next match started.
+    unsigned batchSearchPosition = matchPosition;
+    Vector<int> ovector;
+
+    while (matchPosition < inputSize) {
+        if (control() == AbortSplit)
+            return;
+
+        const int* match;
+        if (matchPosition != batchSearchPosition && matchIndex < matchCount) {
+            ovector.shrink(0);
+            if (regexp->match(vm, input, matchPosition, ovector) < 0)
+                return;
+            match = ovector.data();
+        } else {
+            if (matchIndex == matchCount) {
+                if (batchFoundEveryMatch && matchPosition == batchSearchPosition)
+                    return;
+                ovectors.shrink(0);
+                unsigned nextBatchPosition = matchPosition;
+                matchCount = regexp->collectMatchOffsets(vm, input, nextBatchPosition, matchesPerBatch, ovectors, fixEnd);
+                matchIndex = 0;
+                batchFoundEveryMatch = matchCount < matchesPerBatch;
+                batchSearchPosition = matchPosition;
+                if (!matchCount)
+                    return;
+            }
+            match = ovectors.data() + matchIndex++ * offsetVectorSize;
+            batchSearchPosition = match[0] == match[1] ? fixEnd(match[1]) : match[1];
+        }
+
+        unsigned mpos = match[0];
+        // See genericSplit() for why a match at the end of the input ends the split.
+        if (mpos >= inputSize)
+            return;
+
+        matchPosition = mpos;
+        unsigned matchEnd = match[1];
+        if (matchEnd == position) {
+            matchPosition = fixEnd(matchPosition);
+            continue;
+        }
+        ASSERT(matchEnd);
+
+        if (push(true, position, matchPosition - position) == AbortSplit)
+            return;
+        position = matchEnd;
+        for (unsigned i = 1; i <= numberOfCaptures; ++i) {
+            int sub = match[i * 2];
+            if (push(sub >= 0, sub, match[i * 2 + 1] - sub) == AbortSplit)
+                return;
+        }
+        matchPosition = position;
+    }
+}
+
 template<typename ControlFunc, typename PushFunc>
 void genericSplit(
     VM& vm, RegExp* regexp, const String& input, unsigned inputSize, unsigned& position,
     unsigned& matchPosition, bool regExpIsSticky, bool regExpIsUnicode,
     const ControlFunc& control, const PushFunc& push)
 {
+    if (!regExpIsSticky) {
+        genericSplitWithCollectedMatches(vm, regexp, input, inputSize, position, matchPosition, regExpIsUnicode, control, push);
+        return;
+    }
+
     Vector<int> ovector;
         
     while (matchPosition < inputSize) {
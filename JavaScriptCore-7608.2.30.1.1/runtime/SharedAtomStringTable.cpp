@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "SharedAtomStringTable.h"
+
+#include "Options.h"
+#include <mutex>
+#include <wtf/MathExtras.h>
+#include <wtf/text/StringHash.h>
+
+namespace JSC {
+
+SharedAtomStringTable& SharedAtomStringTable::singleton()
+{
+    static SharedAtomStringTable* table;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        table = new SharedAtomStringTable(Options::sharedAtomStringTableCapacity());
+    });
+    return *table;
+}
+
+SharedAtomStringTable::SharedAtomStringTable(unsigned capacity)
+{
+    capacity = WTF::roundUpToPowerOfTwo(std::max(capacity, 16u));
+    m_capacityMask = capacity - 1;
+    m_buckets = std::make_unique<std::atomic<const Entry*>[]>(capacity);
+}
+
+RefPtr<AtomStringImpl> SharedAtomStringTable::add(const LChar* characters, unsigned length)
+{
+    return addImpl(characters, length);
+}
+
+RefPtr<AtomStringImpl> SharedAtomStringTable::add(const UChar* characters, unsigned length)
+{
+    return addImpl(characters, length);
+}
+
+template<typename CharacterType>
+RefPtr<AtomStringImpl> SharedAtomStringTable::addImpl(const CharacterType* characters, unsigned length)
+{
+    if (length < minimumLength || length > maximumLength)
+        return nullptr;
+
+    // Only the first atomization on each thread needs the shared copy.
+    if (auto atom = AtomStringImpl::lookUp(characters, length))
+        return atom;
+
+    unsigned hash = StringHasher::computeHashAndMaskTop8Bits(characters, length);
+    const Entry* entry = find(characters, length, hash);
+    if (!entry) {
+        entry = findOrInsert(characters, length, hash);
+        if (!entry)
+            return nullptr;
+    }
+
+    return AtomStringImpl::add(StringImpl::createWithoutCopying(static_cast<const CharacterType*>(entry->characters), length).ptr());
+}
+
+template<typename CharacterType>
+auto SharedAtomStringTable::find(const CharacterType* characters, unsigned length, unsigned hash) const -> const Entry*
+{
+    constexpr bool is8Bit = std::is_same<CharacterType, LChar>::value;
+    for (unsigned index = hash & m_capacityMask; ; index = (index + 1) & m_capacityMask) {
+        const Entry* entry = m_buckets[index].load(std::memory_order_acquire);
+        if (!entry)
+            return nullptr;
+        if (entry->hash == hash
+            && entry->length == length
+            && entry->is8Bit == is8Bit
+            && WTF::equal(static_cast<const CharacterType*>(entry->characters), characters, length))
+            return entry;
+    }
+}
+
+template<typename CharacterType>
+auto SharedAtomStringTable::findOrInsert(const CharacterType* characters, unsigned length, unsigned hash) -> const Entry*
+{
+    auto locker = holdLock(m_lock);
+
+    // Someone may have inserted the string since we looked.
+    if (const Entry* entry = find(characters, length, hash))
+        return entry;
+
+    // Keep the load factor at or below 1/2 so that probing stays short and always terminates.
+    unsigned size = m_size.load(std::memory_order_relaxed);
+    if ((size + 1) * 2 > m_capacityMask + 1)
+        return nullptr;
+
+    CharacterType* copy = static_cast<CharacterType*>(fastMalloc(length * sizeof(CharacterType)));
+    memcpy(copy, characters, length * sizeof(CharacterType));
+    const Entry* entry = new Entry { copy, length, hash, std::is_same<CharacterType, LChar>::value };
+
+    unsigned index = hash & m_capacityMask;
+    while (m_buckets[index].load(std::memory_order_relaxed))
+        index = (index + 1) & m_capacityMask;
+    m_buckets[index].store(entry, std::memory_order_release);
+    m_size.store(size + 1, std::memory_order_relaxed);
+    return entry;
+}
+
+} // namespace JSC
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include <wtf/Lock.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/text/AtomStringImpl.h>
+
+namespace JSC {
+
+// A process-wide table of identifier characters shared by every VM. An AtomString belongs to
+// the AtomStringTable of a single thread, so each VM still atomizes on its own. The atoms it
+// creates for strings found here point at the shared characters instead of allocating another
+// copy. Each atom is a StringImpl of its own thread that doesn't own its characters, so nothing
+// reference counted is shared between threads. Lookups don't take a lock. Only insertions are
+// serialized.
+//
+// Strings we don't take (too short to be worth sharing, too long, or arriving after the table
+// filled up) are atomized the ordinary way, in the VM's own table.
+class SharedAtomStringTable {
+    WTF_MAKE_NONCOPYABLE(SharedAtomStringTable);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static SharedAtomStringTable& singleton();
+
+    // Returns nullptr if the caller should atomize the string itself.
+    RefPtr<AtomStringImpl> add(const LChar*, unsigned length);
+    RefPtr<AtomStringImpl> add(const UChar*, unsigned length);
+
+    unsigned size() const { return m_size.load(std::memory_order_relaxed); }
+
+    // Sharing saves only the characters, which for short strings is less than the lookup costs.
+    static constexpr unsigned minimumLength = sizeof(StringImpl*) + 1;
+    static constexpr unsigned maximumLength = 128;
+
+private:
+    // Entries and their characters are never freed.
+    struct Entry {
+        WTF_MAKE_STRUCT_FAST_ALLOCATED;
+
+        const void* characters;
+        unsigned length;
+        unsigned hash;
+        bool is8Bit;
+    };
+
+    explicit SharedAtomStringTable(unsigned capacity);
+
+    template<typename CharacterType> RefPtr<AtomStringImpl> addImpl(const CharacterType*, unsigned length);
+    template<typename CharacterType> const Entry* find(const CharacterType*, unsigned length, unsigned hash) const;
+    template<typename CharacterType> const Entry* findOrInsert(const CharacterType*, unsigned length, unsigned hash);
+
+    unsigned m_capacityMask;
+    std::unique_ptr<std::atomic<const Entry*>[]> m_buckets;
+    std::atomic<unsigned> m_size { 0 };
+    Lock m_lock;
+};
+
+} // namespace JSC
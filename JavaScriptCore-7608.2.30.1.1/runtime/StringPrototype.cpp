@@ -45,6 +45,8 @@
 #include "RegExpCache.h"
 #include "RegExpConstructor.h"
 #include "RegExpGlobalDataInlines.h"
+#include "RegExpInlines.h"
+#include "RegExpObjectInlines.h"
 #include "StringPrototypeInlines.h"
 #include "SuperSampler.h"
 #include <algorithm>
@@ -479,6 +481,15 @@ static ALWAYS_INLINE JSString* jsSpliceSubstringsWithSeparators(ExecState* exec,
         return nullptr; \
     } while (false)
 
+// This is AdvanceStringIndex from the spec. After an empty match, a unicode regexp searches again
+// after the whole code point rather than between the halves of a surrogate pair.
+static ALWAYS_INLINE unsigned advanceAfterEmptyMatch(RegExp* regExp, const String& source, unsigned end)
+{
+    if (regExp->unicode())
+        return advanceStringUnicode(source, source.length(), end);
+    return end + 1;
+}
+
 static ALWAYS_INLINE JSString* removeUsingRegExpSearch(VM& vm, ExecState* exec, JSString* string, const String& source, RegExp* regExp)
 {
     auto scope = DECLARE_THROW_SCOPE(vm);
@@ -506,7 +517,7 @@ static ALWAYS_INLINE JSString* removeUsingRegExpSearch(VM& vm, ExecState* exec,
 
         // special case of empty match
         if (result.empty()) {
-            startPosition++;
+            startPosition = advanceAfterEmptyMatch(regExp, source, startPosition);
             if (startPosition > sourceLen)
                 break;
         }
@@ -555,8 +566,52 @@ static ALWAYS_INLINE JSString* replaceUsingRegExpSearch(
     Vector<StringRange, 16> sourceRanges;
     Vector<String, 16> replacements;
 
+    auto appendStringReplacement = [&] (const MatchResult& result, int* ovector) -> bool {
+        int replLen = replacementString.length();
+        if (lastIndex < result.start || replLen) {
+            if (UNLIKELY(!sourceRanges.tryConstructAndAppend(lastIndex, result.start - lastIndex)))
+                return false;
+
+            if (replLen) {
+                StringBuilder replacement(StringBuilder::OverflowHandler::RecordOverflow);
+                substituteBackreferences(replacement, replacementString, source, ovector, regExp);
+                if (UNLIKELY(replacement.hasOverflowed()))
+                    return false;
+                replacements.append(replacement.toString());
+            } else
+                replacements.append(String());
+        }
+        return true;
+    };
+
     // This is either a loop (if global is set) or a one-way (if not).
-    if (global && callType == CallType::JS) {
+    if (global && callType == CallType::None) {
+        // No user code runs between matches, so we can find them in batches. Each search after an
+        // empty match starts where the loops below would start it.
+        static const unsigned matchesPerBatch = 64;
+        unsigned offsetVectorSize = (regExp->numSubpatterns() + 1) * 2;
+        Vector<int, 64> ovectors;
+        unsigned matchCount;
+        do {
+            ovectors.shrink(0);
+            matchCount = regExp->collectMatchOffsets(vm, source, startPosition, matchesPerBatch, ovectors,
+                [&] (unsigned end) -> unsigned {
+                    return advanceAfterEmptyMatch(regExp, source, end);
+                });
+            RETURN_IF_EXCEPTION(scope, nullptr);
+
+            for (unsigned i = 0; i < matchCount; ++i) {
+                int* ovector = ovectors.data() + i * offsetVectorSize;
+                MatchResult result(ovector[0], ovector[1]);
+                // Record every match, like performMatch() does, so RegExp.lastMatch and RegExp.$1
+                // end up describing the last one.
+                globalObject->regExpGlobalData().recordMatch(vm, globalObject, regExp, string, result);
+                if (UNLIKELY(!appendStringReplacement(result, ovector)))
+                    OUT_OF_MEMORY(exec, scope);
+                lastIndex = result.end;
+            }
+        } while (matchCount == matchesPerBatch);
+    } else if (global && callType == CallType::JS) {
         // regExp->numSubpatterns() + 1 for pattern args, + 2 for match start and string
         int argCount = regExp->numSubpatterns() + 1 + 2;
         if (hasNamedCaptures)
@@ -624,7 +679,7 @@ static ALWAYS_INLINE JSString* replaceUsingRegExpSearch(
 
             // special case of empty match
             if (result.empty()) {
-                startPosition++;
+                startPosition = advanceAfterEmptyMatch(regExp, source, startPosition);
                 if (startPosition > sourceLen)
                     break;
             }
@@ -687,29 +742,15 @@ static ALWAYS_INLINE JSString* replaceUsingRegExpSearch(
                 RETURN_IF_EXCEPTION(scope, nullptr);
                 replacements.append(replacementString);
                 RETURN_IF_EXCEPTION(scope, nullptr);
-            } else {
-                int replLen = replacementString.length();
-                if (lastIndex < result.start || replLen) {
-                    if (UNLIKELY(!sourceRanges.tryConstructAndAppend(lastIndex, result.start - lastIndex)))
-                        OUT_OF_MEMORY(exec, scope);
-
-                    if (replLen) {
-                        StringBuilder replacement(StringBuilder::OverflowHandler::RecordOverflow);
-                        substituteBackreferences(replacement, replacementString, source, ovector, regExp);
-                        if (UNLIKELY(replacement.hasOverflowed()))
-                            OUT_OF_MEMORY(exec, scope);
-                        replacements.append(replacement.toString());
-                    } else
-                        replacements.append(String());
-                }
-            }
+            } else if (UNLIKELY(!appendStringReplacement(result, ovector)))
+                OUT_OF_MEMORY(exec, scope);
 
             lastIndex = result.end;
             startPosition = lastIndex;
 
             // special case of empty match
             if (result.empty()) {
-                startPosition++;
+                startPosition = advanceAfterEmptyMatch(regExp, source, startPosition);
                 if (startPosition > sourceLen)
                     break;
             }
@@ -963,11 +1004,20 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
-    auto viewWithString = thisValue.toString(exec)->viewWithUnderlyingString(exec);
-    RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    StringView view = viewWithString.view;
+    JSString* thisJSString = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
     JSValue a0 = exec->argument(0);
+    if (a0.isUInt32() && thisJSString->isRope()) {
+        JSRopeString* rope = static_cast<JSRopeString*>(thisJSString);
+        uint32_t i = a0.asUInt32();
+        if (rope->canAccessWithoutResolving() && i < rope->length()) {
+            if (Optional<UChar> character = rope->characterAtWithoutResolving(i))
+                return JSValue::encode(jsSingleCharacterString(exec, *character));
+        }
+    }
+    auto viewWithString = thisJSString->viewWithUnderlyingString(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    StringView view = viewWithString.view;
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < view.length())
@@ -989,10 +1039,20 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
-    auto viewWithString = thisValue.toString(exec)->viewWithUnderlyingString(exec);
+    JSString* thisJSString = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    StringView view = viewWithString.view;
     JSValue a0 = exec->argument(0);
+    if (a0.isUInt32() && thisJSString->isRope()) {
+        JSRopeString* rope = static_cast<JSRopeString*>(thisJSString);
+        uint32_t i = a0.asUInt32();
+        if (rope->canAccessWithoutResolving() && i < rope->length()) {
+            if (Optional<UChar> character = rope->characterAtWithoutResolving(i))
+                return JSValue::encode(jsNumber(*character));
+        }
+    }
+    auto viewWithString = thisJSString->viewWithUnderlyingString(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    StringView view = viewWithString.view;
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < view.length())
@@ -1083,14 +1143,19 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncIndexOf(ExecState* exec)
     if (thisJSString->length() < otherJSString->length() + pos)
         return JSValue::encode(jsNumber(-1));
 
-    auto thisViewWithString = thisJSString->viewWithUnderlyingString(exec);
-    RETURN_IF_EXCEPTION(scope, encodedJSValue());
     auto otherViewWithString = otherJSString->viewWithUnderlyingString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    size_t result = thisViewWithString.view.find(otherViewWithString.view, pos);
-    if (result == notFound)
+    Optional<size_t> result;
+    if (thisJSString->isRope() && static_cast<JSRopeString*>(thisJSString)->canAccessWithoutResolving())
+        result = static_cast<JSRopeString*>(thisJSString)->findWithoutResolving(otherViewWithString.view, pos);
+    if (!result) {
+        auto thisViewWithString = thisJSString->viewWithUnderlyingString(exec);
+        RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        result = thisViewWithString.view.find(otherViewWithString.view, pos);
+    }
+    if (*result == notFound)
         return JSValue::encode(jsNumber(-1));
-    return JSValue::encode(jsNumber(result));
+    return JSValue::encode(jsNumber(*result));
 }
 
 EncodedJSValue JSC_HOST_CALL stringProtoFuncLastIndexOf(ExecState* exec)
@@ -1742,19 +1807,28 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
     return JSValue::encode(jsBoolean(stringToSearchIn.hasInfixEndingAt(searchString, std::min(end, length))));
 }
 
-static EncodedJSValue JSC_HOST_CALL stringIncludesImpl(VM& vm, ExecState* exec, String stringToSearchIn, String searchString, JSValue positionArg)
+static EncodedJSValue JSC_HOST_CALL stringIncludesImpl(VM& vm, ExecState* exec, JSString* stringToSearchIn, String searchString, JSValue positionArg)
 {
     auto scope = DECLARE_THROW_SCOPE(vm);
+    unsigned length = stringToSearchIn->length();
     unsigned start = 0;
     if (positionArg.isInt32())
         start = std::max(0, positionArg.asInt32());
     else {
-        unsigned length = stringToSearchIn.length();
         start = clampAndTruncateToUnsigned(positionArg.toInteger(exec), 0, length);
         RETURN_IF_EXCEPTION(scope, encodedJSValue());
     }
 
-    return JSValue::encode(jsBoolean(stringToSearchIn.find(searchString, start) != notFound));
+    if (stringToSearchIn->isRope() && static_cast<JSRopeString*>(stringToSearchIn)->canAccessWithoutResolving()) {
+        if (start > length)
+            return JSValue::encode(jsBoolean(searchString.isEmpty()));
+        if (Optional<size_t> result = static_cast<JSRopeString*>(stringToSearchIn)->findWithoutResolving(searchString, start))
+            return JSValue::encode(jsBoolean(*result != notFound));
+    }
+
+    String string = stringToSearchIn->value(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    return JSValue::encode(jsBoolean(string.find(searchString, start) != notFound));
 }
 
 EncodedJSValue JSC_HOST_CALL stringProtoFuncIncludes(ExecState* exec)
@@ -1766,7 +1840,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncIncludes(ExecState* exec)
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
 
-    String stringToSearchIn = thisValue.toWTFString(exec);
+    JSString* stringToSearchIn = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue a0 = exec->argument(0);
@@ -1791,7 +1865,7 @@ EncodedJSValue JSC_HOST_CALL builtinStringIncludesInternal(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     ASSERT(checkObjectCoercible(thisValue));
 
-    String stringToSearchIn = thisValue.toWTFString(exec);
+    JSString* stringToSearchIn = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue a0 = exec->uncheckedArgument(0);
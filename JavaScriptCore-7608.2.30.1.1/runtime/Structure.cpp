@@ -378,8 +378,14 @@ PropertyTable* Structure::materializePropertyTable(VM& vm, bool setPropertyTable
 
     for (size_t i = structures.size(); i--;) {
         structure = structures[i];
-        if (!structure->m_nameInPrevious)
+        if (!structure->m_nameInPrevious) {
+            // Seal and freeze edit every property that came before them in the chain.
+            if (unsigned attributesToSet = attributesSetOnAllExistingProperties(structure->attributesInPrevious())) {
+                for (auto& entry : *table)
+                    entry.attributes = applyAttributesSetOnAllExistingProperties(entry.attributes, attributesToSet);
+            }
             continue;
+        }
         PropertyMapEntry entry(structure->m_nameInPrevious.get(), structure->m_offset, structure->attributesInPrevious());
         table->add(entry, m_offset, PropertyTable::PropertyOffsetMustNotChange);
     }
@@ -662,24 +668,23 @@ Structure* Structure::nonPropertyTransitionSlow(VM& vm, Structure* structure, No
     if (preventsExtensions(transitionKind))
         transition->setDidPreventExtensions(true);
     
-    if (setsDontDeleteOnAllProperties(transitionKind)
-        || setsReadOnlyOnNonAccessorProperties(transitionKind)) {
-        // We pin the property table on transitions that do wholesale editing of the property
-        // table, since our logic for walking the property transition chain to rematerialize the
-        // table doesn't know how to take into account such wholesale edits.
-
-        PropertyTable* table = structure->copyPropertyTableForPinning(vm);
-        transition->pinForCaching(holdLock(transition->m_lock), vm, table);
+    if (unsigned attributesToSet = attributesSetOnAllExistingProperties(attributes)) {
+        // Walking the transition chain replays these wholesale edits when rematerializing the
+        // property table, so the table only needs to be pinned if the chain is about to be cut
+        // because we are transitioning away from a dictionary.
+        PropertyTable* table;
+        if (structure->isDictionary()) {
+            table = structure->copyPropertyTableForPinning(vm);
+            transition->pinForCaching(holdLock(transition->m_lock), vm, table);
+        } else {
+            table = structure->takePropertyTableOrCloneIfPinned(vm);
+            transition->setPropertyTable(vm, table);
+        }
         transition->m_offset = structure->m_offset;
+        checkOffset(transition->m_offset, transition->inlineCapacity());
         
-        table = transition->propertyTableOrNull();
-        RELEASE_ASSERT(table);
-        for (auto& entry : *table) {
-            if (setsDontDeleteOnAllProperties(transitionKind))
-                entry.attributes |= static_cast<unsigned>(PropertyAttribute::DontDelete);
-            if (setsReadOnlyOnNonAccessorProperties(transitionKind) && !(entry.attributes & PropertyAttribute::Accessor))
-                entry.attributes |= static_cast<unsigned>(PropertyAttribute::ReadOnly);
-        }
+        for (auto& entry : *table)
+            entry.attributes = applyAttributesSetOnAllExistingProperties(entry.attributes, attributesToSet);
     } else {
         transition->setPropertyTable(vm, structure->takePropertyTableOrCloneIfPinned(vm));
         transition->m_offset = structure->m_offset;
@@ -34,21 +34,27 @@ namespace JSC {
 #if USE(JSVALUE64)
 
 StructureIDTable::StructureIDTable()
-    : m_table(makeUniqueArray<StructureOrOffset>(s_initialSize))
+    : m_reservation(PageReservation::reserve(static_cast<size_t>(s_maximumNumberOfSegments) * s_segmentSizeInBytes, OSAllocator::UnknownUsage))
     , m_size(1)
-    , m_capacity(s_initialSize)
 {
-    // We pre-allocate the first offset so that the null Structure
-    // can still be represented as the StructureID '0'.
-    table()[0].encodedStructureBits = 0;
+    RELEASE_ASSERT(m_reservation);
+    RELEASE_ASSERT(!(s_segmentSizeInBytes % pageSize()));
+    m_table = static_cast<StructureOrOffset*>(m_reservation.base());
 
-    makeFreeListFromRange(1, m_capacity - 1);
+    m_segments.append(Segment());
+    m_capacity = s_entriesPerSegment;
+    commitSegment(0);
 }
 
-void StructureIDTable::makeFreeListFromRange(uint32_t first, uint32_t last)
+StructureIDTable::~StructureIDTable()
 {
-    ASSERT(!m_firstFreeOffset);
-    ASSERT(!m_lastFreeOffset);
+    m_reservation.deallocate();
+}
+
+void StructureIDTable::makeFreeListFromRange(Segment& segment, uint32_t first, uint32_t last)
+{
+    ASSERT(!segment.firstFreeOffset);
+    ASSERT(!segment.lastFreeOffset);
 
     // Put all the new IDs on the free list sequentially.
     uint32_t head = first;
@@ -93,54 +99,126 @@ void StructureIDTable::makeFreeListFromRange(uint32_t first, uint32_t last)
         table()[cut].offset = 0;
     }
 
-    m_firstFreeOffset = head;
-    m_lastFreeOffset = tail;
+    segment.firstFreeOffset = head;
+    segment.lastFreeOffset = tail;
+    segment.numberOfFreeEntries = size;
 }
 
-void StructureIDTable::resize(size_t newCapacity)
+void StructureIDTable::commitSegment(unsigned segmentIndex)
 {
-    if (newCapacity > s_maximumNumberOfStructures)
-        newCapacity = s_maximumNumberOfStructures;
+    ASSERT(segmentIndex < m_segments.size());
+    ASSERT(!m_committedSegments.get(segmentIndex));
+
+    uint32_t first = segmentIndex * s_entriesPerSegment;
+    uint32_t last = first + s_entriesPerSegment - 1;
+    m_reservation.commit(table() + first, s_segmentSizeInBytes);
+    m_committedSegments.set(segmentIndex);
 
-    // If m_size is already s_maximumNumberOfStructures, newCapacity becomes s_maximumNumberOfStructures in the above code.
-    // In that case, we should crash because of exhaust of StructureIDs.
-    RELEASE_ASSERT_WITH_MESSAGE(m_size < newCapacity, "Crash intentionally because of exhaust of StructureIDs.");
+    if (!first) {
+        // We pre-allocate the first offset so that the null Structure
+        // can still be represented as the StructureID '0'.
+        table()[0].encodedStructureBits = 0;
+        first = 1;
+    }
+
+    makeFreeListFromRange(m_segments[segmentIndex], first, last);
+    m_segmentsWithFreeEntries.set(segmentIndex);
+}
 
-    // Create the new table.
-    auto newTable = makeUniqueArray<StructureOrOffset>(newCapacity);
+void StructureIDTable::decommitSegment(unsigned segmentIndex)
+{
+    ASSERT(segmentIndex);
+    ASSERT(m_segments[segmentIndex].numberOfFreeEntries == s_entriesPerSegment);
+
+    m_segments[segmentIndex] = Segment();
+    m_segmentsWithFreeEntries.clear(segmentIndex);
+    m_committedSegments.clear(segmentIndex);
+    m_reservation.decommit(table() + segmentIndex * s_entriesPerSegment, s_segmentSizeInBytes);
+}
+
+unsigned StructureIDTable::findSegmentForAllocation()
+{
+    // Prefer the lowest segment with free entries, so that the segments at the top of the table
+    // get a chance to become entirely free.
+    size_t segmentWithFreeEntries = m_segmentsWithFreeEntries.findBit(0, true);
+    if (segmentWithFreeEntries < m_segments.size())
+        return segmentWithFreeEntries;
+
+    for (unsigned segmentIndex = 0; segmentIndex < m_segments.size(); ++segmentIndex) {
+        if (!m_committedSegments.get(segmentIndex)) {
+            commitSegment(segmentIndex);
+            return segmentIndex;
+        }
+    }
 
-    // Copy the contents of the old table to the new table.
-    memcpy(newTable.get(), table(), m_capacity * sizeof(StructureOrOffset));
+    // If we already have s_maximumNumberOfSegments, we should crash because of exhaust of StructureIDs.
+    RELEASE_ASSERT_WITH_MESSAGE(m_segments.size() < s_maximumNumberOfSegments, "Crash intentionally because of exhaust of StructureIDs.");
 
-    // Store fence to make sure we've copied everything before doing the swap.
+    unsigned newSegmentIndex = m_segments.size();
+    m_segments.append(Segment());
+    commitSegment(newSegmentIndex);
+
+    // Make sure that the new entries are visible before anyone can see an ID that refers to them.
     WTF::storeStoreFence();
+    m_capacity += s_entriesPerSegment;
+    return newSegmentIndex;
+}
 
-    // Swap the old and new tables.
-    swap(m_table, newTable);
+void StructureIDTable::decommitFreeSegments()
+{
+    // Keep one free segment around so that churn right at a segment boundary doesn't make us
+    // commit and decommit over and over.
+    bool keptFreeSegment = false;
+    for (unsigned segmentIndex = 1; segmentIndex < m_segments.size(); ++segmentIndex) {
+        if (!m_committedSegments.get(segmentIndex))
+            continue;
+        if (m_segments[segmentIndex].numberOfFreeEntries != s_entriesPerSegment)
+            continue;
+        if (!keptFreeSegment) {
+            keptFreeSegment = true;
+            continue;
+        }
+        decommitSegment(segmentIndex);
+    }
 
-    // Put the old table (now labeled as new) into the list of old tables.
-    m_oldTables.append(WTFMove(newTable));
+    while (m_segments.size() > 1 && !m_committedSegments.get(m_segments.size() - 1)) {
+        m_segments.removeLast();
+        m_capacity -= s_entriesPerSegment;
+    }
 
-    // Update the capacity.
-    m_capacity = newCapacity;
+    if (m_allocationSegment >= m_segments.size() || !m_segments[m_allocationSegment].numberOfFreeEntries)
+        m_allocationSegment = 0;
+}
 
-    makeFreeListFromRange(m_size, m_capacity - 1);
+auto StructureIDTable::statistics() const -> Statistics
+{
+    Statistics result;
+    result.liveEntries = m_size;
+    for (unsigned segmentIndex = 0; segmentIndex < m_segments.size(); ++segmentIndex) {
+        if (!m_committedSegments.get(segmentIndex)) {
+            result.decommittedSegments++;
+            continue;
+        }
+        result.committedSegments++;
+        result.freeEntries += m_segments[segmentIndex].numberOfFreeEntries;
+    }
+    result.committedBytes = result.committedSegments * s_segmentSizeInBytes;
+    return result;
 }
 
-void StructureIDTable::flushOldTables()
+void StructureIDTable::Statistics::dump(PrintStream& out) const
 {
-    m_oldTables.clear();
+    out.print(
+        liveEntries, " live, ", freeEntries, " free, ", committedSegments, " committed segments (",
+        committedBytes / KB, " KB), ", decommittedSegments, " decommitted segments");
 }
 
 StructureID StructureIDTable::allocateID(Structure* structure)
 {
-    if (UNLIKELY(!m_firstFreeOffset)) {
-        RELEASE_ASSERT(m_capacity <= s_maximumNumberOfStructures);
-        ASSERT(m_size == m_capacity);
-        resize(m_capacity * 2);
-        ASSERT(m_size < m_capacity);
-        RELEASE_ASSERT(m_firstFreeOffset);
-    }
+    if (UNLIKELY(!m_segments[m_allocationSegment].numberOfFreeEntries))
+        m_allocationSegment = findSegmentForAllocation();
+    Segment& segment = m_segments[m_allocationSegment];
+    RELEASE_ASSERT(segment.firstFreeOffset);
 
     // entropyBits must not be zero. This ensures that if a corrupted
     // structureID is encountered (with incorrect entropyBits), the decoded
@@ -153,10 +231,12 @@ StructureID StructureIDTable::allocateID(Structure* structure)
         entropyBits = (m_weakRandom.getUint32() % numberOfValuesToPickFrom) + 1;
     }
 
-    uint32_t structureIndex = m_firstFreeOffset;
-    m_firstFreeOffset = table()[m_firstFreeOffset].offset;
-    if (!m_firstFreeOffset)
-        m_lastFreeOffset = 0;
+    uint32_t structureIndex = segment.firstFreeOffset;
+    segment.firstFreeOffset = table()[structureIndex].offset;
+    if (!segment.firstFreeOffset)
+        segment.lastFreeOffset = 0;
+    if (!--segment.numberOfFreeEntries)
+        m_segmentsWithFreeEntries.clear(m_allocationSegment);
 
     StructureID result = (structureIndex << s_numberOfEntropyBits) | entropyBits;
     table()[structureIndex].encodedStructureBits = encode(structure, result);
@@ -169,24 +249,32 @@ void StructureIDTable::deallocateID(Structure* structure, StructureID structureI
 {
     ASSERT(structureID != s_unusedID);
     uint32_t structureIndex = structureID >> s_numberOfEntropyBits;
-    ASSERT(structureIndex && structureIndex < s_maximumNumberOfStructures);
+    ASSERT(structureIndex && structureIndex < m_capacity);
     RELEASE_ASSERT(table()[structureIndex].encodedStructureBits == encode(structure, structureID));
     m_size--;
-    if (!m_firstFreeOffset) {
+
+    unsigned segmentIndex = structureIndex / s_entriesPerSegment;
+    Segment& segment = m_segments[segmentIndex];
+    if (!segment.numberOfFreeEntries++)
+        m_segmentsWithFreeEntries.set(segmentIndex);
+    if (segmentIndex < m_allocationSegment)
+        m_allocationSegment = segmentIndex;
+
+    if (!segment.firstFreeOffset) {
         table()[structureIndex].offset = 0;
-        m_firstFreeOffset = structureIndex;
-        m_lastFreeOffset = structureIndex;
+        segment.firstFreeOffset = structureIndex;
+        segment.lastFreeOffset = structureIndex;
         return;
     }
 
     bool insertAtHead = m_weakRandom.getUint32() & 1;
     if (insertAtHead) {
-        table()[structureIndex].offset = m_firstFreeOffset;
-        m_firstFreeOffset = structureIndex;
+        table()[structureIndex].offset = segment.firstFreeOffset;
+        segment.firstFreeOffset = structureIndex;
     } else {
         table()[structureIndex].offset = 0;
-        table()[m_lastFreeOffset].offset = structureIndex;
-        m_lastFreeOffset = structureIndex;
+        table()[segment.lastFreeOffset].offset = structureIndex;
+        segment.lastFreeOffset = structureIndex;
     }
 }
 
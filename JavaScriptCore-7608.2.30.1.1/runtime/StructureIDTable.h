@@ -26,7 +26,10 @@
 #pragma once
 
 #include "UnusedPointer.h"
-#include <wtf/UniqueArray.h>
+#include <wtf/BitVector.h>
+#include <wtf/Bitmap.h>
+#include <wtf/PageReservation.h>
+#include <wtf/PrintStream.h>
 #include <wtf/Vector.h>
 #include <wtf/WeakRandom.h>
 
@@ -84,10 +87,25 @@ inline StructureID decontaminate(StructureID id)
 
 using EncodedStructureBits = uintptr_t;
 
+// The table is a single virtual memory reservation big enough for every possible StructureID, so
+// that the JITs can index it directly and it never moves. It is committed one segment at a time.
+// Each segment has its own free list, and we always allocate from the lowest segment that has a
+// free entry. That keeps live entries packed at the bottom of the table so that segments above
+// them drain after a spike in structure churn, at which point decommitFreeSegments() gives their
+// pages back.
 class StructureIDTable {
     friend class LLIntOffsetsExtractor;
+
+    union StructureOrOffset {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        EncodedStructureBits encodedStructureBits;
+        StructureID offset;
+    };
+
 public:
     StructureIDTable();
+    ~StructureIDTable();
 
     void** base() { return reinterpret_cast<void**>(&m_table); }
 
@@ -96,41 +114,23 @@ public:
     void deallocateID(Structure*, StructureID);
     StructureID allocateID(Structure*);
 
-    void flushOldTables();
+    // This must only be called when nobody can be looking up the ID of a dead structure, like
+    // when the world is stopped for GC.
+    void decommitFreeSegments();
     
     size_t size() const { return m_size; }
 
-private:
-    void resize(size_t newCapacity);
-    void makeFreeListFromRange(uint32_t first, uint32_t last);
+    struct Statistics {
+        void dump(PrintStream&) const;
 
-    union StructureOrOffset {
-        WTF_MAKE_FAST_ALLOCATED;
-    public:
-        EncodedStructureBits encodedStructureBits;
-        StructureID offset;
+        size_t liveEntries { 0 };
+        size_t freeEntries { 0 };
+        size_t committedSegments { 0 };
+        size_t decommittedSegments { 0 };
+        size_t committedBytes { 0 };
     };
+    Statistics statistics() const;
 
-    StructureOrOffset* table() const { return m_table.get(); }
-    static Structure* decode(EncodedStructureBits, StructureID);
-    static EncodedStructureBits encode(Structure*, StructureID);
-
-    static constexpr size_t s_initialSize = 512;
-
-    Vector<UniqueArray<StructureOrOffset>> m_oldTables;
-
-    uint32_t m_firstFreeOffset { 0 };
-    uint32_t m_lastFreeOffset { 0 };
-    UniqueArray<StructureOrOffset> m_table;
-
-    size_t m_size { 0 };
-    size_t m_capacity;
-
-    WeakRandom m_weakRandom;
-
-    static constexpr StructureID s_unusedID = 0;
-
-public:
     // 1. StructureID is encoded as:
     //
     //    ----------------------------------------------------------------
@@ -155,6 +155,42 @@ public:
     static constexpr uint32_t s_entropyBitsShiftForStructurePointer = (sizeof(intptr_t) * 8) - s_numberOfEntropyBits;
 
     static constexpr uint32_t s_maximumNumberOfStructures = 1 << (32 - s_numberOfEntropyBits - s_numberOfNukeBits);
+
+    // This must be a multiple of the page size.
+    static constexpr size_t s_segmentSizeInBytes = 16 * KB;
+    static constexpr uint32_t s_entriesPerSegment = s_segmentSizeInBytes / sizeof(StructureOrOffset);
+    static constexpr uint32_t s_maximumNumberOfSegments = s_maximumNumberOfStructures / s_entriesPerSegment;
+
+private:
+    struct Segment {
+        uint32_t firstFreeOffset { 0 };
+        uint32_t lastFreeOffset { 0 };
+        uint32_t numberOfFreeEntries { 0 };
+    };
+
+    void makeFreeListFromRange(Segment&, uint32_t first, uint32_t last);
+    void commitSegment(unsigned segmentIndex);
+    void decommitSegment(unsigned segmentIndex);
+    unsigned findSegmentForAllocation();
+
+    StructureOrOffset* table() const { return m_table; }
+    static Structure* decode(EncodedStructureBits, StructureID);
+    static EncodedStructureBits encode(Structure*, StructureID);
+
+    PageReservation m_reservation;
+    StructureOrOffset* m_table { nullptr };
+
+    Vector<Segment> m_segments;
+    Bitmap<s_maximumNumberOfSegments> m_committedSegments;
+    BitVector m_segmentsWithFreeEntries;
+    unsigned m_allocationSegment { 0 };
+
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+
+    WeakRandom m_weakRandom;
+
+    static constexpr StructureID s_unusedID = 0;
 };
 
 ALWAYS_INLINE Structure* StructureIDTable::decode(EncodedStructureBits bits, StructureID structureID)
@@ -183,6 +219,8 @@ inline bool StructureIDTable::isValid(StructureID structureID)
     uint32_t structureIndex = structureID >> s_numberOfEntropyBits;
     if (structureIndex >= m_capacity)
         return false;
+    if (!m_committedSegments.get(structureIndex / s_entriesPerSegment))
+        return false;
 #if CPU(ADDRESS64)
     Structure* structure = decode(table()[structureIndex].encodedStructureBits, structureID);
     if (reinterpret_cast<uintptr_t>(structure) >> s_entropyBitsShiftForStructurePointer)
@@ -206,7 +244,7 @@ public:
         return structure;
     };
 
-    void flushOldTables() { }
+    void decommitFreeSegments() { }
 };
 
 #endif // not USE(JSVALUE64)
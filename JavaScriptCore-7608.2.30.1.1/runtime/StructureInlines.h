@@ -164,9 +164,21 @@ void Structure::forEachPropertyConcurrently(const Functor& functor)
     
     findStructuresAndMapForMaterialization(structures, structure, table);
     
+    // Seal and freeze transitions edit every property that came before them, so each entry needs
+    // the attributes set by the transitions that are newer than the one that added it.
+    Vector<unsigned, 8> attributesSetByNewerTransitions(structures.size());
+    unsigned attributesToSet = 0;
+    for (unsigned i = 0; i < structures.size(); ++i) {
+        attributesSetByNewerTransitions[i] = attributesToSet;
+        if (!structures[i]->m_nameInPrevious)
+            attributesToSet |= attributesSetOnAllExistingProperties(structures[i]->attributesInPrevious());
+    }
+    
     if (table) {
         for (auto& entry : *table) {
-            if (!functor(entry)) {
+            PropertyMapEntry editedEntry = entry;
+            editedEntry.attributes = applyAttributesSetOnAllExistingProperties(entry.attributes, attributesToSet);
+            if (!functor(editedEntry)) {
                 structure->m_lock.unlock();
                 return;
             }
@@ -179,7 +191,8 @@ void Structure::forEachPropertyConcurrently(const Functor& functor)
         if (!structure->m_nameInPrevious)
             continue;
         
-        if (!functor(PropertyMapEntry(structure->m_nameInPrevious.get(), structure->m_offset, structure->attributesInPrevious())))
+        unsigned attributes = applyAttributesSetOnAllExistingProperties(structure->attributesInPrevious(), attributesSetByNewerTransitions[i]);
+        if (!functor(PropertyMapEntry(structure->m_nameInPrevious.get(), structure->m_offset, attributes)))
             return;
     }
 }
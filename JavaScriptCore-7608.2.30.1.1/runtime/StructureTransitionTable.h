@@ -26,6 +26,7 @@
 #pragma once
 
 #include "IndexingType.h"
+#include "PropertySlot.h"
 #include "WeakGCMap.h"
 #include <wtf/HashFunctions.h>
 #include <wtf/text/UniquedStringImpl.h>
@@ -139,6 +140,29 @@ inline bool setsReadOnlyOnNonAccessorProperties(NonPropertyTransition transition
     }
 }
 
+// Returns the attributes that a transition with the given attributesInPrevious adds to every
+// property that existed before it. Only meaningful for transitions that have no nameInPrevious.
+inline unsigned attributesSetOnAllExistingProperties(unsigned attributesInPrevious)
+{
+    if (attributesInPrevious < FirstInternalAttribute)
+        return 0;
+    NonPropertyTransition transition = static_cast<NonPropertyTransition>(attributesInPrevious - FirstInternalAttribute);
+    unsigned result = 0;
+    if (setsDontDeleteOnAllProperties(transition))
+        result |= static_cast<unsigned>(PropertyAttribute::DontDelete);
+    if (setsReadOnlyOnNonAccessorProperties(transition))
+        result |= static_cast<unsigned>(PropertyAttribute::ReadOnly);
+    return result;
+}
+
+inline unsigned applyAttributesSetOnAllExistingProperties(unsigned attributes, unsigned attributesToSet)
+{
+    attributes |= attributesToSet & static_cast<unsigned>(PropertyAttribute::DontDelete);
+    if (!(attributes & PropertyAttribute::Accessor))
+        attributes |= attributesToSet & static_cast<unsigned>(PropertyAttribute::ReadOnly);
+    return attributes;
+}
+
 class StructureTransitionTable {
     static const intptr_t UsingSingleSlotFlag = 1;
 
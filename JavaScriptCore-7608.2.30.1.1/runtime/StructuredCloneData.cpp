@@ -0,0 +1,752 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "StructuredCloneData.h"
+
+#include "DateInstance.h"
+#include "JSArrayBuffer.h"
+#include "JSCInlines.h"
+#include "ObjectConstructor.h"
+#include "PropertyNameArray.h"
+#include <wtf/HashMap.h>
+#include <wtf/text/StringHash.h>
+
+namespace JSC {
+
+static const uint8_t structuredCloneFormatVersion = 1;
+
+enum class StructuredCloneTag : uint8_t {
+    Undefined,
+    Null,
+    True,
+    False,
+    Int32,
+    Double,
+    String,
+    Object,
+    ShapedObject,
+    Array,
+    SparseArray,
+    Hole,
+    Date,
+    ArrayBuffer,
+    TransferredArrayBuffer,
+    ObjectReference,
+};
+
+class StructuredCloneSerializer {
+public:
+    StructuredCloneSerializer(ExecState* exec, const Vector<JSArrayBuffer*>& transferList, Vector<uint8_t>& data)
+        : m_exec(exec)
+        , m_vm(exec->vm())
+        , m_data(data)
+    {
+        for (unsigned i = 0; i < transferList.size(); ++i)
+            m_transferIndices.add(transferList[i], i);
+        m_data.append(structuredCloneFormatVersion);
+    }
+
+    bool serialize(JSValue);
+
+private:
+    static constexpr unsigned notShaped = std::numeric_limits<unsigned>::max();
+
+    void write(StructuredCloneTag tag) { m_data.append(static_cast<uint8_t>(tag)); }
+
+    void writeUnsigned(uint64_t value)
+    {
+        while (value >= 0x80) {
+            m_data.append(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        m_data.append(static_cast<uint8_t>(value));
+    }
+
+    void writeBytes(const void* bytes, size_t size)
+    {
+        m_data.append(static_cast<const uint8_t*>(bytes), size);
+    }
+
+    void writeDouble(double value) { writeBytes(&value, sizeof(value)); }
+
+    void writeString(const String&);
+    bool serializeObject(JSObject*);
+    bool serializeArray(JSArray*);
+    bool serializeShapedObject(JSObject*, unsigned shapeIndex, bool isNewShape);
+    bool serializeGenericObject(JSObject*);
+    unsigned shapeIndexFor(Structure*, bool& isNewShape);
+
+    struct Shape {
+        Vector<String> names;
+        Vector<PropertyOffset> offsets;
+    };
+
+    ExecState* m_exec;
+    VM& m_vm;
+    Vector<uint8_t>& m_data;
+    HashMap<JSArrayBuffer*, unsigned> m_transferIndices;
+    HashMap<String, unsigned> m_strings;
+    HashMap<JSObject*, unsigned> m_objects;
+    // Keeps every object we've seen alive, and with it every Structure in m_shapeIndices, in case
+    // a getter detaches it from the graph while we're still working.
+    MarkedArgumentBuffer m_visitedObjects;
+    HashMap<Structure*, unsigned> m_shapeIndices;
+    Vector<Shape> m_shapes;
+};
+
+void StructuredCloneSerializer::writeString(const String& string)
+{
+    auto addResult = m_strings.add(string, m_strings.size());
+    writeUnsigned(addResult.iterator->value);
+    if (!addResult.isNewEntry)
+        return;
+
+    // The first reference to a string carries its characters. Later ones are just the index.
+    writeUnsigned(string.length());
+    m_data.append(string.is8Bit());
+    if (string.is8Bit())
+        writeBytes(string.characters8(), string.length());
+    else
+        writeBytes(string.characters16(), string.length() * sizeof(UChar));
+}
+
+bool StructuredCloneSerializer::serialize(JSValue value)
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    if (value.isUndefined()) {
+        write(StructuredCloneTag::Undefined);
+        return true;
+    }
+    if (value.isNull()) {
+        write(StructuredCloneTag::Null);
+        return true;
+    }
+    if (value.isBoolean()) {
+        write(value.asBoolean() ? StructuredCloneTag::True : StructuredCloneTag::False);
+        return true;
+    }
+    if (value.isInt32()) {
+        write(StructuredCloneTag::Int32);
+        // Zig-zag encode so that small negative numbers stay small.
+        int32_t number = value.asInt32();
+        writeUnsigned((static_cast<uint32_t>(number) << 1) ^ static_cast<uint32_t>(number >> 31));
+        return true;
+    }
+    if (value.isNumber()) {
+        write(StructuredCloneTag::Double);
+        writeDouble(value.asNumber());
+        return true;
+    }
+    if (value.isString()) {
+        String string = asString(value)->value(m_exec);
+        RETURN_IF_EXCEPTION(scope, false);
+        write(StructuredCloneTag::String);
+        writeString(string);
+        return true;
+    }
+    if (value.isObject())
+        RELEASE_AND_RETURN(scope, serializeObject(asObject(value)));
+
+    throwTypeError(m_exec, scope, "Cannot clone a value of this type"_s);
+    return false;
+}
+
+bool StructuredCloneSerializer::serializeObject(JSObject* object)
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    auto iter = m_objects.find(object);
+    if (iter != m_objects.end()) {
+        write(StructuredCloneTag::ObjectReference);
+        writeUnsigned(iter->value);
+        return true;
+    }
+
+    if (UNLIKELY(!m_vm.isSafeToRecurseSoft())) {
+        throwStackOverflowError(m_exec, scope);
+        return false;
+    }
+
+    // Objects are numbered in the order we first see them, which is also the order in which the
+    // deserializer creates them, so cycles and shared references become back references.
+    m_objects.add(object, m_objects.size());
+    m_visitedObjects.append(object);
+    if (UNLIKELY(m_visitedObjects.hasOverflowed())) {
+        throwOutOfMemoryError(m_exec, scope);
+        return false;
+    }
+
+    if (isJSArray(object))
+        RELEASE_AND_RETURN(scope, serializeArray(asArray(object)));
+
+    if (DateInstance* date = jsDynamicCast<DateInstance*>(m_vm, object)) {
+        write(StructuredCloneTag::Date);
+        writeDouble(date->internalNumber());
+        return true;
+    }
+
+    if (JSArrayBuffer* arrayBuffer = jsDynamicCast<JSArrayBuffer*>(m_vm, object)) {
+        ArrayBuffer* impl = arrayBuffer->impl();
+        if (impl->isShared()) {
+            throwTypeError(m_exec, scope, "Cannot clone a SharedArrayBuffer"_s);
+            return false;
+        }
+        auto transferIter = m_transferIndices.find(arrayBuffer);
+        if (transferIter != m_transferIndices.end()) {
+            write(StructuredCloneTag::TransferredArrayBuffer);
+            writeUnsigned(transferIter->value);
+            return true;
+        }
+        if (impl->isNeutered()) {
+            throwTypeError(m_exec, scope, "Cannot clone a neutered ArrayBuffer"_s);
+            return false;
+        }
+        write(StructuredCloneTag::ArrayBuffer);
+        writeUnsigned(impl->byteLength());
+        writeBytes(impl->data(), impl->byteLength());
+        return true;
+    }
+
+    if (object->type() != FinalObjectType) {
+        throwTypeError(m_exec, scope, "Cannot clone an object of this type"_s);
+        return false;
+    }
+
+    bool isNewShape;
+    unsigned shapeIndex = shapeIndexFor(object->structure(m_vm), isNewShape);
+    if (shapeIndex != notShaped)
+        RELEASE_AND_RETURN(scope, serializeShapedObject(object, shapeIndex, isNewShape));
+    RELEASE_AND_RETURN(scope, serializeGenericObject(object));
+}
+
+unsigned StructuredCloneSerializer::shapeIndexFor(Structure* structure, bool& isNewShape)
+{
+    isNewShape = false;
+    auto addResult = m_shapeIndices.add(structure, notShaped);
+    if (!addResult.isNewEntry)
+        return addResult.iterator->value;
+
+    // A shape is only worth sharing when its own properties can be read straight out of the
+    // object's storage: no accessors, nothing hidden, no elements, and a stable property order.
+    if (structure->isDictionary()
+        || structure->hasGetterSetterProperties()
+        || structure->hasCustomGetterSetterProperties()
+        || hasIndexedProperties(structure->indexingType()))
+        return notShaped;
+
+    Shape shape;
+    bool isShapeable = true;
+    structure->forEachProperty(m_vm, [&] (const PropertyMapEntry& entry) -> bool {
+        if (entry.key->isSymbol() || (entry.attributes & PropertyAttribute::DontEnum)) {
+            isShapeable = false;
+            return false;
+        }
+        shape.names.append(String(entry.key));
+        shape.offsets.append(entry.offset);
+        return true;
+    });
+    if (!isShapeable)
+        return notShaped;
+
+    isNewShape = true;
+    addResult.iterator->value = m_shapes.size();
+    m_shapes.append(WTFMove(shape));
+    return addResult.iterator->value;
+}
+
+bool StructuredCloneSerializer::serializeShapedObject(JSObject* object, unsigned shapeIndex, bool isNewShape)
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    const Shape& shape = m_shapes[shapeIndex];
+
+    // The first object of a shape defines it. Later ones are the shape index and their values.
+    write(StructuredCloneTag::ShapedObject);
+    writeUnsigned(shapeIndex);
+    if (isNewShape) {
+        writeUnsigned(shape.names.size());
+        for (auto& name : shape.names)
+            writeString(name);
+    }
+
+    // Serializing a value can run getters elsewhere in the graph, which may reshape this object,
+    // so read all of its values before writing any of them.
+    MarkedArgumentBuffer values;
+    for (PropertyOffset offset : shape.offsets)
+        values.append(object->getDirect(offset));
+    if (UNLIKELY(values.hasOverflowed())) {
+        throwOutOfMemoryError(m_exec, scope);
+        return false;
+    }
+
+    for (unsigned i = 0; i < values.size(); ++i) {
+        bool success = serialize(values.at(i));
+        EXCEPTION_ASSERT(!scope.exception() == success);
+        if (!success)
+            return false;
+    }
+    return true;
+}
+
+bool StructuredCloneSerializer::serializeGenericObject(JSObject* object)
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    PropertyNameArray propertyNames(&m_vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
+    object->methodTable(m_vm)->getOwnPropertyNames(object, m_exec, propertyNames, EnumerationMode());
+    RETURN_IF_EXCEPTION(scope, false);
+
+    write(StructuredCloneTag::Object);
+    writeUnsigned(propertyNames.size());
+    for (auto& propertyName : propertyNames) {
+        JSValue value = object->get(m_exec, propertyName);
+        RETURN_IF_EXCEPTION(scope, false);
+        writeString(propertyName.string());
+        bool success = serialize(value);
+        EXCEPTION_ASSERT(!scope.exception() == success);
+        if (!success)
+            return false;
+    }
+    return true;
+}
+
+bool StructuredCloneSerializer::serializeArray(JSArray* array)
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    unsigned length = array->length();
+    if (!hasAnyArrayStorage(array->indexingType())) {
+        // Elements of a contiguous array are all in its vector, so anything we can't read from
+        // there is a hole.
+        write(StructuredCloneTag::Array);
+        writeUnsigned(length);
+        for (unsigned i = 0; i < length; ++i) {
+            if (!array->canGetIndexQuickly(i)) {
+                write(StructuredCloneTag::Hole);
+                continue;
+            }
+            bool success = serialize(array->getIndexQuickly(i));
+            EXCEPTION_ASSERT(!scope.exception() == success);
+            if (!success)
+                return false;
+        }
+        return true;
+    }
+
+    PropertyNameArray propertyNames(&m_vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
+    array->methodTable(m_vm)->getOwnPropertyNames(array, m_exec, propertyNames, EnumerationMode());
+    RETURN_IF_EXCEPTION(scope, false);
+
+    Vector<uint32_t> indices;
+    for (auto& propertyName : propertyNames) {
+        if (Optional<uint32_t> index = parseIndex(propertyName))
+            indices.append(*index);
+    }
+
+    write(StructuredCloneTag::SparseArray);
+    writeUnsigned(length);
+    writeUnsigned(indices.size());
+    for (uint32_t index : indices) {
+        JSValue value = array->get(m_exec, index);
+        RETURN_IF_EXCEPTION(scope, false);
+        writeUnsigned(index);
+        bool success = serialize(value);
+        EXCEPTION_ASSERT(!scope.exception() == success);
+        if (!success)
+            return false;
+    }
+    return true;
+}
+
+class StructuredCloneDeserializer {
+public:
+    StructuredCloneDeserializer(ExecState* exec, const Vector<uint8_t>& data, Vector<ArrayBufferContents>& transferredContents)
+        : m_exec(exec)
+        , m_vm(exec->vm())
+        , m_globalObject(exec->lexicalGlobalObject())
+        , m_cursor(data.data())
+        , m_end(data.data() + data.size())
+        , m_transferredContents(transferredContents)
+    {
+        RELEASE_ASSERT(readByte() == structuredCloneFormatVersion);
+    }
+
+    JSValue deserialize();
+
+private:
+    uint8_t readByte()
+    {
+        RELEASE_ASSERT(m_cursor < m_end);
+        return *m_cursor++;
+    }
+
+    uint64_t readUnsigned()
+    {
+        uint64_t result = 0;
+        for (unsigned shift = 0; ; shift += 7) {
+            uint8_t byte = readByte();
+            result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return result;
+        }
+    }
+
+    const uint8_t* readBytes(size_t size)
+    {
+        RELEASE_ASSERT(static_cast<size_t>(m_end - m_cursor) >= size);
+        const uint8_t* result = m_cursor;
+        m_cursor += size;
+        return result;
+    }
+
+    double readDouble()
+    {
+        double result;
+        memcpy(&result, readBytes(sizeof(result)), sizeof(result));
+        return result;
+    }
+
+    const String& readString();
+    JSValue deserializeShapedObject();
+    JSValue deserializeGenericObject();
+    JSValue deserializeArray(bool isSparse);
+    bool appendObject(JSObject*);
+
+    struct Shape {
+        Vector<Identifier> names;
+        // Set once the first object of the shape has been built, if the rest can be allocated
+        // with its Structure and filled in by offset.
+        Structure* structure { nullptr };
+        Vector<PropertyOffset> offsets;
+    };
+
+    ExecState* m_exec;
+    VM& m_vm;
+    JSGlobalObject* m_globalObject;
+    const uint8_t* m_cursor;
+    const uint8_t* m_end;
+    Vector<ArrayBufferContents>& m_transferredContents;
+    Vector<String> m_strings;
+    // Every object we've created, in creation order. This keeps them, and the Structures in
+    // m_shapes, alive until we return.
+    MarkedArgumentBuffer m_objects;
+    Vector<Shape> m_shapes;
+};
+
+const String& StructuredCloneDeserializer::readString()
+{
+    uint64_t index = readUnsigned();
+    if (index < m_strings.size())
+        return m_strings[index];
+    RELEASE_ASSERT(index == m_strings.size());
+
+    unsigned length = readUnsigned();
+    bool is8Bit = readByte();
+    if (is8Bit)
+        m_strings.append(String(readBytes(length), length));
+    else {
+        UChar* characters;
+        String string = String::createUninitialized(length, characters);
+        memcpy(characters, readBytes(length * sizeof(UChar)), length * sizeof(UChar));
+        m_strings.append(WTFMove(string));
+    }
+    return m_strings.last();
+}
+
+bool StructuredCloneDeserializer::appendObject(JSObject* object)
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+    m_objects.append(object);
+    if (UNLIKELY(m_objects.hasOverflowed())) {
+        throwOutOfMemoryError(m_exec, scope);
+        return false;
+    }
+    return true;
+}
+
+JSValue StructuredCloneDeserializer::deserialize()
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    if (UNLIKELY(!m_vm.isSafeToRecurseSoft())) {
+        throwStackOverflowError(m_exec, scope);
+        return { };
+    }
+
+    switch (static_cast<StructuredCloneTag>(readByte())) {
+    case StructuredCloneTag::Undefined:
+        return jsUndefined();
+    case StructuredCloneTag::Null:
+        return jsNull();
+    case StructuredCloneTag::True:
+        return jsBoolean(true);
+    case StructuredCloneTag::False:
+        return jsBoolean(false);
+    case StructuredCloneTag::Int32: {
+        uint32_t encoded = readUnsigned();
+        return jsNumber(static_cast<int32_t>((encoded >> 1) ^ -(encoded & 1)));
+    }
+    case StructuredCloneTag::Double:
+        return jsNumber(readDouble());
+    case StructuredCloneTag::String:
+        return jsString(&m_vm, readString());
+    case StructuredCloneTag::Object:
+        RELEASE_AND_RETURN(scope, deserializeGenericObject());
+    case StructuredCloneTag::ShapedObject:
+        RELEASE_AND_RETURN(scope, deserializeShapedObject());
+    case StructuredCloneTag::Array:
+        RELEASE_AND_RETURN(scope, deserializeArray(false));
+    case StructuredCloneTag::SparseArray:
+        RELEASE_AND_RETURN(scope, deserializeArray(true));
+    case StructuredCloneTag::Date: {
+        DateInstance* date = DateInstance::create(m_vm, m_globalObject->dateStructure(), readDouble());
+        if (!appendObject(date))
+            return { };
+        return date;
+    }
+    case StructuredCloneTag::ArrayBuffer: {
+        unsigned byteLength = readUnsigned();
+        RefPtr<ArrayBuffer> buffer = ArrayBuffer::tryCreate(readBytes(byteLength), byteLength);
+        if (!buffer) {
+            throwOutOfMemoryError(m_exec, scope);
+            return { };
+        }
+        JSArrayBuffer* result = JSArrayBuffer::create(m_vm, m_globalObject->arrayBufferStructure(ArrayBufferSharingMode::Default), WTFMove(buffer));
+        if (!appendObject(result))
+            return { };
+        return result;
+    }
+    case StructuredCloneTag::TransferredArrayBuffer: {
+        uint64_t index = readUnsigned();
+        RELEASE_ASSERT(index < m_transferredContents.size());
+        Ref<ArrayBuffer> buffer = ArrayBuffer::create(WTFMove(m_transferredContents[index]));
+        JSArrayBuffer* result = JSArrayBuffer::create(m_vm, m_globalObject->arrayBufferStructure(ArrayBufferSharingMode::Default), WTFMove(buffer));
+        if (!appendObject(result))
+            return { };
+        return result;
+    }
+    case StructuredCloneTag::ObjectReference: {
+        uint64_t index = readUnsigned();
+        RELEASE_ASSERT(index < static_cast<uint64_t>(m_objects.size()));
+        return m_objects.at(index);
+    }
+    case StructuredCloneTag::Hole:
+        break;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return { };
+}
+
+JSValue StructuredCloneDeserializer::deserializeShapedObject()
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    uint64_t shapeIndex = readUnsigned();
+    if (shapeIndex == m_shapes.size()) {
+        Shape shape;
+        unsigned propertyCount = readUnsigned();
+        shape.names.reserveInitialCapacity(propertyCount);
+        for (unsigned i = 0; i < propertyCount; ++i)
+            shape.names.uncheckedAppend(Identifier::fromString(&m_vm, readString()));
+        m_shapes.append(WTFMove(shape));
+    }
+    RELEASE_ASSERT(shapeIndex < m_shapes.size());
+
+    // Values may refer back to this object, so it has to exist before we read them.
+    if (Structure* structure = m_shapes[shapeIndex].structure) {
+        JSFinalObject* object = JSFinalObject::create(m_vm, structure);
+        if (!appendObject(object))
+            return { };
+        for (PropertyOffset offset : m_shapes[shapeIndex].offsets) {
+            JSValue value = deserialize();
+            RETURN_IF_EXCEPTION(scope, { });
+            object->putDirect(m_vm, offset, value);
+        }
+        return object;
+    }
+
+    JSObject* object = constructEmptyObject(m_exec);
+    if (!appendObject(object))
+        return { };
+    for (unsigned i = 0; i < m_shapes[shapeIndex].names.size(); ++i) {
+        JSValue value = deserialize();
+        RETURN_IF_EXCEPTION(scope, { });
+        object->putDirect(m_vm, m_shapes[shapeIndex].names[i], value);
+    }
+
+    // Building the first object walked the transition chain to the Structure every other object
+    // of this shape will use. If their properties all fit inline, the rest skip the transitions.
+    Structure* structure = object->structure(m_vm);
+    if (!structure->isDictionary() && !structure->outOfLineCapacity()) {
+        Shape& shape = m_shapes[shapeIndex];
+        shape.offsets.reserveInitialCapacity(shape.names.size());
+        for (auto& name : shape.names)
+            shape.offsets.uncheckedAppend(structure->get(m_vm, name));
+        shape.structure = structure;
+    }
+    return object;
+}
+
+JSValue StructuredCloneDeserializer::deserializeGenericObject()
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    JSObject* object = constructEmptyObject(m_exec);
+    if (!appendObject(object))
+        return { };
+
+    unsigned propertyCount = readUnsigned();
+    for (unsigned i = 0; i < propertyCount; ++i) {
+        Identifier name = Identifier::fromString(&m_vm, readString());
+        JSValue value = deserialize();
+        RETURN_IF_EXCEPTION(scope, { });
+        object->putDirectMayBeIndex(m_exec, name, value);
+        RETURN_IF_EXCEPTION(scope, { });
+    }
+    return object;
+}
+
+JSValue StructuredCloneDeserializer::deserializeArray(bool isSparse)
+{
+    auto scope = DECLARE_THROW_SCOPE(m_vm);
+
+    unsigned length = readUnsigned();
+    JSArray* array = constructEmptyArray(m_exec, nullptr);
+    RETURN_IF_EXCEPTION(scope, { });
+    if (!appendObject(array))
+        return { };
+
+    if (isSparse) {
+        unsigned elementCount = readUnsigned();
+        for (unsigned i = 0; i < elementCount; ++i) {
+            unsigned index = readUnsigned();
+            JSValue value = deserialize();
+            RETURN_IF_EXCEPTION(scope, { });
+            array->putDirectIndex(m_exec, index, value);
+            RETURN_IF_EXCEPTION(scope, { });
+        }
+    } else {
+        for (unsigned i = 0; i < length; ++i) {
+            if (m_cursor < m_end && *m_cursor == static_cast<uint8_t>(StructuredCloneTag::Hole)) {
+                ++m_cursor;
+                continue;
+            }
+            JSValue value = deserialize();
+            RETURN_IF_EXCEPTION(scope, { });
+            array->putDirectIndex(m_exec, i, value);
+            RETURN_IF_EXCEPTION(scope, { });
+        }
+    }
+
+    // Trailing holes aren't covered by the stores above.
+    array->setLength(m_exec, length, true);
+    RETURN_IF_EXCEPTION(scope, { });
+    return array;
+}
+
+RefPtr<StructuredCloneData> StructuredCloneData::serialize(ExecState* exec, JSValue value, const Vector<JSArrayBuffer*>& transferList)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    for (unsigned i = 0; i < transferList.size(); ++i) {
+        ArrayBuffer* impl = transferList[i]->impl();
+        if (impl->isShared() || impl->isNeutered()) {
+            throwTypeError(exec, scope, "Cannot transfer a shared or neutered ArrayBuffer"_s);
+            return nullptr;
+        }
+        for (unsigned j = 0; j < i; ++j) {
+            if (transferList[j] == transferList[i]) {
+                throwTypeError(exec, scope, "An ArrayBuffer appears more than once in the transfer list"_s);
+                return nullptr;
+            }
+        }
+    }
+
+    RefPtr<StructuredCloneData> result = adoptRef(new StructuredCloneData);
+    bool success = StructuredCloneSerializer(exec, transferList, result->m_data).serialize(value);
+    EXCEPTION_ASSERT(!scope.exception() == success);
+    if (!success)
+        return nullptr;
+    result->m_data.shrinkToFit();
+
+    // Only neuter the transferred buffers once we know the clone succeeded, and then neuter all of them
+    // or none. A getter that ran during serialization may have neutered a buffer since the check above.
+    for (JSArrayBuffer* arrayBuffer : transferList) {
+        ArrayBuffer* impl = arrayBuffer->impl();
+        if (impl->isShared() || impl->isNeutered()) {
+            throwTypeError(exec, scope, "Cannot transfer a shared or neutered ArrayBuffer"_s);
+            return nullptr;
+        }
+    }
+
+    // Buffers that cannot be neutered are transferred by copying, which may fail, so copy them before
+    // neutering anything. Transferring the remaining buffers cannot fail.
+    result->m_transferredContents.grow(transferList.size());
+    for (unsigned i = 0; i < transferList.size(); ++i) {
+        ArrayBuffer* impl = transferList[i]->impl();
+        if (impl->isNeuterable())
+            continue;
+        if (!impl->transferTo(vm, result->m_transferredContents[i])) {
+            throwOutOfMemoryError(exec, scope);
+            return nullptr;
+        }
+    }
+    for (unsigned i = 0; i < transferList.size(); ++i) {
+        ArrayBuffer* impl = transferList[i]->impl();
+        if (!impl->isNeuterable())
+            continue;
+        bool transferred = impl->transferTo(vm, result->m_transferredContents[i]);
+        RELEASE_ASSERT(transferred);
+    }
+    return result;
+}
+
+StructuredCloneData::~StructuredCloneData() = default;
+
+JSValue StructuredCloneData::deserialize(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    Vector<ArrayBufferContents> transferredContents;
+    {
+        auto locker = holdLock(m_transferredContentsLock);
+        if (m_transferredContentsConsumed) {
+            throwTypeError(exec, scope, "A clone with transferred ArrayBuffers can only be deserialized once"_s);
+            return { };
+        }
+        if (!m_transferredContents.isEmpty()) {
+            transferredContents = WTFMove(m_transferredContents);
+            m_transferredContentsConsumed = true;
+        }
+    }
+
+    RELEASE_AND_RETURN(scope, StructuredCloneDeserializer(exec, m_data, transferredContents).deserialize());
+}
+
+} // namespace JSC
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include "ArrayBuffer.h"
+#include <wtf/Lock.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class ExecState;
+class JSArrayBuffer;
+class JSValue;
+
+// A structured clone of a JS value, flattened into a buffer that doesn't reference any cells, so
+// it can be materialized in a different VM (and on a different thread) than the one it came from.
+//
+// Strings are written once and referred to by index afterwards. Plain objects that share a
+// Structure write their property names once, and every later object of that shape is just a
+// list of values. When deserialized, those objects are rebuilt with a single shared Structure.
+// ArrayBuffers in the transfer list are neutered and their contents move into the clone
+// without being copied; they can only be materialized once.
+class StructuredCloneData : public ThreadSafeRefCounted<StructuredCloneData> {
+public:
+    // Returns nullptr and throws if the value can't be cloned.
+    JS_EXPORT_PRIVATE static RefPtr<StructuredCloneData> serialize(ExecState*, JSValue, const Vector<JSArrayBuffer*>& transferList);
+
+    JS_EXPORT_PRIVATE ~StructuredCloneData();
+
+    // Returns the empty value and throws on failure.
+    JS_EXPORT_PRIVATE JSValue deserialize(ExecState*);
+
+    size_t sizeInBytes() const { return m_data.size(); }
+
+private:
+    StructuredCloneData() = default;
+
+    Vector<uint8_t> m_data;
+    Lock m_transferredContentsLock;
+    Vector<ArrayBufferContents> m_transferredContents;
+    bool m_transferredContentsConsumed { false };
+};
+
+} // namespace JSC
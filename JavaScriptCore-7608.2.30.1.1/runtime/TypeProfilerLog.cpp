@@ -40,12 +40,14 @@ namespace TypeProfilerLogInternal {
 static const bool verbose = false;
 }
 
-TypeProfilerLog::TypeProfilerLog(VM& vm)
+TypeProfilerLog::TypeProfilerLog(VM& vm, unsigned samplingInterval)
     : m_vm(vm)
-    , m_logSize(50000)
+    , m_logSize(std::max(1u, Options::typeProfilerLogSize()))
     , m_logStartPtr(new LogEntry[m_logSize])
     , m_currentLogEntryPtr(m_logStartPtr)
     , m_logEndPtr(m_logStartPtr + m_logSize)
+    , m_samplingInterval(std::max(1u, samplingInterval))
+    , m_samplingCountdown(m_samplingInterval)
 {
     ASSERT(m_logStartPtr);
 }
@@ -126,6 +128,21 @@ void TypeProfilerLog::processLogEntries(VM& vm, const String& reason)
     }
 }
 
+void TypeProfilerLog::recordEvent(TypeLocation* location, JSValue value)
+{
+    if (!value)
+        return;
+
+    LogEntry* entry = m_currentLogEntryPtr;
+    entry->value = value;
+    entry->location = location;
+    entry->structureID = value.isCell() ? value.asCell()->structureID() : 0;
+
+    m_currentLogEntryPtr = entry + 1;
+    if (m_currentLogEntryPtr == m_logEndPtr)
+        processLogEntries(m_vm, "Log Full"_s);
+}
+
 void TypeProfilerLog::visit(SlotVisitor& visitor)
 {
     for (LogEntry* entry = m_logStartPtr; entry != m_currentLogEntryPtr; ++entry) {
@@ -53,7 +53,7 @@ public:
     };
 
 
-    TypeProfilerLog(VM&);
+    TypeProfilerLog(VM&, unsigned samplingInterval);
     ~TypeProfilerLog();
 
     JS_EXPORT_PRIVATE void processLogEntries(VM&, const String&);
@@ -63,6 +63,18 @@ public:
 
     static ptrdiff_t logStartOffset() { return OBJECT_OFFSETOF(TypeProfilerLog, m_logStartPtr); }
     static ptrdiff_t currentLogEntryOffset() { return OBJECT_OFFSETOF(TypeProfilerLog, m_currentLogEntryPtr); }
+    static ptrdiff_t samplingCountdownOffset() { return OBJECT_OFFSETOF(TypeProfilerLog, m_samplingCountdown); }
+
+    // In sampled mode only one in every samplingInterval() events that reach the log is
+    // recorded. This keeps the profiler cheap enough to leave the optimizing tiers enabled.
+    bool isSampling() const { return m_samplingInterval > 1; }
+    unsigned samplingInterval() const { return m_samplingInterval; }
+
+    int32_t* addressOfSamplingCountdown() { return &m_samplingCountdown; }
+
+    // Writes a single entry, processing the log if that fills it up. Used by code that does
+    // not write the log inline. Callers are responsible for sampling.
+    void recordEvent(TypeLocation*, JSValue);
 
 private:
     friend class LLIntOffsetsExtractor;
@@ -72,6 +84,8 @@ private:
     LogEntry* m_logStartPtr;
     LogEntry* m_currentLogEntryPtr;
     LogEntry* m_logEndPtr;
+    unsigned m_samplingInterval;
+    int32_t m_samplingCountdown;
 };
 
 } // namespace JSC
@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2019 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <wtf/NotFound.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
+
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
+namespace JSC {
+
+// Bulk kernels behind %TypedArray%.prototype.fill, indexOf, includes and the default sort. They
+// work on raw element storage, so callers must have already checked that the view is not neutered
+// and that the range is in bounds.
+
+// TypedArraySIMDLane<T>::blockContains() tells whether any of the next elementsPerBlock elements
+// compares equal to value. Float comparisons follow IEEE semantics, like the scalar loops: NaN
+// never matches and -0 matches +0.
+template<typename T, size_t size = sizeof(T), bool isFloatingPoint = std::is_floating_point<T>::value>
+struct TypedArraySIMDLane {
+    static constexpr bool isSupported = false;
+    static constexpr size_t elementsPerBlock = 1;
+    static bool blockContains(const T*, T) { return false; }
+    static bool blockContainsNaN(const T*) { return false; }
+};
+
+#if CPU(X86_SSE2) || HAVE(ARM_NEON_INTRINSICS)
+
+#if CPU(X86_SSE2)
+#define TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(loadAndCompare) \
+    return _mm_movemask_epi8(loadAndCompare)
+#else
+#define TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(loadAndCompare) \
+    uint64x2_t mask = vreinterpretq_u64_u8(loadAndCompare); \
+    return vgetq_lane_u64(mask, 0) | vgetq_lane_u64(mask, 1)
+#endif
+
+template<typename T>
+struct TypedArraySIMDLane<T, 1, false> {
+    static constexpr bool isSupported = true;
+    static constexpr size_t elementsPerBlock = 16;
+    static bool blockContains(const T* block, T value)
+    {
+#if CPU(X86_SSE2)
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), _mm_set1_epi8(static_cast<char>(value))));
+#else
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(block)), vdupq_n_u8(static_cast<uint8_t>(value))));
+#endif
+    }
+    static bool blockContainsNaN(const T*) { return false; }
+};
+
+template<typename T>
+struct TypedArraySIMDLane<T, 2, false> {
+    static constexpr bool isSupported = true;
+    static constexpr size_t elementsPerBlock = 8;
+    static bool blockContains(const T* block, T value)
+    {
+#if CPU(X86_SSE2)
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(_mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), _mm_set1_epi16(static_cast<short>(value))));
+#else
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(vreinterpretq_u8_u16(vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(block)), vdupq_n_u16(static_cast<uint16_t>(value)))));
+#endif
+    }
+    static bool blockContainsNaN(const T*) { return false; }
+};
+
+template<typename T>
+struct TypedArraySIMDLane<T, 4, false> {
+    static constexpr bool isSupported = true;
+    static constexpr size_t elementsPerBlock = 4;
+    static bool blockContains(const T* block, T value)
+    {
+#if CPU(X86_SSE2)
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), _mm_set1_epi32(static_cast<int>(value))));
+#else
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(vreinterpretq_u8_u32(vceqq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(block)), vdupq_n_u32(static_cast<uint32_t>(value)))));
+#endif
+    }
+    static bool blockContainsNaN(const T*) { return false; }
+};
+
+template<>
+struct TypedArraySIMDLane<float, 4, true> {
+    static constexpr bool isSupported = true;
+    static constexpr size_t elementsPerBlock = 4;
+    static bool blockContains(const float* block, float value)
+    {
+#if CPU(X86_SSE2)
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(_mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(block), _mm_set1_ps(value))));
+#else
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(vreinterpretq_u8_u32(vceqq_f32(vld1q_f32(block), vdupq_n_f32(value))));
+#endif
+    }
+    static bool blockContainsNaN(const float* block)
+    {
+#if CPU(X86_SSE2)
+        __m128 vector = _mm_loadu_ps(block);
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(_mm_castps_si128(_mm_cmpunord_ps(vector, vector)));
+#else
+        float32x4_t vector = vld1q_f32(block);
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(vreinterpretq_u8_u32(vmvnq_u32(vceqq_f32(vector, vector))));
+#endif
+    }
+};
+
+#if CPU(X86_SSE2) || CPU(ARM64)
+template<>
+struct TypedArraySIMDLane<double, 8, true> {
+    static constexpr bool isSupported = true;
+    static constexpr size_t elementsPerBlock = 2;
+    static bool blockContains(const double* block, double value)
+    {
+#if CPU(X86_SSE2)
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(_mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(block), _mm_set1_pd(value))));
+#else
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(vreinterpretq_u8_u64(vceqq_f64(vld1q_f64(block), vdupq_n_f64(value))));
+#endif
+    }
+    static bool blockContainsNaN(const double* block)
+    {
+#if CPU(X86_SSE2)
+        __m128d vector = _mm_loadu_pd(block);
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(_mm_castpd_si128(_mm_cmpunord_pd(vector, vector)));
+#else
+        float64x2_t vector = vld1q_f64(block);
+        TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS(vmvnq_u8(vreinterpretq_u8_u64(vceqq_f64(vector, vector))));
+#endif
+    }
+};
+#endif
+
+#undef TYPED_ARRAY_SIMD_LANE_BLOCK_CONTAINS
+
+#endif // CPU(X86_SSE2) || HAVE(ARM_NEON_INTRINSICS)
+
+template<typename T>
+inline void typedArrayFill(T* array, T value, size_t length)
+{
+    size_t i = 0;
+#if CPU(X86_SSE2) || HAVE(ARM_NEON_INTRINSICS)
+    // Splatting through memory works for every element type, including floats whose bit pattern we
+    // must preserve exactly (e.g. a NaN payload written by fill() must read back as the same NaN).
+    constexpr size_t elementsPerVector = 16 / sizeof(T);
+    if (length >= elementsPerVector) {
+        T lanes[elementsPerVector];
+        std::fill_n(lanes, elementsPerVector, value);
+#if CPU(X86_SSE2)
+        __m128i pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+        for (; i + elementsPerVector <= length; i += elementsPerVector)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(array + i), pattern);
+#else
+        uint8x16_t pattern = vld1q_u8(reinterpret_cast<const uint8_t*>(lanes));
+        for (; i + elementsPerVector <= length; i += elementsPerVector)
+            vst1q_u8(reinterpret_cast<uint8_t*>(array + i), pattern);
+#endif
+    }
+#endif
+    for (; i < length; ++i)
+        array[i] = value;
+}
+
+// Returns the index of the first element in [start, length) that compares equal to value, or notFound.
+template<typename T>
+inline size_t typedArrayFind(const T* array, T value, size_t start, size_t length)
+{
+    using Lane = TypedArraySIMDLane<T>;
+    size_t i = start;
+    if (Lane::isSupported) {
+        for (; i + Lane::elementsPerBlock <= length; i += Lane::elementsPerBlock) {
+            if (Lane::blockContains(array + i, value))
+                break;
+        }
+    }
+    for (; i < length; ++i) {
+        if (array[i] == value)
+            return i;
+    }
+    return notFound;
+}
+
+// Returns the index of the first NaN in [start, length), or notFound.
+template<typename T>
+inline size_t typedArrayFindNaN(const T* array, size_t start, size_t length)
+{
+    if (!std::is_floating_point<T>::value)
+        return notFound;
+
+    using Lane = TypedArraySIMDLane<T>;
+    size_t i = start;
+    if (Lane::isSupported) {
+        for (; i + Lane::elementsPerBlock <= length; i += Lane::elementsPerBlock) {
+            if (Lane::blockContainsNaN(array + i))
+                break;
+        }
+    }
+    for (; i < length; ++i) {
+        if (std::isnan(static_cast<double>(array[i])))
+            return i;
+    }
+    return notFound;
+}
+
+// Below this length the constant cost of the counting passes outweighs std::sort's n log n.
+static constexpr size_t minLengthForTypedArrayRadixSort = 256;
+
+// LSD radix sort on 8-bit digits. Passes in which every key has the same digit are skipped, which
+// makes sorting small values stored in wide elements (a common case for Int32Array) cheap.
+template<typename UnsignedType>
+inline void typedArrayRadixSort(UnsignedType* array, size_t length)
+{
+    static_assert(std::is_unsigned<UnsignedType>::value, "radix sort keys must be unsigned");
+
+    if (sizeof(UnsignedType) == 1) {
+        size_t counts[256] = { };
+        for (size_t i = 0; i < length; ++i)
+            ++counts[array[i]];
+        UnsignedType* position = array;
+        for (unsigned digit = 0; digit < 256; ++digit) {
+            std::fill_n(position, counts[digit], static_cast<UnsignedType>(digit));
+            position += counts[digit];
+        }
+        return;
+    }
+
+    Vector<UnsignedType> scratch;
+    if (!scratch.tryReserveCapacity(length)) {
+        std::sort(array, array + length);
+        return;
+    }
+    scratch.grow(length);
+
+    UnsignedType* source = array;
+    UnsignedType* destination = scratch.data();
+    for (unsigned shift = 0; shift < sizeof(UnsignedType) * 8; shift += 8) {
+        size_t counts[256] = { };
+        for (size_t i = 0; i < length; ++i)
+            ++counts[(source[i] >> shift) & 0xff];
+
+        if (counts[(source[0] >> shift) & 0xff] == length)
+            continue;
+
+        size_t offset = 0;
+        for (unsigned digit = 0; digit < 256; ++digit) {
+            size_t count = counts[digit];
+            counts[digit] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < length; ++i)
+            destination[counts[(source[i] >> shift) & 0xff]++] = source[i];
+        std::swap(source, destination);
+    }
+
+    if (source != array)
+        std::copy(source, source + length, array);
+}
+
+// Sorts integer elements in numeric order by radix sorting them as unsigned keys. Flipping the sign
+// bit maps two's complement order onto unsigned order.
+template<typename T>
+inline void typedArraySortIntegers(T* array, size_t length)
+{
+    static_assert(std::is_integral<T>::value, "expected integer elements");
+    if (length < minLengthForTypedArrayRadixSort) {
+        std::sort(array, array + length);
+        return;
+    }
+
+    using UnsignedType = typename std::make_unsigned<T>::type;
+    UnsignedType* keys = reinterpret_cast_ptr<UnsignedType*>(array);
+    if (std::is_signed<T>::value) {
+        constexpr UnsignedType signBit = static_cast<UnsignedType>(1) << (sizeof(T) * 8 - 1);
+        for (size_t i = 0; i < length; ++i)
+            keys[i] ^= signBit;
+        typedArrayRadixSort(keys, length);
+        for (size_t i = 0; i < length; ++i)
+            keys[i] ^= signBit;
+        return;
+    }
+    typedArrayRadixSort(keys, length);
+}
+
+// Sorts the bit patterns of floats, viewed as IntegralType, in the order described in
+// JSGenericTypedArrayView. NaNs must already have been purified. For the radix sort,
+// negative values get all their bits flipped and the others get their sign bit set, which turns
+// that order into plain unsigned order.
+template<typename IntegralType>
+inline void typedArraySortFloatBits(IntegralType* array, size_t length)
+{
+    if (length < minLengthForTypedArrayRadixSort) {
+        std::sort(array, array + length, [] (IntegralType a, IntegralType b) {
+            if (a >= 0 || b >= 0)
+                return a < b;
+            return a > b;
+        });
+        return;
+    }
+
+    using UnsignedType = typename std::make_unsigned<IntegralType>::type;
+    constexpr UnsignedType signBit = static_cast<UnsignedType>(1) << (sizeof(IntegralType) * 8 - 1);
+    UnsignedType* keys = reinterpret_cast_ptr<UnsignedType*>(array);
+    for (size_t i = 0; i < length; ++i)
+        keys[i] = (keys[i] & signBit) ? ~keys[i] : (keys[i] | signBit);
+    typedArrayRadixSort(keys, length);
+    for (size_t i = 0; i < length; ++i)
+        keys[i] = (keys[i] & signBit) ? (keys[i] & ~signBit) : ~keys[i];
+}
+
+} // namespace JSC
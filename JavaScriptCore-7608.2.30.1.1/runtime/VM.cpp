@@ -29,6 +29,7 @@
 #include "config.h"
 #include "VM.h"
 
+#include "AllocationSiteProfiler.h"
 #include "ArgList.h"
 #include "ArrayBufferNeuteringWatchpointSet.h"
 #include "BuiltinExecutables.h"
@@ -67,6 +68,7 @@
 #include "Interpreter.h"
 #include "IntlCollatorConstructor.h"
 #include "IntlDateTimeFormatConstructor.h"
+#include "IntlFormatterCache.h"
 #include "IntlNumberFormatConstructor.h"
 #include "IntlPluralRulesConstructor.h"
 #include "JITCode.h"
@@ -312,7 +314,7 @@ VM::VM(VMType vmType, HeapType heapType)
     , m_initializingObjectClass(0)
 #endif
     , m_stackPointerAtVMEntry(0)
-    , m_codeCache(std::make_unique<CodeCache>())
+    , m_codeCache(std::make_unique<CodeCache>(*this))
     , m_builtinExecutables(std::make_unique<BuiltinExecutables>(*this))
     , m_typeProfilerEnabledCount(0)
     , m_primitiveGigacageEnabled(IsWatched)
@@ -441,6 +443,9 @@ VM::VM(VMType vmType, HeapType heapType)
     }
 #endif // ENABLE(SAMPLING_PROFILER)
 
+    if (Options::useAllocationSiteProfiler())
+        ensureAllocationSiteProfiler(Options::allocationSiteProfilerSamplingInterval());
+
     if (Options::useRandomizingFuzzerAgent())
         setFuzzerAgent(std::make_unique<RandomizingFuzzerAgent>(*this));
     else if (Options::useDoublePredictionFuzzerAgent())
@@ -623,6 +628,18 @@ HeapProfiler& VM::ensureHeapProfiler()
     return *m_heapProfiler;
 }
 
+AllocationSiteProfiler& VM::ensureAllocationSiteProfiler(size_t samplingInterval)
+{
+    if (!m_allocationSiteProfiler)
+        m_allocationSiteProfiler = std::make_unique<AllocationSiteProfiler>(*this, samplingInterval);
+    return *m_allocationSiteProfiler;
+}
+
+void VM::disableAllocationSiteProfiler()
+{
+    m_allocationSiteProfiler = nullptr;
+}
+
 #if ENABLE(SAMPLING_PROFILER)
 SamplingProfiler& VM::ensureSamplingProfiler(RefPtr<Stopwatch>&& stopwatch)
 {
@@ -767,11 +784,24 @@ void VM::deleteAllCode(DeleteAllCodeEffort effort)
     });
 }
 
+#if ENABLE(INTL)
+IntlFormatterCache& VM::intlFormatterCache()
+{
+    if (UNLIKELY(!m_intlFormatterCache))
+        m_intlFormatterCache = std::make_unique<IntlFormatterCache>();
+    return *m_intlFormatterCache;
+}
+#endif
+
 void VM::shrinkFootprintWhenIdle()
 {
     whenIdle([=] () {
         sanitizeStackForVM(this);
         deleteAllCode(DeleteAllCodeIfNotCollecting);
+#if ENABLE(INTL)
+        if (m_intlFormatterCache)
+            m_intlFormatterCache->clear();
+#endif
         heap.collectNow(Synchronousness::Sync, CollectionScope::Full);
         // FIXME: Consider stopping various automatic threads here.
         // https://bugs.webkit.org/show_bug.cgi?id=185447
@@ -1039,9 +1069,14 @@ static bool disableProfilerWithRespectToCount(unsigned& counter, const Func& doD
 
 bool VM::enableTypeProfiler()
 {
-    auto enableTypeProfiler = [this] () {
+    return enableTypeProfiler(Options::typeProfilerSamplingInterval());
+}
+
+bool VM::enableTypeProfiler(unsigned samplingInterval)
+{
+    auto enableTypeProfiler = [this, samplingInterval] () {
         this->m_typeProfiler = std::make_unique<TypeProfiler>();
-        this->m_typeProfilerLog = std::make_unique<TypeProfilerLog>(*this);
+        this->m_typeProfilerLog = std::make_unique<TypeProfilerLog>(*this, samplingInterval);
     };
 
     return enableProfilerWithRespectToCount(m_typeProfilerEnabledCount, enableTypeProfiler);
@@ -1086,22 +1121,18 @@ void VM::dumpTypeProfilerData()
 
 void VM::queueMicrotask(JSGlobalObject& globalObject, Ref<Microtask>&& task)
 {
-    m_microtaskQueue.append(std::make_unique<QueuedTask>(*this, &globalObject, WTFMove(task)));
+    m_microtaskQueue.enqueue(globalObject, WTFMove(task));
 }
 
-void VM::drainMicrotasks()
+void VM::queueMicrotask(JSGlobalObject& globalObject, JSValue job, const JSValue* arguments, unsigned argumentCount)
 {
-    while (!m_microtaskQueue.isEmpty()) {
-        m_microtaskQueue.takeFirst()->run();
-        if (m_onEachMicrotaskTick)
-            m_onEachMicrotaskTick(*this);
-    }
-    finalizeSynchronousJSExecution();
+    m_microtaskQueue.enqueue(globalObject, job, arguments, argumentCount);
 }
 
-void QueuedTask::run()
+void VM::drainMicrotasks()
 {
-    m_microtask->run(m_globalObject->globalExec());
+    m_microtaskQueue.drain(*this, m_onEachMicrotaskTick);
+    finalizeSynchronousJSExecution();
 }
 
 void sanitizeStackForVM(VM* vm)
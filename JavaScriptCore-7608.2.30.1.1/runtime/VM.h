@@ -48,6 +48,7 @@
 #include "JSLock.h"
 #include "MacroAssemblerCodeRef.h"
 #include "Microtask.h"
+#include "MicrotaskQueue.h"
 #include "NumericStrings.h"
 #include "SmallStrings.h"
 #include "Strong.h"
@@ -99,6 +100,7 @@ using WTF::SimpleStats;
 
 namespace JSC {
 
+class AllocationSiteProfiler;
 class BuiltinExecutables;
 class BytecodeIntrinsicRegistry;
 class CodeBlock;
@@ -116,6 +118,9 @@ class HandleStack;
 class TypeProfiler;
 class TypeProfilerLog;
 class HasOwnPropertyCache;
+#if ENABLE(INTL)
+class IntlFormatterCache;
+#endif
 class HeapProfiler;
 class Identifier;
 class Interpreter;
@@ -204,23 +209,6 @@ struct LocalTimeOffsetCache {
     WTF::TimeType timeType;
 };
 
-class QueuedTask {
-    WTF_MAKE_NONCOPYABLE(QueuedTask);
-    WTF_MAKE_FAST_ALLOCATED;
-public:
-    void run();
-
-    QueuedTask(VM& vm, JSGlobalObject* globalObject, Ref<Microtask>&& microtask)
-        : m_globalObject(vm, globalObject)
-        , m_microtask(WTFMove(microtask))
-    {
-    }
-
-private:
-    Strong<JSGlobalObject> m_globalObject;
-    Ref<Microtask> m_microtask;
-};
-
 class ConservativeRoots;
 
 #if COMPILER(MSVC)
@@ -291,6 +279,10 @@ public:
     HeapProfiler* heapProfiler() const { return m_heapProfiler.get(); }
     JS_EXPORT_PRIVATE HeapProfiler& ensureHeapProfiler();
 
+    AllocationSiteProfiler* allocationSiteProfiler() const { return m_allocationSiteProfiler.get(); }
+    JS_EXPORT_PRIVATE AllocationSiteProfiler& ensureAllocationSiteProfiler(size_t samplingInterval);
+    JS_EXPORT_PRIVATE void disableAllocationSiteProfiler();
+
 #if ENABLE(SAMPLING_PROFILER)
     SamplingProfiler* samplingProfiler() { return m_samplingProfiler.get(); }
     JS_EXPORT_PRIVATE SamplingProfiler& ensureSamplingProfiler(RefPtr<Stopwatch>&&);
@@ -828,6 +820,10 @@ public:
     ALWAYS_INLINE HasOwnPropertyCache* hasOwnPropertyCache() { return m_hasOwnPropertyCache.get(); }
     HasOwnPropertyCache* ensureHasOwnPropertyCache();
 
+#if ENABLE(INTL)
+    IntlFormatterCache& intlFormatterCache();
+#endif
+
 #if ENABLE(REGEXP_TRACING)
     typedef ListHashSet<RegExp*> RTTraceList;
     RTTraceList* m_rtTraceList;
@@ -871,6 +867,9 @@ public:
     BuiltinExecutables* builtinExecutables() { return m_builtinExecutables.get(); }
 
     bool enableTypeProfiler();
+    // Like enableTypeProfiler(), but samples with the given interval rather than
+    // Options::typeProfilerSamplingInterval(). The interval is ignored if the profiler is already on.
+    JS_EXPORT_PRIVATE bool enableTypeProfiler(unsigned samplingInterval);
     bool disableTypeProfiler();
     TypeProfilerLog* typeProfilerLog() { return m_typeProfilerLog.get(); }
     TypeProfiler* typeProfiler() { return m_typeProfiler.get(); }
@@ -883,7 +882,9 @@ public:
     bool disableControlFlowProfiler();
 
     void queueMicrotask(JSGlobalObject&, Ref<Microtask>&&);
+    void queueMicrotask(JSGlobalObject&, JSValue job, const JSValue* arguments, unsigned argumentCount);
     JS_EXPORT_PRIVATE void drainMicrotasks();
+    MicrotaskQueue& microtaskQueue() { return m_microtaskQueue; }
     void setOnEachMicrotaskTick(WTF::Function<void(VM&)>&& func) { m_onEachMicrotaskTick = WTFMove(func); }
     void finalizeSynchronousJSExecution() { ASSERT(currentThreadIsHoldingAPILock()); m_currentWeakRefVersion++; }
     uintptr_t currentWeakRefVersion() const { return m_currentWeakRefVersion; }
@@ -915,6 +916,7 @@ public:
     void notifyNeedDebuggerBreak() { m_traps.fireTrap(VMTraps::NeedDebuggerBreak); }
     void notifyNeedTermination() { m_traps.fireTrap(VMTraps::NeedTermination); }
     void notifyNeedWatchdogCheck() { m_traps.fireTrap(VMTraps::NeedWatchdogCheck); }
+    void notifyNeedMemoryLimitCheck() { m_traps.setNeedHandling(VMTraps::NeedMemoryLimitCheck); }
 
 #if ENABLE(EXCEPTION_SCOPE_VERIFICATION)
     StackTrace* nativeStackTraceOfLastThrow() const { return m_nativeStackTraceOfLastThrow.get(); }
@@ -1044,16 +1046,20 @@ private:
     FunctionHasExecutedCache m_functionHasExecutedCache;
     std::unique_ptr<ControlFlowProfiler> m_controlFlowProfiler;
     unsigned m_controlFlowProfilerEnabledCount;
-    Deque<std::unique_ptr<QueuedTask>> m_microtaskQueue;
+    MicrotaskQueue m_microtaskQueue;
     MallocPtr<EncodedJSValue> m_exceptionFuzzBuffer;
     VMTraps m_traps;
     RefPtr<Watchdog> m_watchdog;
     std::unique_ptr<HeapProfiler> m_heapProfiler;
+    std::unique_ptr<AllocationSiteProfiler> m_allocationSiteProfiler;
 #if ENABLE(SAMPLING_PROFILER)
     RefPtr<SamplingProfiler> m_samplingProfiler;
 #endif
     std::unique_ptr<FuzzerAgent> m_fuzzerAgent;
     std::unique_ptr<ShadowChicken> m_shadowChicken;
+#if ENABLE(INTL)
+    std::unique_ptr<IntlFormatterCache> m_intlFormatterCache;
+#endif
     std::unique_ptr<BytecodeIntrinsicRegistry> m_bytecodeIntrinsicRegistry;
 
     WTF::Function<void(VM&)> m_onEachMicrotaskTick;
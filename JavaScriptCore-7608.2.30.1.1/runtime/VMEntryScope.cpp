@@ -26,6 +26,7 @@
 #include "config.h"
 #include "VMEntryScope.h"
 
+#include "ContextResourceLimits.h"
 #include "DisallowVMReentry.h"
 #include "JSGlobalObject.h"
 #include "Options.h"
@@ -61,6 +62,14 @@ VMEntryScope::VMEntryScope(VM& vm, JSGlobalObject* globalObject)
             tracePoint(VMEntryScopeStart);
     }
 
+    // Nested entries switch too, so that a call into another context is charged to that context.
+    ContextResourceLimits* resourceLimits = globalObject ? globalObject->resourceLimits() : nullptr;
+    if (UNLIKELY(resourceLimits != vm.heap.currentContextResourceLimits())) {
+        m_previousResourceLimits = vm.heap.currentContextResourceLimits();
+        m_didSwitchResourceLimits = true;
+        vm.heap.setCurrentContextResourceLimits(resourceLimits);
+    }
+
     vm.clearLastException();
 }
 
@@ -71,6 +80,9 @@ void VMEntryScope::addDidPopListener(Function<void ()>&& listener)
 
 VMEntryScope::~VMEntryScope()
 {
+    if (UNLIKELY(m_didSwitchResourceLimits))
+        m_vm.heap.setCurrentContextResourceLimits(m_previousResourceLimits);
+
     if (m_vm.entryScope != this)
         return;
 
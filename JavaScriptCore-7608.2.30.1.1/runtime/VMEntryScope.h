@@ -30,6 +30,7 @@
 
 namespace JSC {
 
+class ContextResourceLimits;
 class JSGlobalObject;
 class VM;
 
@@ -46,6 +47,8 @@ public:
 private:
     VM& m_vm;
     JSGlobalObject* m_globalObject;
+    ContextResourceLimits* m_previousResourceLimits { nullptr };
+    bool m_didSwitchResourceLimits { false };
     Vector<Function<void ()>> m_didPopListeners;
 };
 
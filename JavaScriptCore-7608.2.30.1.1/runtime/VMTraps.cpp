@@ -334,6 +334,20 @@ void VMTraps::fireTrap(VMTraps::EventType eventType)
 #endif
 }
 
+bool VMTraps::shouldEmitPollingTrapChecks() const
+{
+    return Options::usePollingTraps() || m_requiresPollingTrapChecks;
+}
+
+void VMTraps::setNeedHandling(VMTraps::EventType eventType)
+{
+    ASSERT(vm().currentThreadIsHoldingAPILock());
+    ASSERT(shouldEmitPollingTrapChecks());
+    auto locker = holdLock(*m_lock);
+    ASSERT(!m_isShuttingDown);
+    setTrapForEvent(locker, eventType);
+}
+
 void VMTraps::handleTraps(ExecState* exec, VMTraps::Mask mask)
 {
     VM& vm = this->vm();
@@ -367,6 +381,12 @@ void VMTraps::handleTraps(ExecState* exec, VMTraps::Mask mask)
             throwException(exec, scope, createTerminatedExecutionException(&vm));
             return;
 
+        case NeedMemoryLimitCheck:
+            if (LIKELY(!vm.heap.checkContextMemoryLimits()))
+                continue;
+            throwException(exec, scope, createTerminatedExecutionException(&vm));
+            return;
+
         default:
             RELEASE_ASSERT_NOT_REACHED();
         }
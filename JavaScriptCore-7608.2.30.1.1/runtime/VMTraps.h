@@ -53,6 +53,7 @@ public:
         NeedDebuggerBreak,
         NeedTermination,
         NeedWatchdogCheck,
+        NeedMemoryLimitCheck,
         NumberOfEventTypes, // This entry must be last in this list.
         Invalid
     };
@@ -105,6 +106,14 @@ public:
 
     JS_EXPORT_PRIVATE void fireTrap(EventType);
 
+    // Used by the mutator to request a trap for itself while it holds the API lock. This only sets the
+    // trap bit: it neither signals the mutator nor invalidates code, so the request is serviced at the
+    // next polling trap check. Clients must call requirePollingTrapChecks() before relying on it.
+    void setNeedHandling(EventType);
+
+    bool shouldEmitPollingTrapChecks() const;
+    void requirePollingTrapChecks() { m_requiresPollingTrapChecks = true; }
+
     void handleTraps(ExecState*, VMTraps::Mask);
 
     void tryInstallTrapBreakpoints(struct SignalContext&, StackBounds);
@@ -153,6 +162,7 @@ private:
     };
     bool m_needToInvalidatedCodeBlocks { false };
     bool m_isShuttingDown { false };
+    bool m_requiresPollingTrapChecks { false };
 
 #if ENABLE(SIGNAL_BASED_VM_TRAPS)
     RefPtr<SignalSender> m_signalSender;
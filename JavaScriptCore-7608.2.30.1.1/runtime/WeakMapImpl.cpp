@@ -29,6 +29,8 @@
 
 #include "IsoCellSetInlines.h"
 #include "JSCInlines.h"
+#include "MarkedBlockInlines.h"
+#include "SubspaceInlines.h"
 #include "WeakMapImplInlines.h"
 
 namespace JSC {
@@ -55,6 +57,25 @@ size_t WeakMapImpl<WeakMapBucket>::estimatedSize(JSCell* cell, VM& vm)
     return Base::estimatedSize(thisObject, vm) + (sizeof(WeakMapImpl) - sizeof(Base)) + thisObject->m_capacity * sizeof(WeakMapBucket);
 }
 
+template <>
+void WeakMapImpl<WeakMapBucket<WeakMapBucketDataKey>>::visitOutputConstraintsInRange(SlotVisitor&, BucketType*, uint32_t, uint32_t)
+{
+}
+
+template <>
+void WeakMapImpl<WeakMapBucket<WeakMapBucketDataKeyValue>>::visitOutputConstraintsInRange(SlotVisitor& visitor, BucketType* buffer, uint32_t begin, uint32_t end)
+{
+    VM& vm = visitor.vm();
+    for (uint32_t index = begin; index < end; ++index) {
+        auto* bucket = buffer + index;
+        if (bucket->isEmpty() || bucket->isDeleted())
+            continue;
+        if (!vm.heap.isMarked(bucket->key()))
+            continue;
+        bucket->visitAggregate(visitor);
+    }
+}
+
 template <>
 void WeakMapImpl<WeakMapBucket<WeakMapBucketDataKey>>::visitOutputConstraints(JSCell*, SlotVisitor&)
 {
@@ -64,18 +85,129 @@ void WeakMapImpl<WeakMapBucket<WeakMapBucketDataKey>>::visitOutputConstraints(JS
 template <>
 void WeakMapImpl<WeakMapBucket<WeakMapBucketDataKeyValue>>::visitOutputConstraints(JSCell* cell, SlotVisitor& visitor)
 {
-    VM& vm = visitor.vm();
     auto* thisObject = jsCast<WeakMapImpl*>(cell);
     auto locker = holdLock(thisObject->cellLock());
-    auto* buffer = thisObject->buffer();
-    for (uint32_t index = 0; index < thisObject->m_capacity; ++index) {
+    thisObject->visitOutputConstraintsInRange(visitor, thisObject->buffer(), 0, thisObject->m_capacity);
+}
+
+template <typename WeakMapBucket>
+void WeakMapImpl<WeakMapBucket>::removeDeadEntriesInRange(VM& vm, WeakMapBucket* buffer, uint32_t begin, uint32_t end)
+{
+    uint32_t removedCount = 0;
+    for (uint32_t index = begin; index < end; ++index) {
         auto* bucket = buffer + index;
         if (bucket->isEmpty() || bucket->isDeleted())
             continue;
-        if (!vm.heap.isMarked(bucket->key()))
+
+        if (vm.heap.isMarked(bucket->key()))
             continue;
-        bucket->visitAggregate(visitor);
+
+        bucket->makeDeleted();
+        ++removedCount;
     }
+
+    if (!removedCount)
+        return;
+
+    // Other ranges of this table may be finishing at the same time.
+    auto locker = holdLock(cellLock());
+    m_deleteCount += removedCount;
+    RELEASE_ASSERT(m_keyCount >= removedCount);
+    m_keyCount -= removedCount;
+}
+
+// Hands the marked tables of a subspace out to every SlotVisitor that runs the task. Tables larger than
+// bucketsPerParallelRange are cut into ranges that any of the visitors can pick up, so that one huge
+// table doesn't keep a single visitor busy while the others sit idle.
+template<typename WeakMapImplType, typename RangeFunctor>
+class WeakMapParallelTask final : public SharedTask<void(SlotVisitor&)> {
+public:
+    using BucketType = typename WeakMapImplType::BucketType;
+
+    WeakMapParallelTask(IsoSubspace& subspace, const RangeFunctor& functor)
+        : m_functor(functor)
+        , m_cellTask(subspace.forEachMarkedCellInParallel(
+            [this] (SlotVisitor& visitor, HeapCell* cell, HeapCell::Kind) {
+                addTable(visitor, *static_cast<WeakMapImplType*>(static_cast<JSCell*>(cell)));
+            }))
+    {
+    }
+
+    void run(SlotVisitor& visitor) override
+    {
+        m_cellTask->run(visitor);
+        visitRanges(visitor);
+    }
+
+private:
+    struct Range {
+        WeakMapImplType* table;
+        BucketType* buffer;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    void addTable(SlotVisitor& visitor, WeakMapImplType& table)
+    {
+        BucketType* buffer;
+        uint32_t capacity;
+        std::tie(buffer, capacity) = table.bufferAndCapacity();
+        if (capacity <= WeakMapImplType::bucketsPerParallelRange) {
+            m_functor(visitor, table, buffer, 0, capacity);
+            return;
+        }
+
+        {
+            auto locker = holdLock(m_lock);
+            for (uint32_t begin = 0; begin < capacity; begin += WeakMapImplType::bucketsPerParallelRange)
+                m_ranges.append(Range { &table, buffer, begin, std::min(begin + WeakMapImplType::bucketsPerParallelRange, capacity) });
+        }
+        visitRanges(visitor);
+    }
+
+    void visitRanges(SlotVisitor& visitor)
+    {
+        for (;;) {
+            Range range;
+            {
+                auto locker = holdLock(m_lock);
+                if (m_ranges.isEmpty())
+                    return;
+                range = m_ranges.takeLast();
+            }
+            m_functor(visitor, *range.table, range.buffer, range.begin, range.end);
+        }
+    }
+
+    RangeFunctor m_functor;
+    Ref<SharedTask<void(SlotVisitor&)>> m_cellTask;
+    Lock m_lock;
+    Vector<Range> m_ranges;
+};
+
+template<typename WeakMapImplType, typename RangeFunctor>
+static Ref<SharedTask<void(SlotVisitor&)>> createWeakMapParallelTask(IsoSubspace& subspace, const RangeFunctor& functor)
+{
+    return adoptRef(*new WeakMapParallelTask<WeakMapImplType, RangeFunctor>(subspace, functor));
+}
+
+template <typename WeakMapBucket>
+Ref<SharedTask<void(SlotVisitor&)>> WeakMapImpl<WeakMapBucket>::createOutputConstraintTask(IsoSubspace& subspace)
+{
+    return createWeakMapParallelTask<WeakMapImpl>(subspace,
+        [] (SlotVisitor& visitor, WeakMapImpl& table, WeakMapBucket* buffer, uint32_t begin, uint32_t end) {
+            SetRootMarkReasonScope rootScope(visitor, SlotVisitor::RootMarkReason::Output);
+            table.visitOutputConstraintsInRange(visitor, buffer, begin, end);
+        });
+}
+
+template <typename WeakMapBucket>
+Ref<SharedTask<void(SlotVisitor&)>> WeakMapImpl<WeakMapBucket>::createRemoveDeadEntriesTask(IsoSubspace& subspace)
+{
+    return createWeakMapParallelTask<WeakMapImpl>(subspace,
+        [] (SlotVisitor& visitor, WeakMapImpl& table, WeakMapBucket* buffer, uint32_t begin, uint32_t end) {
+            table.removeDeadEntriesInRange(visitor.vm(), buffer, begin, end);
+        });
 }
 
 template <typename WeakMapBucket>
@@ -31,9 +31,14 @@
 #include "JSObject.h"
 #include <wtf/JSValueMalloc.h>
 #include <wtf/MallocPtr.h>
+#include <wtf/SharedTask.h>
 
 namespace JSC {
 
+class IsoSubspace;
+
+template<typename WeakMapImplType, typename RangeFunctor> class WeakMapParallelTask;
+
 struct WeakMapBucketDataKey {
     static const HashTableType Type = HashTableType::Key;
     WriteBarrier<JSObject> key;
@@ -212,6 +217,10 @@ public:
 
     static constexpr uint32_t initialCapacity = 4;
 
+    // Tables with more buckets than this are split into ranges of this size during GC, so that all of
+    // the SlotVisitors can work on one large table at once.
+    static constexpr uint32_t bucketsPerParallelRange = 1024;
+
     void finishCreation(VM& vm)
     {
         ASSERT_WITH_MESSAGE(WeakMapBucket<WeakMapBucketDataKey>::offsetOfKey() == WeakMapBucket<WeakMapBucketDataKeyValue>::offsetOfKey(), "We assume this to be true in the DFG and FTL JIT.");
@@ -251,6 +260,10 @@ public:
         DisallowGC disallowGC;
         ASSERT_WITH_MESSAGE(jsWeakMapHash(key) == hash, "We expect hash value is what we expect.");
 
+        // The GC leaves shrinking large tables that lost most of their keys to us.
+        if (UNLIKELY(shouldShrink()))
+            rehash(RehashMode::RemoveBatching);
+
         addInternal(vm, key, value, hash);
         if (shouldRehashAfterAdd())
             rehash();
@@ -313,7 +326,26 @@ public:
     static void visitOutputConstraints(JSCell*, SlotVisitor&);
     void finalizeUnconditionally(VM&);
 
+    // Visits the values of live keys in every marked map of the subspace. Meant to be run by all
+    // marking threads at once as a parallel constraint task.
+    static Ref<SharedTask<void(SlotVisitor&)>> createOutputConstraintTask(IsoSubspace&);
+
+    // Deletes the entries of dead keys in every marked map of the subspace. This must run once marking
+    // is done but before the mutator resumes, since a dead key's cell may be reused once it is swept.
+    static Ref<SharedTask<void(SlotVisitor&)>> createRemoveDeadEntriesTask(IsoSubspace&);
+
 private:
+    template<typename, typename> friend class WeakMapParallelTask;
+
+    std::pair<WeakMapBucketType*, uint32_t> bufferAndCapacity()
+    {
+        auto locker = holdLock(cellLock());
+        return { buffer(), m_capacity };
+    }
+
+    void visitOutputConstraintsInRange(SlotVisitor&, WeakMapBucketType* buffer, uint32_t begin, uint32_t end);
+    void removeDeadEntriesInRange(VM&, WeakMapBucketType* buffer, uint32_t begin, uint32_t end);
+
     ALWAYS_INLINE WeakMapBucketType* findBucket(JSObject* key)
     {
         return findBucket(key, jsWeakMapHash(key));
@@ -411,6 +443,7 @@ private:
 
         uint32_t oldCapacity = m_capacity;
         MallocPtr<WeakMapBufferType, JSValueMalloc> oldBuffer = WTFMove(m_buffer);
+        m_shrinkWasDeferred = false;
 
         uint32_t capacity = m_capacity;
         if (mode == RehashMode::RemoveBatching) {
@@ -438,6 +471,13 @@ private:
 
         m_deleteCount = 0;
 
+        // Marking threads scan ranges of the buffer without holding the cell lock, so a buffer that
+        // is replaced while the collector is marking lives until marking ends.
+        Heap& heap = vm()->heap;
+        ASSERT(heap.mutatorShouldBeFenced() || !heap.isMarking());
+        if (heap.mutatorShouldBeFenced())
+            heap.retireWeakMapBuffer(oldBuffer.leakPtr());
+
         checkConsistency();
     }
 
@@ -481,6 +521,7 @@ private:
     uint32_t m_capacity { 0 };
     uint32_t m_keyCount { 0 };
     uint32_t m_deleteCount { 0 };
+    bool m_shrinkWasDeferred { false };
 };
 
 } // namespace JSC
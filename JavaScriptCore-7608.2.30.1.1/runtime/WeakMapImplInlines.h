@@ -29,27 +29,21 @@
 
 namespace JSC {
 
-// Note that this function can be executed in parallel as long as the mutator stops.
+// Dead entries were already deleted by the task from createRemoveDeadEntriesTask() when marking
+// finished, so all that's left is to give back memory.
 template<typename WeakMapBucket>
-void WeakMapImpl<WeakMapBucket>::finalizeUnconditionally(VM& vm)
+void WeakMapImpl<WeakMapBucket>::finalizeUnconditionally(VM&)
 {
-    auto* buffer = this->buffer();
-    for (uint32_t index = 0; index < m_capacity; ++index) {
-        auto* bucket = buffer + index;
-        if (bucket->isEmpty() || bucket->isDeleted())
-            continue;
-
-        if (vm.heap.isMarked(bucket->key()))
-            continue;
-
-        bucket->makeDeleted();
-        ++m_deleteCount;
-        RELEASE_ASSERT(m_keyCount > 0);
-        --m_keyCount;
+    if (!shouldShrink())
+        return;
+
+    // Rebuilding a large table is the expensive part of dropping its dead entries, so we leave it to
+    // the mutator's next add(). A table that isn't added to by the next GC gets rebuilt then.
+    if (m_capacity > bucketsPerParallelRange && !m_shrinkWasDeferred) {
+        m_shrinkWasDeferred = true;
+        return;
     }
-
-    if (shouldShrink())
-        rehash(RehashMode::RemoveBatching);
+    rehash(RehashMode::RemoveBatching);
 }
 
 }
@@ -27,9 +27,11 @@
 #include "CompilerTimingScope.h"
 
 #include "Options.h"
+#include "ProfilerCompilation.h"
 #include <wtf/DataLog.h>
 #include <wtf/HashMap.h>
 #include <wtf/Lock.h>
+#include <wtf/ThreadSpecific.h>
 
 namespace JSC {
 
@@ -58,20 +60,36 @@ CompilerTimingScopeState& compilerTimingScopeState()
     return ensurePointer(s_state, [] { return new CompilerTimingScopeState(); });
 }
 
+ThreadSpecific<Profiler::Compilation*>& currentRecordedCompilation()
+{
+    static ThreadSpecific<Profiler::Compilation*>* s_compilation;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        s_compilation = new ThreadSpecific<Profiler::Compilation*>();
+    });
+    return *s_compilation;
+}
+
 } // anonymous namespace
 
 CompilerTimingScope::CompilerTimingScope(const char* compilerName, const char* name)
     : m_compilerName(compilerName)
     , m_name(name)
+    , m_compilation(*currentRecordedCompilation())
 {
-    if (Options::logPhaseTimes())
+    if (Options::logPhaseTimes() || m_compilation)
         m_before = MonotonicTime::now();
 }
 
 CompilerTimingScope::~CompilerTimingScope()
 {
+    if (!Options::logPhaseTimes() && !m_compilation)
+        return;
+
+    Seconds duration = MonotonicTime::now() - m_before;
+    if (m_compilation)
+        m_compilation->addPhaseTime(m_compilerName, m_name, duration);
     if (Options::logPhaseTimes()) {
-        Seconds duration = MonotonicTime::now() - m_before;
         dataLog(
             "[", m_compilerName, "] ", m_name, " took: ", duration.milliseconds(), " ms ",
             "(total: ", compilerTimingScopeState().addToTotal(m_compilerName, m_name, duration).milliseconds(),
@@ -79,6 +97,17 @@ CompilerTimingScope::~CompilerTimingScope()
     }
 }
 
+CompilerTimingRecordScope::CompilerTimingRecordScope(Profiler::Compilation* compilation)
+    : m_previousCompilation(*currentRecordedCompilation())
+{
+    *currentRecordedCompilation() = compilation;
+}
+
+CompilerTimingRecordScope::~CompilerTimingRecordScope()
+{
+    *currentRecordedCompilation() = m_previousCompilation;
+}
+
 } // namespace JSC
 
 
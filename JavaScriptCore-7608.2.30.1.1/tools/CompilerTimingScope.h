@@ -30,10 +30,17 @@
 
 namespace JSC {
 
+namespace Profiler {
+class Compilation;
+}
+
 // FIXME: We should find some way of reconciling the differences between WTF::TimingScope and this class. The differences
 // are:
 // - CompilerTimingScope knows to only do work when --logPhaseTimes=true, while TimingScope is unconditional.
 // - CompilerTimingScope reports totals on every run, while TimingScope reports averages periodically.
+//
+// Scopes also add their time to the Profiler::Compilation of the enclosing CompilerTimingRecordScope,
+// if there is one on the current thread.
 
 class CompilerTimingScope {
     WTF_MAKE_NONCOPYABLE(CompilerTimingScope);
@@ -44,8 +51,20 @@ public:
 private:
     const char* m_compilerName;
     const char* m_name;
+    Profiler::Compilation* m_compilation;
     MonotonicTime m_before;
 };
 
+class CompilerTimingRecordScope {
+    WTF_MAKE_NONCOPYABLE(CompilerTimingRecordScope);
+public:
+    // Passing null is allowed, and records nothing.
+    CompilerTimingRecordScope(Profiler::Compilation*);
+    ~CompilerTimingRecordScope();
+
+private:
+    Profiler::Compilation* m_previousCompilation;
+};
+
 } // namespace JSC
 
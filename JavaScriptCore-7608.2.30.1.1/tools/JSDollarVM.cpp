@@ -2193,6 +2193,61 @@ static EncodedJSValue JSC_HOST_CALL functionTotalGCTime(ExecState* exec)
     return JSValue::encode(jsNumber(vm.heap.totalGCTime().seconds()));
 }
 
+// Returns an object with the VM's microtask queue counters.
+// Usage: $vm.microtaskQueueStatistics()
+static EncodedJSValue JSC_HOST_CALL functionMicrotaskQueueStatistics(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    const MicrotaskQueue::Statistics& statistics = vm.microtaskQueue().statistics();
+    JSObject* result = constructEmptyObject(exec);
+    result->putDirect(vm, Identifier::fromString(&vm, "enqueuedJSJobs"), jsNumber(statistics.enqueuedJSJobs));
+    result->putDirect(vm, Identifier::fromString(&vm, "enqueuedNativeTasks"), jsNumber(statistics.enqueuedNativeTasks));
+    result->putDirect(vm, Identifier::fromString(&vm, "ranTasks"), jsNumber(statistics.ranTasks));
+    result->putDirect(vm, Identifier::fromString(&vm, "drains"), jsNumber(statistics.drains));
+    result->putDirect(vm, Identifier::fromString(&vm, "peakLength"), jsNumber(statistics.peakLength));
+    result->putDirect(vm, Identifier::fromString(&vm, "length"), jsNumber(vm.microtaskQueue().size()));
+    return JSValue::encode(result);
+}
+
+// Returns one entry per call site of the function, in any tier, that is linked through a dispatch table.
+// Usage: var entries = $vm.callDispatchTableStatistics(functionObj)
+static EncodedJSValue JSC_HOST_CALL functionCallDispatchTableStatistics(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    JSArray* result = constructEmptyArray(exec, 0);
+    RETURN_IF_EXCEPTION(scope, { });
+#if ENABLE(JIT)
+    FunctionExecutable* executable = getExecutableForFunction(exec->argument(0));
+    if (!executable)
+        return JSValue::encode(result);
+    for (CodeBlock* codeBlock = executable->codeBlockForCall(); codeBlock; codeBlock = codeBlock->alternative()) {
+        for (const PolymorphicCallDispatchTableStatistics& statistics : codeBlock->callDispatchTableStatistics()) {
+            JSObject* entry = constructEmptyObject(exec);
+            entry->putDirect(vm, Identifier::fromString(&vm, "jitType"), jsString(exec, String(JITCode::typeName(codeBlock->jitType()))));
+            entry->putDirect(vm, Identifier::fromString(&vm, "bytecodeIndex"), jsNumber(statistics.codeOrigin.bytecodeIndex()));
+            entry->putDirect(vm, Identifier::fromString(&vm, "size"), jsNumber(statistics.size));
+            entry->putDirect(vm, Identifier::fromString(&vm, "hits"), jsNumber(statistics.hits));
+            entry->putDirect(vm, Identifier::fromString(&vm, "misses"), jsNumber(statistics.misses));
+            JSArray* targets = constructEmptyArray(exec, 0);
+            RETURN_IF_EXCEPTION(scope, { });
+            for (ExecutableBase* target : statistics.targets) {
+                if (auto* functionExecutable = jsDynamicCast<FunctionExecutable*>(vm, target))
+                    targets->push(exec, jsString(exec, functionExecutable->ecmaName().string()));
+                else
+                    targets->push(exec, jsNull());
+                RETURN_IF_EXCEPTION(scope, { });
+            }
+            entry->putDirect(vm, Identifier::fromString(&vm, "targets"), targets);
+            result->push(exec, entry);
+            RETURN_IF_EXCEPTION(scope, { });
+        }
+    }
+#endif
+    return JSValue::encode(result);
+}
+
 void JSDollarVM::finishCreation(VM& vm)
 {
     Base::finishCreation(vm);
@@ -2307,6 +2362,9 @@ void JSDollarVM::finishCreation(VM& vm)
     addFunction(vm, "deltaBetweenButterflies", functionDeltaBetweenButterflies, 2);
     
     addFunction(vm, "totalGCTime", functionTotalGCTime, 0);
+
+    addFunction(vm, "microtaskQueueStatistics", functionMicrotaskQueueStatistics, 0);
+    addFunction(vm, "callDispatchTableStatistics", functionCallDispatchTableStatistics, 1);
 }
 
 void JSDollarVM::addFunction(VM& vm, JSGlobalObject* globalObject, const char* name, NativeFunction function, unsigned arguments)
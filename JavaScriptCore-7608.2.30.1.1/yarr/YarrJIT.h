@@ -56,6 +56,11 @@ enum class JITFailureReason : uint8_t {
     ExecutableMemoryAllocationFailure,
 };
 
+enum YarrJITCompileMode {
+    MatchOnly,
+    IncludeSubpatterns
+};
+
 class YarrCodeBlock {
     // Technically freeParenContext and parenContextSize are only used if ENABLE(YARR_JIT_ALL_PARENS_EXPRESSIONS) is set. Fortunately, all the calling conventions we support have caller save argument registers.
     using YarrJITCode8 = EncodedMatchResult (*)(const LChar* input, unsigned start, unsigned length, int* output, void* freeParenContext, unsigned parenContextSize) YARR_CALL;
@@ -147,6 +152,31 @@ public:
         return m_ref8.size() + m_ref16.size() + m_matchOnly8.size() + m_matchOnly16.size();
     }
 
+    bool hasCodeFor(YarrCharSize charSize, YarrJITCompileMode mode) const
+    {
+        if (mode == MatchOnly)
+            return charSize == Char8 ? m_matchOnly8.size() : m_matchOnly16.size();
+        return charSize == Char8 ? m_ref8.size() : m_ref16.size();
+    }
+
+    // Shares, rather than copies, the code that other has for charSize and mode.
+    void copyCodeFrom(const YarrCodeBlock& other, YarrCharSize charSize, YarrJITCompileMode mode)
+    {
+        ASSERT(other.hasCodeFor(charSize, mode));
+        if (mode == MatchOnly) {
+            if (charSize == Char8)
+                m_matchOnly8 = other.m_matchOnly8;
+            else
+                m_matchOnly16 = other.m_matchOnly16;
+        } else {
+            if (charSize == Char8)
+                m_ref8 = other.m_ref8;
+            else
+                m_ref16 = other.m_ref16;
+        }
+        m_usesPatternContextBuffer |= other.m_usesPatternContextBuffer;
+    }
+
     void clear()
     {
         m_ref8 = MacroAssemblerCodeRef<Yarr8BitPtrTag>();
@@ -165,10 +195,6 @@ private:
     Optional<JITFailureReason> m_failureReason;
 };
 
-enum YarrJITCompileMode {
-    MatchOnly,
-    IncludeSubpatterns
-};
 void jitCompile(YarrPattern&, String& patternString, YarrCharSize, VM*, YarrCodeBlock& jitObject, YarrJITCompileMode = IncludeSubpatterns);
 
 } } // namespace JSC::Yarr